@@ -384,6 +384,47 @@ extern DECLSPEC SDL_AudioStatus SDLCALL
 SDL_GetAudioDeviceStatus(SDL_AudioDeviceID dev);
 /* @} *//* Audio State */
 
+/**
+ *  \brief Playback statistics for an audio device, see SDL_GetAudioDeviceStats().
+ *
+ *  Durations are in nanoseconds. Compare the callback durations to
+ *  \c buffer_period, the time one callback's worth of audio takes to
+ *  play: a callback that takes longer than that can't keep up.
+ */
+typedef struct SDL_AudioDeviceStats
+{
+    Uint32 callbacks;               /**< Times the audio callback has been called */
+    Uint64 min_callback_duration;   /**< Shortest time the callback has taken */
+    Uint64 avg_callback_duration;   /**< Average time the callback has taken */
+    Uint64 max_callback_duration;   /**< Longest time the callback has taken */
+    Uint64 buffer_period;           /**< Time one callback buffer of audio takes to play */
+    Uint32 underruns;               /**< Times the device ran out of audio before SDL gave it more */
+    Uint32 silence_frames;          /**< Sample frames of silence SDL played because queued or converted audio ran out */
+    Uint32 queued_bytes;            /**< Bytes of queued audio, same as SDL_GetQueuedAudioSize() */
+} SDL_AudioDeviceStats;
+
+/**
+ *  \brief Get the statistics of a playback device since it was opened or
+ *         the statistics were last reset.
+ *
+ *  The counters are always maintained, and are cheap enough to poll
+ *  regularly. Callbacks aren't counted while the device is paused.
+ *
+ *  Not every audio driver can tell when the device underruns; the ones
+ *  that can't always report zero underruns.
+ *
+ *  \return 0 on success, or -1 if (dev) isn't an open playback device.
+ *
+ *  \sa SDL_ResetAudioDeviceStats()
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID dev,
+                                                    SDL_AudioDeviceStats *stats);
+
+/**
+ *  \brief Reset the statistics of a playback device.
+ */
+extern DECLSPEC void SDLCALL SDL_ResetAudioDeviceStats(SDL_AudioDeviceID dev);
+
 /**
  *  \name Pause audio functions
  *
@@ -486,6 +527,217 @@ extern DECLSPEC void SDLCALL SDL_MixAudioFormat(Uint8 * dst,
                                                 SDL_AudioFormat format,
                                                 Uint32 len, int volume);
 
+/**
+ *  \name Audio mixer
+ *
+ *  An SDL_AudioMixer mixes any number of voices into a single output
+ *  stream. Each voice has its own format, channel count and rate, which are
+ *  converted to the mixer's, and its own gain and pan. This is faster than
+ *  calling SDL_MixAudioFormat() once per voice, since the voices are summed
+ *  in floating point and the result is clamped and converted to the output
+ *  format only once.
+ *
+ *  A mixer is safe to use from more than one thread; you can feed voices
+ *  from your main thread and call SDL_AudioMixerGet() from your audio
+ *  callback.
+ */
+/* @{ */
+struct _SDL_AudioMixer;
+typedef struct _SDL_AudioMixer SDL_AudioMixer;
+
+/**
+ *  Create a new audio mixer.
+ *
+ *  \param format The format of the mixed output
+ *  \param channels The number of channels of the mixed output (1 to 8)
+ *  \param rate The sampling rate of the mixed output
+ *  \return The new mixer, or NULL on error.
+ *
+ *  \sa SDL_AudioMixerAddVoice
+ *  \sa SDL_AudioMixerGet
+ *  \sa SDL_FreeAudioMixer
+ */
+extern DECLSPEC SDL_AudioMixer * SDLCALL SDL_NewAudioMixer(SDL_AudioFormat format,
+                                                           Uint8 channels,
+                                                           int rate);
+
+/**
+ *  Add a voice to a mixer.
+ *
+ *  The voice starts out empty, with a gain of 1.0 and centered.
+ *
+ *  \param mixer The mixer to add the voice to
+ *  \param src_format The format of the audio you will give to this voice
+ *  \param src_channels The number of channels of the audio
+ *  \param src_rate The sampling rate of the audio
+ *  \return A positive voice ID, or -1 on error.
+ *
+ *  \sa SDL_AudioMixerPutVoice
+ *  \sa SDL_AudioMixerRemoveVoice
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerAddVoice(SDL_AudioMixer *mixer,
+                                                   SDL_AudioFormat src_format,
+                                                   Uint8 src_channels,
+                                                   int src_rate);
+
+/**
+ *  Remove a voice from a mixer, dropping any audio it has not played yet.
+ *  Its ID may be handed out again by SDL_AudioMixerAddVoice().
+ *
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerRemoveVoice(SDL_AudioMixer *mixer, int voice);
+
+/**
+ *  Set the gain and pan of a voice.
+ *
+ *  \param mixer The mixer the voice belongs to
+ *  \param voice The voice ID
+ *  \param gain The gain, 1.0 for full volume; may be more than 1.0
+ *  \param pan The balance between the front left (-1.0) and right (1.0)
+ *              channels, 0.0 for centered. This has no effect on mono output.
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerSetVoiceGain(SDL_AudioMixer *mixer, int voice,
+                                                       float gain, float pan);
+
+/**
+ *  Add audio data to a voice.
+ *
+ *  \param mixer The mixer the voice belongs to
+ *  \param voice The voice ID
+ *  \param buf The audio data, in the voice's format
+ *  \param len The number of bytes (not samples!) in buf; must be a whole
+ *              number of sample frames.
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerPutVoice(SDL_AudioMixer *mixer, int voice,
+                                                   const void *buf, Uint32 len);
+
+/**
+ *  Drop all audio a voice has not played yet.
+ *
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerClearVoice(SDL_AudioMixer *mixer, int voice);
+
+/**
+ *  Get how much audio a voice has left to play.
+ *
+ *  \return The number of bytes of mixed output the voice can still fill,
+ *          or -1 on error. Audio that is still being resampled may not be
+ *          counted yet.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerVoiceAvailable(SDL_AudioMixer *mixer, int voice);
+
+/**
+ *  Mix all voices into a buffer in the mixer's format.
+ *
+ *  This always fills the whole buffer; voices that run out of audio are
+ *  silent for the rest of it.
+ *
+ *  \param mixer The mixer
+ *  \param buf The buffer to fill
+ *  \param len The number of bytes (not samples!) to fill; must be a whole
+ *              number of sample frames.
+ *  \return The number of bytes written, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerGet(SDL_AudioMixer *mixer, void *buf, Uint32 len);
+
+/**
+ *  Free a mixer and all of its voices.
+ */
+extern DECLSPEC void SDLCALL SDL_FreeAudioMixer(SDL_AudioMixer *mixer);
+/* @} *//* Audio mixer */
+
+/**
+ *  \name Streaming WAVE files
+ *
+ *  An SDL_WAVStream reads a WAVE file a piece at a time instead of loading
+ *  all of it like SDL_LoadWAV_RW() does. The headers are parsed once when
+ *  the stream is opened, and ADPCM is decoded a block at a time as it's
+ *  read, so only a block or so of the file is ever in memory.
+ *
+ *  The data source must be able to seek.
+ */
+/* @{ */
+struct _SDL_WAVStream;
+typedef struct _SDL_WAVStream SDL_WAVStream;
+
+/**
+ *  Open a WAVE file for streaming, automatically freeing the data source
+ *  when the stream is closed (or if this fails) if \c freesrc is non-zero.
+ *
+ *  \param src The data source to read the WAVE file from
+ *  \param freesrc Non-zero to close \c src along with the stream
+ *  \param spec Filled with the format of the decoded audio
+ *  \return The new stream, or NULL on error.
+ *
+ *  \sa SDL_WAVStreamRead
+ *  \sa SDL_CloseWAVStream
+ */
+extern DECLSPEC SDL_WAVStream * SDLCALL SDL_OpenWAVStream_RW(SDL_RWops * src,
+                                                            int freesrc,
+                                                            SDL_AudioSpec * spec);
+
+/**
+ *  Opens a WAVE file for streaming.
+ */
+#define SDL_OpenWAVStream(file, spec) \
+    SDL_OpenWAVStream_RW(SDL_RWFromFile(file, "rb"), 1, spec)
+
+/**
+ *  Get the length of a WAVE file, in sample frames.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_WAVStreamLength(SDL_WAVStream *wav);
+
+/**
+ *  Get the sample frame the next read will start at.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_WAVStreamTell(SDL_WAVStream *wav);
+
+/**
+ *  Move to a sample frame, from 0 up to SDL_WAVStreamLength().
+ *
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_WAVStreamSeek(SDL_WAVStream *wav, Uint32 frame);
+
+/**
+ *  Decode audio from the current position.
+ *
+ *  \param wav The stream
+ *  \param buf The buffer to fill, in the format SDL_OpenWAVStream_RW() gave
+ *  \param len The size of buf in bytes; only whole sample frames are read.
+ *  \return The number of bytes read, 0 at the end of the file, or -1 on
+ *          error.
+ */
+extern DECLSPEC int SDLCALL SDL_WAVStreamRead(SDL_WAVStream *wav, void *buf, int len);
+
+/**
+ *  Decode audio from the current position straight into a mixer voice.
+ *
+ *  This saves a copy over calling SDL_WAVStreamRead() and then
+ *  SDL_AudioMixerPutVoice(). The voice must have been added with the
+ *  format, channels and rate that SDL_OpenWAVStream_RW() gave.
+ *
+ *  \param wav The stream
+ *  \param mixer The mixer the voice belongs to
+ *  \param voice The voice ID
+ *  \param len The most bytes to decode; only whole sample frames are read.
+ *  \return The number of bytes added to the voice, 0 at the end of the
+ *          file, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_WAVStreamPutMixerVoice(SDL_WAVStream *wav,
+                                                       SDL_AudioMixer *mixer,
+                                                       int voice, int len);
+
+/**
+ *  Close a stream, and its data source if it was opened with \c freesrc.
+ */
+extern DECLSPEC void SDLCALL SDL_CloseWAVStream(SDL_WAVStream *wav);
+/* @} *//* Streaming WAVE files */
+
 /**
  *  Queue more audio on non-callback devices.
  *
@@ -645,6 +897,165 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetQueuedAudioSize(SDL_AudioDeviceID dev);
  */
 extern DECLSPEC void SDLCALL SDL_ClearQueuedAudio(SDL_AudioDeviceID dev);
 
+/**
+ *  Get a pointer into the audio queue of a playback device, to write
+ *  audio data into without an extra copy.
+ *
+ *  This works like SDL_QueueAudio(), but instead of copying your data into
+ *  the queue, SDL hands out a piece of the queue's own storage for you to
+ *  fill in. Once you've written the data, call SDL_CommitQueuedAudio() with
+ *  the number of bytes you actually wrote, and they are queued for playback
+ *  exactly as if you had passed them to SDL_QueueAudio().
+ *
+ *  (len) is the number of bytes you want to write on input, and the number
+ *  of bytes you may write on output. SDL may hand out less space than you
+ *  asked for (the queue stores audio in fixed size blocks), so write what
+ *  fits, commit it, and ask again for the rest.
+ *
+ *  Only one write may be in progress on a device at a time. Do not call
+ *  SDL_QueueAudio() or SDL_ClearQueuedAudio() on the device between this
+ *  call and SDL_CommitQueuedAudio(); the space handed out is not valid
+ *  anymore after either of them.
+ *
+ *  You may not queue audio on a device that is using an application-supplied
+ *  callback, or on a capture device; doing so returns NULL.
+ *
+ *  \param dev The device ID to which we will queue audio.
+ *  \param len In: the number of bytes you want to write; out: the number
+ *             of bytes you may write.
+ *  \return A pointer to write audio data to, or NULL on error. Call
+ *          SDL_GetError() for more information.
+ *
+ *  \sa SDL_CommitQueuedAudio
+ *  \sa SDL_QueueAudio
+ */
+extern DECLSPEC void *SDLCALL SDL_ReserveQueuedAudio(SDL_AudioDeviceID dev, Uint32 *len);
+
+/**
+ *  Queue audio data written to the space from SDL_ReserveQueuedAudio().
+ *
+ *  \param dev The device ID to which we will queue audio.
+ *  \param len The number of bytes (not samples!) you wrote, which may not
+ *             be more than SDL_ReserveQueuedAudio() handed out. Zero cancels
+ *             the write.
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_ReserveQueuedAudio
+ */
+extern DECLSPEC int SDLCALL SDL_CommitQueuedAudio(SDL_AudioDeviceID dev, Uint32 len);
+
+/**
+ *  Get a pointer to the oldest audio data queued by a capture device, to
+ *  read it without an extra copy.
+ *
+ *  This works like SDL_DequeueAudio(), but instead of copying the data out
+ *  of the queue, SDL hands out a pointer into the queue's own storage. The
+ *  data stays queued until you call SDL_ReleaseQueuedAudio().
+ *
+ *  (len) is set to the number of bytes that can be read from the pointer
+ *  in one piece, which may be less than SDL_GetQueuedAudioSize() reports.
+ *  Release what you read, and peek again for the rest.
+ *
+ *  Do not call SDL_DequeueAudio() or SDL_ClearQueuedAudio() on the device
+ *  between this call and SDL_ReleaseQueuedAudio(); the pointer is not valid
+ *  anymore after either of them.
+ *
+ *  You may not dequeue audio from a device that is using an
+ *  application-supplied callback, or from a playback device; doing so
+ *  returns NULL.
+ *
+ *  \param dev The device ID from which we will dequeue audio.
+ *  \param len Filled in with the number of bytes (not samples!) available.
+ *  \return A pointer to the queued audio data, or NULL if there isn't any
+ *          or on error.
+ *
+ *  \sa SDL_ReleaseQueuedAudio
+ *  \sa SDL_DequeueAudio
+ */
+extern DECLSPEC const void *SDLCALL SDL_PeekQueuedAudio(SDL_AudioDeviceID dev, Uint32 *len);
+
+/**
+ *  Remove audio data read through SDL_PeekQueuedAudio() from the queue.
+ *
+ *  \param dev The device ID from which we will dequeue audio.
+ *  \param len The number of bytes (not samples!) to remove, which may not
+ *             be more than SDL_PeekQueuedAudio() reported.
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_PeekQueuedAudio
+ */
+extern DECLSPEC int SDLCALL SDL_ReleaseQueuedAudio(SDL_AudioDeviceID dev, Uint32 len);
+
+/**
+ *  \name Ring buffered audio devices
+ *
+ *  A ring buffered device has no callback. Instead, SDL gives it a fixed
+ *  size ring buffer that the application and the audio thread share
+ *  without any locking: the application writes into it whenever it likes
+ *  with SDL_QueueAudio() or SDL_ReserveQueuedAudio(), and the audio thread
+ *  just plays what it finds there, so neither side ever waits for the
+ *  other. Capture devices work the same way the other way around, with
+ *  SDL_DequeueAudio() or SDL_PeekQueuedAudio().
+ *
+ *  Only one application thread at a time may use the ring of a device.
+ *  The ring never grows, so SDL_QueueAudio() fails if the data doesn't fit,
+ *  and a capture device drops audio when the ring is full.
+ */
+/* @{ */
+
+/**
+ *  Status of a ring buffered audio device.
+ *
+ *  \sa SDL_GetAudioRingStatus
+ */
+typedef struct SDL_AudioRingStatus
+{
+    Uint32 size;        /**< Size of the ring buffer, in bytes */
+    Uint32 queued;      /**< Bytes (not samples!) waiting in the ring right now */
+    Uint32 underruns;   /**< Times a playback device ran out of audio and had to play silence */
+    Uint32 overruns;    /**< Times a capture device found the ring full and dropped audio */
+} SDL_AudioRingStatus;
+
+/**
+ *  Open a specific audio device with a ring buffer instead of a callback.
+ *
+ *  This works like SDL_OpenAudioDevice(), but (desired->callback) must be
+ *  NULL, and the device feeds from (or, for capture devices, fills) a ring
+ *  buffer of (ring_size) bytes. The size is rounded up to a power of two,
+ *  and to at least two of the device's buffers; zero picks a size of four
+ *  device buffers.
+ *
+ *  \return 0 on error, a valid device ID that is >= 2 on success.
+ *
+ *  \sa SDL_OpenAudioDevice
+ *  \sa SDL_GetAudioRingStatus
+ */
+extern DECLSPEC SDL_AudioDeviceID SDLCALL SDL_OpenAudioDeviceRing(const char *device,
+                                                                  int iscapture,
+                                                                  const SDL_AudioSpec *desired,
+                                                                  SDL_AudioSpec *obtained,
+                                                                  int allowed_changes,
+                                                                  Uint32 ring_size);
+
+/**
+ *  Get the fill level and underrun counts of a ring buffered audio device.
+ *
+ *  This doesn't lock anything and may be called from any thread. The
+ *  counters start at zero when the device is opened. A playback device
+ *  that runs dry counts one underrun, however long it stays dry; it starts
+ *  out dry, so the time before the first audio is queued doesn't count.
+ *
+ *  \param dev The device ID to query.
+ *  \param status Filled in with the device's current status.
+ *  \return 0 on success, or -1 if (dev) isn't a ring buffered device.
+ *
+ *  \sa SDL_OpenAudioDeviceRing
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioRingStatus(SDL_AudioDeviceID dev,
+                                                   SDL_AudioRingStatus *status);
+
+/* @} *//* Ring buffered audio devices */
+
 
 /**
  *  \name Audio lock functions
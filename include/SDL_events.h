@@ -659,6 +659,26 @@ extern DECLSPEC int SDLCALL SDL_WaitEventTimeout(SDL_Event * event,
  */
 extern DECLSPEC int SDLCALL SDL_PushEvent(SDL_Event * event);
 
+/**
+ *  \brief Add several events to the event queue at once.
+ *
+ *  Each event is timestamped and run through the event filter and event
+ *  watchers exactly as SDL_PushEvent() would, but the event queue is only
+ *  locked once and the accepted events are added to the queue together, in
+ *  the order they appear in the array.
+ *
+ *  \note The event filter and watchers are called with the event queue
+ *        locked, so other threads can't add events until this returns.
+ *
+ *  \return The number of events that were added to the queue, which may be
+ *          less than \c numevents if some were filtered, or if the event
+ *          queue filled up or there was some other error partway through.
+ *          The events before that point stay queued and the rest of the array
+ *          isn't looked at. Returns -1 if the error happened before any event
+ *          was added.
+ */
+extern DECLSPEC int SDLCALL SDL_PushEvents(SDL_Event * events, int numevents);
+
 typedef int (SDLCALL * SDL_EventFilter) (void *userdata, SDL_Event * event);
 
 /**
@@ -743,6 +763,58 @@ extern DECLSPEC Uint8 SDLCALL SDL_EventState(Uint32 type, int state);
  */
 extern DECLSPEC Uint32 SDLCALL SDL_RegisterEvents(int numevents);
 
+/**
+ *  The number of buckets in the event queue latency histogram.
+ */
+#define SDL_EVENT_LATENCY_BUCKETS   24
+
+/**
+ *  \brief Event queue statistics, see SDL_GetEventQueueStats()
+ */
+typedef struct SDL_EventQueueStats
+{
+    int depth;          /**< Events currently in the queue */
+    int peak_depth;     /**< Most events that have been in the queue at once */
+    Uint32 pushed;      /**< Events that have been added to the queue */
+    Uint32 coalesced;   /**< Pushed events that were merged into a queued event, see ::SDL_HINT_EVENT_COALESCING */
+    Uint32 dropped;     /**< Events that were lost because the queue was full or out of memory, or that SDL_PushEvents() filtered out */
+
+    /**
+     *  Events removed from the queue, by the time they spent in it.
+     *  Bucket 0 counts events that waited less than 1 microsecond, and
+     *  bucket i counts events that waited at least 2^(i-1) and less than
+     *  2^i microseconds. The last bucket also counts anything longer.
+     */
+    Uint32 latency[SDL_EVENT_LATENCY_BUCKETS];
+} SDL_EventQueueStats;
+
+/**
+ *  \brief Get statistics about the event queue since it was started or the
+ *         statistics were last reset.
+ *
+ *  The counters are always maintained, and are cheap enough to poll every
+ *  frame.
+ *
+ *  \return 0 on success, or -1 if the event system isn't running.
+ *
+ *  \sa SDL_ResetEventQueueStats()
+ *  \sa SDL_GetEventPushCount()
+ */
+extern DECLSPEC int SDLCALL SDL_GetEventQueueStats(SDL_EventQueueStats * stats);
+
+/**
+ *  \brief Get the number of events of a type that have been added to the
+ *         queue since it was started or the statistics were last reset.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetEventPushCount(Uint32 type);
+
+/**
+ *  \brief Reset the event queue statistics.
+ *
+ *  The peak depth is reset to the current depth.
+ */
+extern DECLSPEC void SDLCALL SDL_ResetEventQueueStats(void);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
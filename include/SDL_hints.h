@@ -134,7 +134,8 @@ extern "C" {
  *
  *  This variable can be set to the following values:
  *    "0" or "nearest" - Nearest pixel sampling
- *    "1" or "linear"  - Linear filtering (supported by OpenGL and Direct3D)
+ *    "1" or "linear"  - Linear filtering (supported by OpenGL, Direct3D and
+ *                       the software renderer)
  *    "2" or "best"    - Currently this is the same as "linear"
  *
  *  By default nearest pixel sampling is used
@@ -421,6 +422,23 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ *  \brief A variable that controls whether timer callbacks run on a pool of worker threads.
+ *
+ *  By default all timer callbacks run one after another on the timer thread,
+ *  so a slow callback delays every other timer.  With the pool enabled the
+ *  timer thread only tracks deadlines and hands expired timers to worker
+ *  threads, sized from the number of CPUs.  Callbacks of different timers
+ *  may then run at the same time.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Run callbacks on the timer thread (default)
+ *    "1"       - Run callbacks on a pool of worker threads
+ *
+ *  This hint is checked when the timer subsystem is initialized.
+ */
+#define SDL_HINT_TIMER_THREAD_POOL "SDL_TIMER_THREAD_POOL"
+
 
 /**
  *  \brief  A variable describing the content orientation on QtWayland-based platforms.
@@ -794,12 +812,13 @@ extern "C" {
 /**
  *  \brief  A variable controlling speed/quality tradeoff of audio resampling.
  *
- *  If available, SDL can use libsamplerate ( http://www.mega-nerd.com/SRC/ )
- *  to handle audio resampling. There are different resampling modes available
- *  that produce different levels of quality, using more CPU.
+ *  Besides its default, very fast resampler, SDL has a bandlimited (windowed
+ *  sinc) resampler with several quality settings, which use more CPU for
+ *  better quality. If SDL was built with libsamplerate
+ *  ( http://www.mega-nerd.com/SRC/ ), that is only used as a fallback.
  *
- *  If this hint isn't specified to a valid setting, or libsamplerate isn't
- *  available, SDL will use the default, internal resampling algorithm.
+ *  If this hint isn't specified to a valid setting, SDL will use the default,
+ *  internal resampling algorithm.
  *
  *  Note that this is currently only applicable to resampling audio that is
  *  being written to a device for playback or audio being read from a device
@@ -811,12 +830,50 @@ extern "C" {
  *  This variable can be set to the following values:
  *
  *    "0" or "default" - Use SDL's internal resampling (Default when not set - low quality, fast)
- *    "1" or "fast"    - Use fast, slightly higher quality resampling, if available
- *    "2" or "medium"  - Use medium quality resampling, if available
- *    "3" or "best"    - Use high quality resampling, if available
+ *    "1" or "fast"    - Use fast, slightly higher quality resampling
+ *    "2" or "medium"  - Use medium quality resampling
+ *    "3" or "best"    - Use high quality resampling
  */
 #define SDL_HINT_AUDIO_RESAMPLING_MODE   "SDL_AUDIO_RESAMPLING_MODE"
 
+/**
+ *  \brief  A variable controlling whether queued audio bypasses the audio device lock.
+ *
+ *  By default SDL_QueueAudio() and SDL_DequeueAudio() lock the audio device,
+ *  so they wait for the audio callback to finish and vice versa.  When this
+ *  is enabled, devices opened without a callback use a lock-free queue
+ *  instead.  The application must then only queue (or dequeue) audio for a
+ *  device from one thread at a time, and call SDL_ClearQueuedAudio() from
+ *  that same thread.
+ *
+ *  This hint is checked when an audio device is opened.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Queued audio is protected by the audio device lock (default)
+ *    "1"       - Queued audio uses a lock-free single producer, single consumer queue
+ */
+#define SDL_HINT_AUDIO_QUEUE_LOCKFREE   "SDL_AUDIO_QUEUE_LOCKFREE"
+
+/**
+ *  \brief  A variable controlling whether the event queue merges runs of events that only update state.
+ *
+ *  When enabled, an event that is added right after a compatible event of the
+ *  same type is merged into the queued event instead of being added after it:
+ *    - SDL_MOUSEMOTION for the same window, mouse and button state keeps the
+ *      latest position and accumulates xrel/yrel
+ *    - SDL_WINDOWEVENT_MOVED, SDL_WINDOWEVENT_RESIZED and
+ *      SDL_WINDOWEVENT_SIZE_CHANGED for the same window keep the latest data
+ *    - SDL_JOYAXISMOTION and SDL_CONTROLLERAXISMOTION for the same axis keep
+ *      the latest value, and SDL_JOYBALLMOTION accumulates xrel/yrel
+ *
+ *  Event filters and event watchers still see every event.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every event is added to the queue (default)
+ *    "1"       - Compatible consecutive events are merged
+ */
+#define SDL_HINT_EVENT_COALESCING "SDL_EVENT_COALESCING"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
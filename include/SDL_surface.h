@@ -476,13 +476,26 @@ extern DECLSPEC int SDLCALL SDL_LowerBlit
  *  \brief Perform a fast, low quality, stretch blit between two surfaces of the
  *         same pixel format.
  *
- *  \note This function uses a static buffer, and is not thread-safe.
+ *  \note This function keeps no state between calls, so different threads
+ *        may stretch into different destination surfaces at the same time.
  */
 extern DECLSPEC int SDLCALL SDL_SoftStretch(SDL_Surface * src,
                                             const SDL_Rect * srcrect,
                                             SDL_Surface * dst,
                                             const SDL_Rect * dstrect);
 
+/**
+ *  \brief Perform a bilinear filtered stretch blit between two surfaces of
+ *         the same pixel format.
+ *
+ *  Only formats with four 8-bit channels are supported, every channel
+ *  (including alpha) is interpolated on its own.
+ */
+extern DECLSPEC int SDLCALL SDL_SoftStretchLinear(SDL_Surface * src,
+                                                  const SDL_Rect * srcrect,
+                                                  SDL_Surface * dst,
+                                                  const SDL_Rect * dstrect);
+
 #define SDL_BlitScaled SDL_UpperBlitScaled
 
 /**
@@ -103,6 +103,59 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
+/**
+ *  Function prototype for the nanosecond timer callback function.
+ *
+ *  The callback function is passed the current timer interval in
+ *  nanoseconds and returns the next timer interval.  If the callback
+ *  returns 0, the periodic alarm is cancelled.
+ */
+typedef Uint64 (SDLCALL * SDL_NSTimerCallback) (Uint64 interval, void *param);
+
+/**
+ * \brief Add a new timer with an interval in nanoseconds.
+ *
+ * The timer is driven by the high resolution counter and is rescheduled
+ * relative to its previous deadline rather than to the time the callback
+ * ran, so a periodic timer doesn't drift.  If the callback falls behind
+ * by more than a whole interval, the missed deadlines are skipped.
+ *
+ * \return A timer ID, or 0 when an error occurs.
+ *
+ * \sa SDL_RemoveTimer
+ * \sa SDL_GetTimerStats
+ */
+extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval,
+                                                   SDL_NSTimerCallback callback,
+                                                   void *param);
+
+/**
+ * \brief Timer statistics, as returned by SDL_GetTimerStats().
+ *
+ * Lateness is the time between a deadline and the callback being called,
+ * and duration is the time the callback took to return, in nanoseconds.
+ */
+typedef struct SDL_TimerStats
+{
+    Uint32 fired;           /**< Number of times the callback has been called */
+    Uint32 missed;          /**< Number of deadlines skipped because the timer fell behind */
+    Uint64 min_lateness;    /**< Smallest lateness seen */
+    Uint64 max_lateness;    /**< Largest lateness seen */
+    Uint64 avg_lateness;    /**< Average lateness */
+    Uint64 max_duration;    /**< Longest time the callback has taken */
+    Uint64 avg_duration;    /**< Average time the callback has taken */
+} SDL_TimerStats;
+
+/**
+ * \brief Get the observed timing statistics for a timer.
+ *
+ * Statistics are available for as long as the timer ID is valid, which
+ * includes one-shot timers that have already fired.
+ *
+ * \return 0 on success, or -1 if the timer ID is unknown.
+ */
+extern DECLSPEC int SDLCALL SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
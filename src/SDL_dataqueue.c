@@ -39,6 +39,17 @@ struct SDL_DataQueue
     SDL_DataQueuePacket *pool; /* these are unused packets. */
     size_t packet_size;   /* size of new packets */
     size_t queued_bytes;  /* number of bytes of data in the queue. */
+    Uint32 flags;         /* SDL_DATAQUEUE_* flags */
+    SDL_DataQueuePacket *reserved;  /* packet with space handed out by SDL_ReserveDataQueueWrite(). */
+    size_t reserved_len;  /* bytes handed out by SDL_ReserveDataQueueWrite(). */
+
+    /* Only used with SDL_DATAQUEUE_SPSC. The reader owns head and startpos,
+       the writer owns tail, pool and datalen. The reader hands finished
+       packets back through spsc_pool, which the writer empties all at once,
+       so neither side ever waits for the other. */
+    char cache_pad[SDL_CACHELINE_SIZE];
+    void *spsc_pool;             /* finished packets, pushed by the reader. */
+    SDL_atomic_t spsc_bytes;     /* number of bytes of data in the queue. */
 };
 
 static void
@@ -52,10 +63,24 @@ SDL_FreeDataQueueList(SDL_DataQueuePacket *packet)
 }
 
 
-/* this all expects that you managed thread safety elsewhere. */
+static SDL_DataQueuePacket *
+SDL_NewDataQueuePacket(const size_t packetlen)
+{
+    SDL_DataQueuePacket *packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + packetlen);
+    if (packet) {
+        packet->datalen = 0;
+        packet->startpos = 0;
+        packet->next = NULL;
+    }
+    return packet;
+}
+
+
+/* this all expects that you managed thread safety elsewhere,
+   except for queues created with SDL_DATAQUEUE_SPSC. */
 
 SDL_DataQueue *
-SDL_NewDataQueue(const size_t _packetlen, const size_t initialslack)
+SDL_NewDataQueue(const size_t _packetlen, const size_t initialslack, const Uint32 flags)
 {
     SDL_DataQueue *queue = (SDL_DataQueue *) SDL_malloc(sizeof (SDL_DataQueue));
 
@@ -69,16 +94,33 @@ SDL_NewDataQueue(const size_t _packetlen, const size_t initialslack)
 
         SDL_zerop(queue);
         queue->packet_size = packetlen;
+        queue->flags = flags;
 
         for (i = 0; i < wantpackets; i++) {
-            SDL_DataQueuePacket *packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + packetlen);
+            SDL_DataQueuePacket *packet = SDL_NewDataQueuePacket(packetlen);
             if (packet) { /* don't care if this fails, we'll deal later. */
-                packet->datalen = 0;
-                packet->startpos = 0;
                 packet->next = queue->pool;
                 queue->pool = packet;
             }
         }
+
+        if (flags & SDL_DATAQUEUE_SPSC) {
+            /* There is always at least one packet in a lock-free queue, so the
+               reader and writer never have to agree on when it's empty. */
+            SDL_DataQueuePacket *packet = queue->pool;
+            if (packet) {
+                queue->pool = packet->next;
+                packet->next = NULL;
+            } else {
+                packet = SDL_NewDataQueuePacket(packetlen);
+                if (!packet) {
+                    SDL_free(queue);
+                    SDL_OutOfMemory();
+                    return NULL;
+                }
+            }
+            queue->head = queue->tail = packet;
+        }
     }
 
     return queue;
@@ -90,6 +132,10 @@ SDL_FreeDataQueue(SDL_DataQueue *queue)
     if (queue) {
         SDL_FreeDataQueueList(queue->head);
         SDL_FreeDataQueueList(queue->pool);
+        SDL_FreeDataQueueList((SDL_DataQueuePacket *) queue->spsc_pool);
+        if (queue->reserved && (queue->reserved != queue->tail)) {
+            SDL_free(queue->reserved);  /* a fresh packet that was never linked in. */
+        }
         SDL_free(queue);
     }
 }
@@ -107,6 +153,16 @@ SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack)
         return;
     }
 
+    /* Drop any write in progress, its packet goes back in the pool. */
+    if (queue->reserved) {
+        if (queue->reserved != queue->tail) {
+            queue->reserved->next = queue->pool;
+            queue->pool = queue->reserved;
+        }
+        queue->reserved = NULL;
+        queue->reserved_len = 0;
+    }
+
     packet = queue->head;
 
     /* merge the available pool and the current queue into one list. */
@@ -116,6 +172,40 @@ SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack)
         packet = queue->pool;
     }
 
+    if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        /* Nobody else is using the queue right now, so take back the
+           packets the reader has finished with, and reuse the first
+           packet as the empty packet the queue always keeps. */
+        SDL_DataQueuePacket *finished = (SDL_DataQueuePacket *) queue->spsc_pool;
+        SDL_DataQueuePacket *last = packet;
+        queue->spsc_pool = NULL;
+        while (last->next) {
+            last = last->next;
+        }
+        last->next = finished;
+
+        queue->head = queue->tail = packet;
+        queue->pool = packet->next;
+        packet->datalen = 0;
+        packet->startpos = 0;
+        packet->next = NULL;
+        SDL_AtomicSet(&queue->spsc_bytes, 0);
+
+        packet = queue->pool;
+        prev = NULL;
+        for (i = 0; packet && (i < slackpackets); i++) {
+            prev = packet;
+            packet = packet->next;
+        }
+        if (prev) {
+            prev->next = NULL;
+        } else {
+            queue->pool = NULL;
+        }
+        SDL_FreeDataQueueList(packet);  /* free extra packets */
+        return;
+    }
+
     /* Remove the queued packets from the device. */
     queue->tail = NULL;
     queue->head = NULL;
@@ -138,7 +228,7 @@ SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack)
 }
 
 static SDL_DataQueuePacket *
-AllocateDataQueuePacket(SDL_DataQueue *queue)
+GetDataQueuePacket(SDL_DataQueue *queue)
 {
     SDL_DataQueuePacket *packet;
 
@@ -159,7 +249,17 @@ AllocateDataQueuePacket(SDL_DataQueue *queue)
     packet->datalen = 0;
     packet->startpos = 0;
     packet->next = NULL;
-                
+    return packet;
+}
+
+static SDL_DataQueuePacket *
+AllocateDataQueuePacket(SDL_DataQueue *queue)
+{
+    SDL_DataQueuePacket *packet = GetDataQueuePacket(queue);
+    if (packet == NULL) {
+        return NULL;
+    }
+
     SDL_assert((queue->head != NULL) == (queue->queued_bytes != 0));
     if (queue->tail == NULL) {
         queue->head = packet;
@@ -171,6 +271,128 @@ AllocateDataQueuePacket(SDL_DataQueue *queue)
 }
 
 
+/* Get an empty packet for the writer of a lock-free queue. */
+static SDL_DataQueuePacket *
+SDL_AllocateSPSCPacket(SDL_DataQueue *queue)
+{
+    SDL_DataQueuePacket *packet = queue->pool;
+
+    if (!packet) {
+        /* Take everything the reader has finished with in one go, the
+           reader only ever pushes onto the list so there's no ABA issue. */
+        packet = (SDL_DataQueuePacket *) SDL_AtomicSetPtr(&queue->spsc_pool, NULL);
+    }
+    if (packet) {
+        queue->pool = packet->next;
+        packet->datalen = 0;
+        packet->startpos = 0;
+        packet->next = NULL;
+    } else {
+        packet = SDL_NewDataQueuePacket(queue->packet_size);
+    }
+    return packet;
+}
+
+static int
+SDL_WriteToSPSCDataQueue(SDL_DataQueue *queue, const Uint8 *data, const size_t _len)
+{
+    const size_t packet_size = queue->packet_size;
+    SDL_DataQueuePacket *packet = queue->tail;
+    SDL_DataQueuePacket *fresh = NULL;
+    SDL_DataQueuePacket *next;
+    size_t len = _len;
+    size_t needed, datalen;
+
+    /* Get all the packets we need first, so we either queue everything
+       or nothing: the reader can see each packet as soon as it's linked. */
+    needed = SDL_min(len, packet_size - packet->datalen);
+    needed = ((len - needed) + (packet_size - 1)) / packet_size;
+    while (needed--) {
+        next = SDL_AllocateSPSCPacket(queue);
+        if (!next) {
+            while (fresh) {
+                next = fresh->next;
+                fresh->next = queue->pool;
+                queue->pool = fresh;
+                fresh = next;
+            }
+            return SDL_OutOfMemory();
+        }
+        next->next = fresh;
+        fresh = next;
+    }
+
+    while (len > 0) {
+        if (packet->datalen >= packet_size) {
+            next = fresh;
+            fresh = fresh->next;
+            next->next = NULL;
+            SDL_MemoryBarrierRelease();
+            packet->next = next;
+            queue->tail = packet = next;
+        }
+
+        datalen = SDL_min(len, packet_size - packet->datalen);
+        SDL_memcpy(packet->data + packet->datalen, data, datalen);
+        data += datalen;
+        len -= datalen;
+        SDL_MemoryBarrierRelease();
+        packet->datalen += datalen;
+    }
+    SDL_assert(fresh == NULL);
+
+    SDL_AtomicAdd(&queue->spsc_bytes, (int) _len);
+    return 0;
+}
+
+static size_t
+SDL_ReadFromSPSCDataQueue(SDL_DataQueue *queue, Uint8 *buf, const size_t _len)
+{
+    SDL_DataQueuePacket *packet = queue->head;
+    SDL_DataQueuePacket *next;
+    size_t len = _len;
+    size_t datalen, cpy;
+    void *pool;
+
+    while (len > 0) {
+        datalen = packet->datalen;
+        SDL_MemoryBarrierAcquire();
+
+        if (packet->startpos == datalen) {
+            next = packet->next;
+            SDL_MemoryBarrierAcquire();
+            if (!next) {
+                break;  /* caught up with the writer. */
+            }
+            if (packet->datalen != datalen) {
+                continue;  /* the writer filled it up before moving on. */
+            }
+
+            /* packet is done, hand it back to the writer. */
+            queue->head = next;
+            do {
+                pool = queue->spsc_pool;
+                packet->next = (SDL_DataQueuePacket *) pool;
+            } while (!SDL_AtomicCASPtr(&queue->spsc_pool, pool, packet));
+            packet = next;
+            continue;
+        }
+
+        cpy = SDL_min(len, datalen - packet->startpos);
+        if (buf) {
+            SDL_memcpy(buf, packet->data + packet->startpos, cpy);
+            buf += cpy;
+        }
+        packet->startpos += cpy;
+        len -= cpy;
+    }
+
+    if (len < _len) {
+        SDL_AtomicAdd(&queue->spsc_bytes, -(int) (_len - len));
+    }
+    return _len - len;
+}
+
 int
 SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *_data, const size_t _len)
 {
@@ -184,6 +406,12 @@ SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *_data, const size_t _len)
 
     if (!queue) {
         return SDL_InvalidParamError("queue");
+    } else if (queue->reserved) {
+        return SDL_SetError("Can't write to a data queue with a write in progress");
+    }
+
+    if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        return SDL_WriteToSPSCDataQueue(queue, data, len);
     }
 
     orighead = queue->head;
@@ -225,30 +453,30 @@ SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *_data, const size_t _len)
     return 0;
 }
 
-size_t
-SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
+static size_t
+SDL_ReadFromLockedDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
 {
     size_t len = _len;
-    Uint8 *buf = (Uint8 *) _buf;
-    Uint8 *ptr = buf;
+    Uint8 *ptr = (Uint8 *) _buf;
     SDL_DataQueuePacket *packet;
 
-    if (!queue) {
-        return 0;
-    }
-
     while ((len > 0) && ((packet = queue->head) != NULL)) {
         const size_t avail = packet->datalen - packet->startpos;
         const size_t cpy = SDL_min(len, avail);
         SDL_assert(queue->queued_bytes >= avail);
 
-        SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
+        if (ptr) {
+            SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
+            ptr += cpy;
+        }
         packet->startpos += cpy;
-        ptr += cpy;
         queue->queued_bytes -= cpy;
         len -= cpy;
 
         if (packet->startpos == packet->datalen) {  /* packet is done, put it in the pool. */
+            if (packet == queue->reserved) {
+                break;  /* ...unless the rest of it is being written to. */
+            }
             queue->head = packet->next;
             SDL_assert((packet->next != NULL) || (packet == queue->tail));
             packet->next = queue->pool;
@@ -256,19 +484,219 @@ SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
         }
     }
 
-    SDL_assert((queue->head != NULL) == (queue->queued_bytes != 0));
+    SDL_assert(((queue->head != NULL) == (queue->queued_bytes != 0)) || (queue->head == queue->reserved));
 
     if (queue->head == NULL) {
         queue->tail = NULL;  /* in case we drained the queue entirely. */
     }
 
-    return (size_t) (ptr - buf);
+    return _len - len;
+}
+
+size_t
+SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *buf, const size_t len)
+{
+    if (!queue || !buf) {
+        return 0;
+    }
+
+    if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        return SDL_ReadFromSPSCDataQueue(queue, (Uint8 *) buf, len);
+    }
+    return SDL_ReadFromLockedDataQueue(queue, buf, len);
+}
+
+void *
+SDL_ReserveDataQueueWrite(SDL_DataQueue *queue, size_t *len)
+{
+    SDL_DataQueuePacket *packet;
+    size_t wanted;
+
+    if (!queue) {
+        SDL_InvalidParamError("queue");
+        return NULL;
+    } else if (!len || (*len == 0)) {
+        SDL_InvalidParamError("len");
+        return NULL;
+    } else if (queue->reserved) {
+        SDL_SetError("A data queue write is already in progress");
+        return NULL;
+    }
+
+    /* Hand out the space at the end of the tail packet first, like
+       SDL_WriteToDataQueue() fills it, and only start a new packet once it's
+       full. The reader never recycles the tail packet of a lock-free queue,
+       and leaves a reserved one alone otherwise, so the space stays put
+       until it's committed. */
+    packet = queue->tail;
+    if (!packet || (packet->datalen >= queue->packet_size)) {
+        if (queue->flags & SDL_DATAQUEUE_SPSC) {
+            packet = SDL_AllocateSPSCPacket(queue);
+        } else {
+            packet = GetDataQueuePacket(queue);
+        }
+        if (!packet) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+    }
+    wanted = SDL_min(*len, queue->packet_size - packet->datalen);
+
+    queue->reserved = packet;
+    queue->reserved_len = wanted;
+    *len = wanted;
+    return packet->data + packet->datalen;
+}
+
+int
+SDL_CommitDataQueueWrite(SDL_DataQueue *queue, const size_t len)
+{
+    SDL_DataQueuePacket *packet;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (!queue->reserved) {
+        return SDL_SetError("No data queue write in progress");
+    } else if (len > queue->reserved_len) {
+        return SDL_InvalidParamError("len");
+    }
+
+    packet = queue->reserved;
+    queue->reserved = NULL;
+    queue->reserved_len = 0;
+
+    if (packet == queue->tail) {
+        if (queue->flags & SDL_DATAQUEUE_SPSC) {
+            SDL_MemoryBarrierRelease();
+        } else if ((len == 0) && (packet->startpos == packet->datalen)) {
+            /* the reader drained it and left it for us, so it's the only
+               packet in the queue; recycle it like the reader would have. */
+            SDL_assert(packet == queue->head);
+            queue->head = queue->tail = NULL;
+            packet->next = queue->pool;
+            queue->pool = packet;
+            return 0;
+        }
+        packet->datalen += len;
+    } else if (len == 0) {
+        /* nothing written, the packet goes back to the pool. */
+        packet->next = queue->pool;
+        queue->pool = packet;
+        return 0;
+    } else {
+        packet->datalen = len;
+        if (queue->flags & SDL_DATAQUEUE_SPSC) {
+            SDL_MemoryBarrierRelease();
+            queue->tail->next = packet;
+        } else if (queue->tail) {
+            queue->tail->next = packet;
+        } else {
+            queue->head = packet;
+        }
+        queue->tail = packet;
+    }
+
+    if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        SDL_AtomicAdd(&queue->spsc_bytes, (int) len);
+    } else {
+        queue->queued_bytes += len;
+    }
+    return 0;
+}
+
+void *
+SDL_PeekDataQueueRead(SDL_DataQueue *queue, size_t *len)
+{
+    SDL_DataQueuePacket *packet;
+    size_t datalen;
+
+    if (!queue) {
+        SDL_InvalidParamError("queue");
+        return NULL;
+    } else if (!len) {
+        SDL_InvalidParamError("len");
+        return NULL;
+    }
+
+    *len = 0;
+
+    if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        packet = queue->head;
+        for (;;) {
+            SDL_DataQueuePacket *next;
+            void *pool;
+
+            datalen = packet->datalen;
+            SDL_MemoryBarrierAcquire();
+            if (packet->startpos < datalen) {
+                break;
+            }
+
+            next = packet->next;
+            SDL_MemoryBarrierAcquire();
+            if (!next) {
+                return NULL;  /* caught up with the writer. */
+            } else if (packet->datalen != datalen) {
+                continue;  /* the writer filled it up before moving on. */
+            }
+
+            /* packet is done, hand it back to the writer. */
+            queue->head = next;
+            do {
+                pool = queue->spsc_pool;
+                packet->next = (SDL_DataQueuePacket *) pool;
+            } while (!SDL_AtomicCASPtr(&queue->spsc_pool, pool, packet));
+            packet = next;
+        }
+    } else {
+        packet = queue->head;
+        if (!packet || (packet->startpos == packet->datalen)) {
+            return NULL;  /* empty, or only a reserved packet that was drained. */
+        }
+        datalen = packet->datalen;
+    }
+
+    *len = datalen - packet->startpos;
+    return packet->data + packet->startpos;
+}
+
+int
+SDL_ReleaseDataQueueRead(SDL_DataQueue *queue, const size_t len)
+{
+    size_t avail;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    /* Only what SDL_PeekDataQueueRead() handed out can be released. */
+    if (!SDL_PeekDataQueueRead(queue, &avail) && (len > 0)) {
+        return SDL_SetError("Nothing to release in data queue");
+    } else if (len > avail) {
+        return SDL_InvalidParamError("len");
+    }
+
+    if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        SDL_ReadFromSPSCDataQueue(queue, NULL, len);
+    } else {
+        SDL_ReadFromLockedDataQueue(queue, NULL, len);
+    }
+    return 0;
 }
 
 size_t
 SDL_CountDataQueue(SDL_DataQueue *queue)
 {
-    return queue ? queue->queued_bytes : 0;
+    if (!queue) {
+        return 0;
+    }
+    if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        /* A plain read is fine here, the count is only ever a snapshot. */
+        const int count = queue->spsc_bytes.value;
+        SDL_MemoryBarrierAcquire();
+        return (size_t) count;
+    }
+    return queue->queued_bytes;
 }
 
 void *
@@ -285,6 +713,10 @@ SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len)
     } else if (len > queue->packet_size) {
         SDL_SetError("len is larger than packet size");
         return NULL;
+    } else if (queue->flags & SDL_DATAQUEUE_SPSC) {
+        /* the reader would see the reserved space before it's written. */
+        SDL_SetError("Can't reserve space in a lock-free data queue");
+        return NULL;
     }
 
     packet = queue->head;
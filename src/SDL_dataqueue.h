@@ -26,7 +26,16 @@
 struct SDL_DataQueue;
 typedef struct SDL_DataQueue SDL_DataQueue;
 
-SDL_DataQueue *SDL_NewDataQueue(const size_t packetlen, const size_t initialslack);
+/* With this flag, one thread may write to the queue while another thread
+   reads from it without any locking. Only SDL_WriteToDataQueue(),
+   SDL_ReserveDataQueueWrite() and SDL_CommitDataQueueWrite() on the writing
+   side, SDL_ReadFromDataQueue(), SDL_PeekDataQueueRead() and
+   SDL_ReleaseDataQueueRead() on the reading side, and SDL_CountDataQueue()
+   from either side, are safe to use this way; everything else still needs
+   both sides stopped. */
+#define SDL_DATAQUEUE_SPSC  0x00000001
+
+SDL_DataQueue *SDL_NewDataQueue(const size_t packetlen, const size_t initialslack, const Uint32 flags);
 void SDL_FreeDataQueue(SDL_DataQueue *queue);
 void SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack);
 int SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *data, const size_t len);
@@ -48,6 +57,24 @@ size_t SDL_CountDataQueue(SDL_DataQueue *queue);
 */
 void *SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len);
 
+/* Zero-copy writes: this hands out up to (*len) bytes of packet storage to
+   write into, and sets (*len) to how much you actually got, which is never
+   more than the packetlen requested in SDL_NewDataQueue. Nothing is visible
+   to the reader until SDL_CommitDataQueueWrite() says how much of it was
+   filled in (zero is fine). Only one write can be in progress at a time,
+   and SDL_WriteToDataQueue() fails until it's committed.
+   Returns pointer to the space, NULL on error. */
+void *SDL_ReserveDataQueueWrite(SDL_DataQueue *queue, size_t *len);
+int SDL_CommitDataQueueWrite(SDL_DataQueue *queue, const size_t len);
+
+/* Zero-copy reads: this returns a pointer to the oldest queued data and sets
+   (*len) to how many bytes can be read from it in one piece, which may be
+   less than SDL_CountDataQueue() reports. The data stays queued until
+   SDL_ReleaseDataQueueRead() consumes up to (*len) bytes of it.
+   Returns NULL and sets (*len) to zero if the queue is empty. */
+void *SDL_PeekDataQueueRead(SDL_DataQueue *queue, size_t *len);
+int SDL_ReleaseDataQueueRead(SDL_DataQueue *queue, const size_t len);
+
 #endif /* SDL_dataqueue_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
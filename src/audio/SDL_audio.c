@@ -111,6 +111,25 @@ static const AudioBootStrap *const bootstrap[] = {
 };
 
 
+SDL_ResamplerQuality SDL_AudioResamplerQuality = SDL_RESAMPLER_DEFAULT;
+
+static SDL_ResamplerQuality
+GetResamplerQualityHint(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_RESAMPLING_MODE);
+
+    if (!hint) {
+        return SDL_RESAMPLER_DEFAULT;
+    } else if (*hint == '1' || SDL_strcasecmp(hint, "fast") == 0) {
+        return SDL_RESAMPLER_FAST;
+    } else if (*hint == '2' || SDL_strcasecmp(hint, "medium") == 0) {
+        return SDL_RESAMPLER_MEDIUM;
+    } else if (*hint == '3' || SDL_strcasecmp(hint, "best") == 0) {
+        return SDL_RESAMPLER_BEST;
+    }
+    return SDL_RESAMPLER_DEFAULT;  /* treat anything else like "default". */
+}
+
 #ifdef HAVE_LIBSAMPLERATE_H
 #ifdef SDL_LIBSAMPLERATE_DYNAMIC
 static void *SRC_lib = NULL;
@@ -126,21 +145,21 @@ const char* (*SRC_src_strerror)(int error) = NULL;
 static SDL_bool
 LoadLibSampleRate(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_RESAMPLING_MODE);
-
     SRC_available = SDL_FALSE;
     SRC_converter = 0;
 
-    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "default") == 0) {
-        return SDL_FALSE;  /* don't load anything. */
-    } else if (*hint == '1' || SDL_strcasecmp(hint, "fast") == 0) {
+    switch (SDL_AudioResamplerQuality) {
+    case SDL_RESAMPLER_FAST:
         SRC_converter = SRC_SINC_FASTEST;
-    } else if (*hint == '2' || SDL_strcasecmp(hint, "medium") == 0) {
+        break;
+    case SDL_RESAMPLER_MEDIUM:
         SRC_converter = SRC_SINC_MEDIUM_QUALITY;
-    } else if (*hint == '3' || SDL_strcasecmp(hint, "best") == 0) {
+        break;
+    case SDL_RESAMPLER_BEST:
         SRC_converter = SRC_SINC_BEST_QUALITY;
-    } else {
-        return SDL_FALSE;  /* treat it like "default", don't load anything. */
+        break;
+    default:
+        return SDL_FALSE;  /* don't load anything. */
     }
 
 #ifdef SDL_LIBSAMPLERATE_DYNAMIC
@@ -464,6 +483,100 @@ void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device)
     }
 }
 
+#define NS_PER_SECOND   1000000000
+
+static Uint64
+SDL_AudioNSToCounter(const Uint64 ns)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    return (ns / NS_PER_SECOND) * frequency +
+           ((ns % NS_PER_SECOND) * frequency) / NS_PER_SECOND;
+}
+
+static Uint64
+SDL_AudioCounterToNS(const Uint64 counter)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    return (counter / frequency) * NS_PER_SECOND +
+           ((counter % frequency) * NS_PER_SECOND) / frequency;
+}
+
+/* The audio backends call this when a playback device underruns. */
+void
+SDL_AudioDeviceUnderrun(SDL_AudioDevice *device)
+{
+    SDL_AtomicLock(&device->stats.lock);
+    device->stats.underruns++;
+    SDL_AtomicUnlock(&device->stats.lock);
+}
+
+void
+SDL_SimulatedPlayDevice(SDL_AudioDevice *device, Uint64 period)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    if (period == 0) {
+        return;  /* a device that plays infinitely fast never runs dry. */
+    }
+
+    if (now > device->simulated_deadline) {
+        /* the last buffer already ran out (unless this is the first one). */
+        if (device->simulated_deadline != 0) {
+            SDL_AudioDeviceUnderrun(device);
+        }
+        device->simulated_deadline = now;
+    }
+    device->simulated_deadline += SDL_AudioNSToCounter(period);
+}
+
+void
+SDL_SimulatedWaitDevice(SDL_AudioDevice *device, Uint64 period)
+{
+    /* Ask for the next buffer as soon as there's only one left to play,
+       like a double buffered device would. */
+    const Uint64 wakeup = device->simulated_deadline - SDL_AudioNSToCounter(period);
+    const Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 delay = 0;
+
+    if ((period != 0) && (wakeup > now) && (device->simulated_deadline != 0)) {
+        delay = (Uint32) (SDL_AudioCounterToNS(wakeup - now) / 1000000);
+    }
+
+    /* Sleep even if we're behind, so a callback that can't keep up doesn't
+       starve threads waiting to lock the device. */
+    SDL_Delay(delay);
+}
+
+/* Audio thread: count a call to the app's callback that took (duration) ticks. */
+static void
+SDL_CountAudioCallback(SDL_AudioDevice *device, const Uint64 duration)
+{
+    SDL_AudioDeviceStatsData *stats = &device->stats;
+
+    SDL_AtomicLock(&stats->lock);
+    if ((stats->callbacks == 0) || (duration < stats->min_callback)) {
+        stats->min_callback = duration;
+    }
+    if (duration > stats->max_callback) {
+        stats->max_callback = duration;
+    }
+    stats->total_callback += duration;
+    stats->callbacks++;
+    SDL_AtomicUnlock(&stats->lock);
+}
+
+/* Audio thread: count (len) bytes of silence, in (spec)'s format, that SDL
+   played because it ran out of audio. */
+static void
+SDL_CountAudioSilence(SDL_AudioDevice *device, const SDL_AudioSpec *spec, const int len)
+{
+    const int framesize = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+
+    SDL_AtomicLock(&device->stats.lock);
+    device->stats.silence_frames += (Uint32) (len / framesize);
+    SDL_AtomicUnlock(&device->stats.lock);
+}
+
 static void
 mark_device_removed(void *handle, SDL_AudioDeviceItem *devices, SDL_bool *removedFlag)
 {
@@ -509,6 +622,120 @@ SDL_RemoveAudioDevice(const int iscapture, void *handle)
 
 /* buffer queueing support... */
 
+static SDL_AudioRing *
+SDL_NewAudioRing(Uint32 size)
+{
+    SDL_AudioRing *ring = (SDL_AudioRing *) SDL_calloc(1, sizeof (SDL_AudioRing));
+    Uint32 pow2 = 1;
+
+    while (pow2 < size) {
+        pow2 <<= 1;
+    }
+
+    if (ring) {
+        ring->size = pow2;
+        ring->data = (Uint8 *) SDL_malloc(pow2);
+        if (!ring->data) {
+            SDL_free(ring);
+            ring = NULL;
+        }
+    }
+
+    if (!ring) {
+        SDL_OutOfMemory();
+    }
+    return ring;
+}
+
+static void
+SDL_FreeAudioRing(SDL_AudioRing *ring)
+{
+    if (ring) {
+        SDL_free(ring->data);
+        SDL_free(ring);
+    }
+}
+
+static Uint32
+SDL_CountAudioRing(SDL_AudioRing *ring)
+{
+    /* read the tail first: it never passes the head, so this can't go negative. */
+    const Uint32 tail = (Uint32) SDL_AtomicGet(&ring->tail);
+    return ((Uint32) SDL_AtomicGet(&ring->head)) - tail;
+}
+
+/* Writer side: where the next bytes go, and how many fit there in one piece. */
+static Uint8 *
+SDL_AudioRingWritePtr(SDL_AudioRing *ring, Uint32 *len)
+{
+    const Uint32 head = (Uint32) SDL_AtomicGet(&ring->head);
+    const Uint32 offset = head & (ring->size - 1);
+    const Uint32 space = ring->size - SDL_CountAudioRing(ring);
+    *len = SDL_min(space, ring->size - offset);
+    return ring->data + offset;
+}
+
+/* Reader side: where the oldest bytes are, and how many are there in one piece. */
+static Uint8 *
+SDL_AudioRingReadPtr(SDL_AudioRing *ring, Uint32 *len)
+{
+    const Uint32 tail = (Uint32) SDL_AtomicGet(&ring->tail);
+    const Uint32 offset = tail & (ring->size - 1);
+    const Uint32 avail = ((Uint32) SDL_AtomicGet(&ring->head)) - tail;
+    *len = SDL_min(avail, ring->size - offset);
+    return ring->data + offset;
+}
+
+/* Writes as much of (buf) as fits, returns how much that was. */
+static Uint32
+SDL_WriteToAudioRing(SDL_AudioRing *ring, const void *buf, Uint32 len)
+{
+    const Uint32 head = (Uint32) SDL_AtomicGet(&ring->head);
+    const Uint32 offset = head & (ring->size - 1);
+    const Uint32 space = ring->size - SDL_CountAudioRing(ring);
+    Uint32 first;
+
+    len = SDL_min(len, space);
+    first = SDL_min(len, ring->size - offset);
+    SDL_memcpy(ring->data + offset, buf, first);
+    SDL_memcpy(ring->data, ((const Uint8 *) buf) + first, len - first);
+
+    SDL_AtomicAdd(&ring->head, (int) len);  /* this publishes the data to the reader. */
+    return len;
+}
+
+/* Reads up to (len) bytes into (buf), returns how much that was. */
+static Uint32
+SDL_ReadFromAudioRing(SDL_AudioRing *ring, void *buf, Uint32 len)
+{
+    const Uint32 tail = (Uint32) SDL_AtomicGet(&ring->tail);
+    const Uint32 offset = tail & (ring->size - 1);
+    const Uint32 avail = ((Uint32) SDL_AtomicGet(&ring->head)) - tail;
+    Uint32 first;
+
+    len = SDL_min(len, avail);
+    first = SDL_min(len, ring->size - offset);
+    SDL_memcpy(buf, ring->data + offset, first);
+    SDL_memcpy(((Uint8 *) buf) + first, ring->data, len - first);
+
+    /* If the writer cleared the ring while we copied, the tail moved and
+       what we got may already be overwritten. Pretend we got nothing. */
+    if (!SDL_AtomicCAS(&ring->tail, (int) tail, (int) (tail + len))) {
+        return 0;
+    }
+    return len;
+}
+
+static void
+SDL_ClearAudioRing(SDL_AudioRing *ring)
+{
+    int tail;
+    do {
+        tail = SDL_AtomicGet(&ring->tail);
+    } while (!SDL_AtomicCAS(&ring->tail, tail, SDL_AtomicGet(&ring->head)));
+}
+
+
 static void SDLCALL
 SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
 {
@@ -520,13 +747,30 @@ SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(!device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
+    if (device->ring) {  /* we don't hold the mixer lock in this case. */
+        SDL_AudioRing *ring = device->ring;
+        const Uint32 got = SDL_ReadFromAudioRing(ring, stream, (Uint32) len);
+        if (got < (Uint32) len) {
+            if (!ring->stalled || (got > 0)) {  /* count each time it runs dry. */
+                ring->stalled = SDL_TRUE;
+                SDL_AtomicIncRef(&ring->underruns);
+            }
+            SDL_memset(stream + got, device->spec.silence, len - got);
+            SDL_CountAudioSilence(device, &device->callbackspec, len - (int) got);
+        } else {
+            ring->stalled = SDL_FALSE;
+        }
+        return;
+    }
+
     dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
     stream += dequeued;
     len -= (int) dequeued;
 
     if (len > 0) {  /* fill any remaining space in the stream with silence. */
-        SDL_assert(SDL_CountDataQueue(device->buffer_queue) == 0);
+        SDL_assert(device->buffer_queue_lockfree || (SDL_CountDataQueue(device->buffer_queue) == 0));
         SDL_memset(stream, device->spec.silence, len);
+        SDL_CountAudioSilence(device, &device->callbackspec, len);
     }
 }
 
@@ -540,6 +784,20 @@ SDL_BufferQueueFillCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
+    if (device->ring) {  /* we don't hold the mixer lock in this case. */
+        SDL_AudioRing *ring = device->ring;
+        const Uint32 put = SDL_WriteToAudioRing(ring, stream, (Uint32) len);
+        if (put < (Uint32) len) {
+            if (!ring->stalled || (put > 0)) {  /* count each time it fills up. */
+                ring->stalled = SDL_TRUE;
+                SDL_AtomicIncRef(&ring->overruns);
+            }
+        } else {
+            ring->stalled = SDL_FALSE;
+        }
+        return;
+    }
+
     /* note that if this needs to allocate more space and run out of memory,
        we have no choice but to quietly drop the data and hope it works out
        later, but you probably have bigger problems in this case anyhow. */
@@ -561,9 +819,18 @@ SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
     }
 
     if (len > 0) {
-        current_audio.impl.LockDevice(device);
-        rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
-        current_audio.impl.UnlockDevice(device);
+        if (device->ring) {
+            if (len > (device->ring->size - SDL_CountAudioRing(device->ring))) {
+                return SDL_SetError("Not enough room in the audio ring buffer");
+            }
+            SDL_WriteToAudioRing(device->ring, data, len);
+        } else if (device->buffer_queue_lockfree) {
+            rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
+        } else {
+            current_audio.impl.LockDevice(device);
+            rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
+            current_audio.impl.UnlockDevice(device);
+        }
     }
 
     return rc;
@@ -582,6 +849,12 @@ SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
         return 0;  /* just report zero bytes dequeued. */
     }
 
+    if (device->ring) {
+        return SDL_ReadFromAudioRing(device->ring, data, len);
+    } else if (device->buffer_queue_lockfree) {
+        return (Uint32) SDL_ReadFromDataQueue(device->buffer_queue, data, len);
+    }
+
     current_audio.impl.LockDevice(device);
     rc = (Uint32) SDL_ReadFromDataQueue(device->buffer_queue, data, len);
     current_audio.impl.UnlockDevice(device);
@@ -599,14 +872,20 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
     }
 
     /* Nothing to do unless we're set up for queueing. */
-    if (device->callbackspec.callback == SDL_BufferQueueDrainCallback) {
+    if (device->ring) {
+        retval = SDL_CountAudioRing(device->ring);
+    } else if (device->callbackspec.callback == SDL_BufferQueueDrainCallback) {
         current_audio.impl.LockDevice(device);
         retval = ((Uint32) SDL_CountDataQueue(device->buffer_queue)) + current_audio.impl.GetPendingBytes(device);
         current_audio.impl.UnlockDevice(device);
     } else if (device->callbackspec.callback == SDL_BufferQueueFillCallback) {
-        current_audio.impl.LockDevice(device);
-        retval = (Uint32) SDL_CountDataQueue(device->buffer_queue);
-        current_audio.impl.UnlockDevice(device);
+        if (device->buffer_queue_lockfree) {
+            retval = (Uint32) SDL_CountDataQueue(device->buffer_queue);
+        } else {
+            current_audio.impl.LockDevice(device);
+            retval = (Uint32) SDL_CountDataQueue(device->buffer_queue);
+            current_audio.impl.UnlockDevice(device);
+        }
     }
 
     return retval;
@@ -619,6 +898,10 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 
     if (!device) {
         return;  /* nothing to do. */
+    } else if (device->ring) {
+        SDL_ClearAudioRing(device->ring);
+        device->ring_peeked = 0;  /* that data is gone now. */
+        return;
     }
 
     /* Blank out the device and release the mutex. Free it afterwards. */
@@ -631,6 +914,158 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 }
 
 
+void *
+SDL_ReserveQueuedAudio(SDL_AudioDeviceID devid, Uint32 *len)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    size_t avail;
+    void *retval;
+
+    if (!device) {
+        return NULL;  /* get_audio_device() will have set the error state */
+    } else if (device->iscapture) {
+        SDL_SetError("This is a capture device, queueing not allowed");
+        return NULL;
+    } else if (device->callbackspec.callback != SDL_BufferQueueDrainCallback) {
+        SDL_SetError("Audio device has a callback, queueing not allowed");
+        return NULL;
+    } else if (!len) {
+        SDL_InvalidParamError("len");
+        return NULL;
+    }
+
+    if (device->ring) {
+        Uint32 ringavail;
+        retval = SDL_AudioRingWritePtr(device->ring, &ringavail);
+        if (ringavail == 0) {
+            SDL_SetError("Audio ring buffer is full");
+            retval = NULL;
+        }
+        *len = retval ? SDL_min(*len, ringavail) : 0;
+        device->ring_reserved = *len;
+        return retval;
+    }
+
+    avail = *len;
+    if (device->buffer_queue_lockfree) {
+        retval = SDL_ReserveDataQueueWrite(device->buffer_queue, &avail);
+    } else {
+        current_audio.impl.LockDevice(device);
+        retval = SDL_ReserveDataQueueWrite(device->buffer_queue, &avail);
+        current_audio.impl.UnlockDevice(device);
+    }
+
+    *len = retval ? (Uint32) avail : 0;
+    return retval;
+}
+
+int
+SDL_CommitQueuedAudio(SDL_AudioDeviceID devid, Uint32 len)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    int rc;
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (device->iscapture) {
+        return SDL_SetError("This is a capture device, queueing not allowed");
+    } else if (device->callbackspec.callback != SDL_BufferQueueDrainCallback) {
+        return SDL_SetError("Audio device has a callback, queueing not allowed");
+    }
+
+    if (device->ring) {
+        if (len > device->ring_reserved) {
+            return SDL_SetError("Committed more audio than was reserved");
+        }
+        device->ring_reserved = 0;
+        SDL_AtomicAdd(&device->ring->head, (int) len);
+        rc = 0;
+    } else if (device->buffer_queue_lockfree) {
+        rc = SDL_CommitDataQueueWrite(device->buffer_queue, len);
+    } else {
+        current_audio.impl.LockDevice(device);
+        rc = SDL_CommitDataQueueWrite(device->buffer_queue, len);
+        current_audio.impl.UnlockDevice(device);
+    }
+
+    return rc;
+}
+
+const void *
+SDL_PeekQueuedAudio(SDL_AudioDeviceID devid, Uint32 *len)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    size_t avail = 0;
+    void *retval;
+
+    if (!device) {
+        return NULL;  /* get_audio_device() will have set the error state */
+    } else if (!device->iscapture) {
+        SDL_SetError("This is a playback device, dequeueing not allowed");
+        return NULL;
+    } else if (device->callbackspec.callback != SDL_BufferQueueFillCallback) {
+        SDL_SetError("Audio device has a callback, dequeueing not allowed");
+        return NULL;
+    } else if (!len) {
+        SDL_InvalidParamError("len");
+        return NULL;
+    }
+
+    /* The device only ever appends, so what we hand out stays put until
+       it's released, even after we let go of the lock. */
+    if (device->ring) {
+        Uint32 ringavail;
+        retval = SDL_AudioRingReadPtr(device->ring, &ringavail);
+        avail = ringavail;
+        if (avail == 0) {
+            retval = NULL;
+        }
+        device->ring_peeked = ringavail;
+    } else if (device->buffer_queue_lockfree) {
+        retval = SDL_PeekDataQueueRead(device->buffer_queue, &avail);
+    } else {
+        current_audio.impl.LockDevice(device);
+        retval = SDL_PeekDataQueueRead(device->buffer_queue, &avail);
+        current_audio.impl.UnlockDevice(device);
+    }
+
+    *len = (Uint32) avail;
+    return retval;
+}
+
+int
+SDL_ReleaseQueuedAudio(SDL_AudioDeviceID devid, Uint32 len)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    int rc;
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (!device->iscapture) {
+        return SDL_SetError("This is a playback device, dequeueing not allowed");
+    } else if (device->callbackspec.callback != SDL_BufferQueueFillCallback) {
+        return SDL_SetError("Audio device has a callback, dequeueing not allowed");
+    }
+
+    if (device->ring) {
+        if (len > device->ring_peeked) {
+            return SDL_SetError("Released more audio than was peeked");
+        }
+        device->ring_peeked = 0;
+        SDL_AtomicAdd(&device->ring->tail, (int) len);
+        rc = 0;
+    } else if (device->buffer_queue_lockfree) {
+        rc = SDL_ReleaseDataQueueRead(device->buffer_queue, len);
+    } else {
+        current_audio.impl.LockDevice(device);
+        rc = SDL_ReleaseDataQueueRead(device->buffer_queue, len);
+        current_audio.impl.UnlockDevice(device);
+    }
+
+    return rc;
+}
+
+
 /* The general mixing thread function */
 static int SDLCALL
 SDL_RunAudio(void *devicep)
@@ -672,13 +1107,20 @@ SDL_RunAudio(void *devicep)
         }
 
         /* !!! FIXME: this should be LockDevice. */
-        SDL_LockMutex(device->mixer_lock);
+        /* A ring buffer is all a ring buffered device shares with the app. */
+        if (!device->ring) {
+            SDL_LockMutex(device->mixer_lock);
+        }
         if (SDL_AtomicGet(&device->paused)) {
             SDL_memset(data, device->spec.silence, data_len);
         } else {
+            const Uint64 start = SDL_GetPerformanceCounter();
             callback(udata, data, data_len);
+            SDL_CountAudioCallback(device, SDL_GetPerformanceCounter() - start);
+        }
+        if (!device->ring) {
+            SDL_UnlockMutex(device->mixer_lock);
         }
-        SDL_UnlockMutex(device->mixer_lock);
 
         if (device->stream) {
             /* Stream available audio to device, converting/resampling. */
@@ -697,6 +1139,7 @@ SDL_RunAudio(void *devicep)
                 } else {
                     if (got != device->spec.size) {
                         SDL_memset(data, device->spec.silence, device->spec.size);
+                        SDL_CountAudioSilence(device, &device->spec, device->spec.size);
                     }
                     current_audio.impl.PlayDevice(device);
                     current_audio.impl.WaitDevice(device);
@@ -804,19 +1247,27 @@ SDL_CaptureAudio(void *devicep)
                 }
 
                 /* !!! FIXME: this should be LockDevice. */
-                SDL_LockMutex(device->mixer_lock);
+                if (!device->ring) {
+                    SDL_LockMutex(device->mixer_lock);
+                }
                 if (!SDL_AtomicGet(&device->paused)) {
                     callback(udata, device->work_buffer, device->callbackspec.size);
                 }
-                SDL_UnlockMutex(device->mixer_lock);
+                if (!device->ring) {
+                    SDL_UnlockMutex(device->mixer_lock);
+                }
             }
         } else {  /* feeding user callback directly without streaming. */
             /* !!! FIXME: this should be LockDevice. */
-            SDL_LockMutex(device->mixer_lock);
+            if (!device->ring) {
+                SDL_LockMutex(device->mixer_lock);
+            }
             if (!SDL_AtomicGet(&device->paused)) {
                 callback(udata, data, device->callbackspec.size);
             }
-            SDL_UnlockMutex(device->mixer_lock);
+            if (!device->ring) {
+                SDL_UnlockMutex(device->mixer_lock);
+            }
         }
     }
 
@@ -928,6 +1379,8 @@ SDL_AudioInit(const char *driver_name)
     /* Make sure we have a list of devices available at startup. */
     current_audio.impl.DetectDevices();
 
+    SDL_AudioResamplerQuality = GetResamplerQualityHint();
+
 #ifdef HAVE_LIBSAMPLERATE_H
     LoadLibSampleRate();
 #endif
@@ -1071,6 +1524,7 @@ close_audio_device(SDL_AudioDevice * device)
     }
 
     SDL_FreeDataQueue(device->buffer_queue);
+    SDL_FreeAudioRing(device->ring);
 
     SDL_free(device);
 }
@@ -1141,7 +1595,7 @@ prepare_audiospec(const SDL_AudioSpec * orig, SDL_AudioSpec * prepared)
 static SDL_AudioDeviceID
 open_audio_device(const char *devname, int iscapture,
                   const SDL_AudioSpec * desired, SDL_AudioSpec * obtained,
-                  int allowed_changes, int min_id)
+                  int allowed_changes, int min_id, SDL_bool use_ring, Uint32 ring_size)
 {
     const SDL_bool is_internal_thread = (desired->callback == NULL);
     SDL_AudioDeviceID id = 0;
@@ -1336,9 +1790,29 @@ open_audio_device(const char *devname, int iscapture,
         }
     }
 
-    if (device->spec.callback == NULL) {  /* use buffer queueing? */
+    if (use_ring) {
+        /* Big enough that the app can always write one buffer while the
+           device plays another. SDL_NewAudioRing() rounds it up to a power of two. */
+        if (ring_size == 0) {
+            ring_size = obtained->size * 4;
+        } else if (ring_size > 0x40000000) {
+            close_audio_device(device);
+            SDL_SetError("Audio ring buffer too large");
+            return 0;
+        }
+        device->ring = SDL_NewAudioRing(SDL_max(ring_size, obtained->size * 2));
+        if (!device->ring) {
+            close_audio_device(device);
+            return 0;
+        }
+        device->ring->stalled = iscapture ? SDL_FALSE : SDL_TRUE;  /* nothing to underrun yet. */
+        device->callbackspec.callback = iscapture ? SDL_BufferQueueFillCallback : SDL_BufferQueueDrainCallback;
+        device->callbackspec.userdata = device;
+    } else if (device->spec.callback == NULL) {  /* use buffer queueing? */
         /* pool a few packets to start. Enough for two callbacks. */
-        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
+        device->buffer_queue_lockfree = SDL_GetHintBoolean(SDL_HINT_AUDIO_QUEUE_LOCKFREE, SDL_FALSE);
+        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2,
+                                                device->buffer_queue_lockfree ? SDL_DATAQUEUE_SPSC : 0);
         if (!device->buffer_queue) {
             close_audio_device(device);
             SDL_SetError("Couldn't create audio buffer queue");
@@ -1406,9 +1880,9 @@ SDL_OpenAudio(SDL_AudioSpec * desired, SDL_AudioSpec * obtained)
 
     if (obtained) {
         id = open_audio_device(NULL, 0, desired, obtained,
-                               SDL_AUDIO_ALLOW_ANY_CHANGE, 1);
+                               SDL_AUDIO_ALLOW_ANY_CHANGE, 1, SDL_FALSE, 0);
     } else {
-        id = open_audio_device(NULL, 0, desired, NULL, 0, 1);
+        id = open_audio_device(NULL, 0, desired, NULL, 0, 1, SDL_FALSE, 0);
     }
 
     SDL_assert((id == 0) || (id == 1));
@@ -1421,7 +1895,44 @@ SDL_OpenAudioDevice(const char *device, int iscapture,
                     int allowed_changes)
 {
     return open_audio_device(device, iscapture, desired, obtained,
-                             allowed_changes, 2);
+                             allowed_changes, 2, SDL_FALSE, 0);
+}
+
+SDL_AudioDeviceID
+SDL_OpenAudioDeviceRing(const char *device, int iscapture,
+                        const SDL_AudioSpec * desired, SDL_AudioSpec * obtained,
+                        int allowed_changes, Uint32 ring_size)
+{
+    if (!desired) {
+        SDL_InvalidParamError("desired");
+        return 0;
+    } else if (desired->callback) {
+        SDL_SetError("Ring buffered audio devices can't have a callback");
+        return 0;
+    }
+
+    return open_audio_device(device, iscapture, desired, obtained,
+                             allowed_changes, 2, SDL_TRUE, ring_size);
+}
+
+int
+SDL_GetAudioRingStatus(SDL_AudioDeviceID devid, SDL_AudioRingStatus *status)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (!device->ring) {
+        return SDL_SetError("Audio device doesn't have a ring buffer");
+    } else if (!status) {
+        return SDL_InvalidParamError("status");
+    }
+
+    status->size = device->ring->size;
+    status->queued = SDL_CountAudioRing(device->ring);
+    status->underruns = (Uint32) SDL_AtomicGet(&device->ring->underruns);
+    status->overruns = (Uint32) SDL_AtomicGet(&device->ring->overruns);
+    return 0;
 }
 
 SDL_AudioStatus
@@ -1440,6 +1951,52 @@ SDL_GetAudioDeviceStatus(SDL_AudioDeviceID devid)
 }
 
 
+int
+SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    SDL_AudioDeviceStatsData *data;
+
+    if (!device) {
+        return -1;  /* get_audio_device() will have set the error state */
+    } else if (device->iscapture) {
+        return SDL_SetError("Statistics are only kept for playback devices");
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    data = &device->stats;
+    SDL_AtomicLock(&data->lock);
+    stats->callbacks = data->callbacks;
+    stats->min_callback_duration = SDL_AudioCounterToNS(data->min_callback);
+    stats->avg_callback_duration = data->callbacks ? SDL_AudioCounterToNS(data->total_callback / data->callbacks) : 0;
+    stats->max_callback_duration = SDL_AudioCounterToNS(data->max_callback);
+    stats->underruns = data->underruns;
+    stats->silence_frames = data->silence_frames;
+    SDL_AtomicUnlock(&data->lock);
+
+    stats->buffer_period = (((Uint64) device->callbackspec.samples) * NS_PER_SECOND) / device->callbackspec.freq;
+    stats->queued_bytes = SDL_GetQueuedAudioSize(devid);
+    return 0;
+}
+
+void
+SDL_ResetAudioDeviceStats(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (device) {
+        SDL_AtomicLock(&device->stats.lock);
+        device->stats.callbacks = 0;
+        device->stats.min_callback = 0;
+        device->stats.max_callback = 0;
+        device->stats.total_callback = 0;
+        device->stats.underruns = 0;
+        device->stats.silence_frames = 0;
+        SDL_AtomicUnlock(&device->stats.lock);
+    }
+}
+
 SDL_AudioStatus
 SDL_GetAudioStatus(void)
 {
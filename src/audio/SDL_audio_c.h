@@ -36,6 +36,18 @@
 
 /* Functions and variables exported from SDL_audio.c for SDL_sysaudio.c */
 
+/* Resampler quality picked with SDL_HINT_AUDIO_RESAMPLING_MODE when the
+   audio subsystem was initialized. */
+typedef enum
+{
+    SDL_RESAMPLER_DEFAULT,  /* SDL's simple, fast resampler. */
+    SDL_RESAMPLER_FAST,
+    SDL_RESAMPLER_MEDIUM,
+    SDL_RESAMPLER_BEST
+} SDL_ResamplerQuality;
+
+extern SDL_ResamplerQuality SDL_AudioResamplerQuality;
+
 #ifdef HAVE_LIBSAMPLERATE_H
 #include "samplerate.h"
 extern SDL_bool SRC_available;
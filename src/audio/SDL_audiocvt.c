@@ -29,6 +29,15 @@
 #include "SDL_assert.h"
 #include "../SDL_dataqueue.h"
 #include "SDL_cpuinfo.h"
+#include "../cpuinfo/SDL_simd.h"
+
+#ifdef __SSE__
+#define HAVE_SSE_INTRINSICS 1
+#endif
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
 
 #ifdef __SSE3__
 #define HAVE_SSE3_INTRINSICS 1
@@ -92,6 +101,48 @@ SDL_ConvertStereoToMono(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 }
 
 
+#if HAVE_SSE2_INTRINSICS
+/* Convert from 5.1 to stereo. Average left and right, discard subwoofer. */
+static void SDLCALL
+SDL_Convert51ToStereo_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    float *dst = (float *) cvt->buf;
+    const float *src = dst;
+    const __m128d divby3 = _mm_set1_pd(3.0);
+    int i = cvt->len_cvt / (sizeof (float) * 6);
+
+    LOG_DEBUG_CONVERT("5.1", "stereo (using SSE2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    /* Two frames at a time, in double precision like the scalar version,
+       so the results are the same. The output never catches up with the
+       input, so unaligned loads and stores are all we need. */
+    while (i >= 2) {   /* 2 * 6 float32 */
+        const __m128 a = _mm_loadu_ps(src);      /* FL0 FR0 FC0 LFE0 */
+        const __m128 b = _mm_loadu_ps(src+4);    /* BL0 BR0 FL1 FR1 */
+        const __m128 c = _mm_loadu_ps(src+8);    /* FC1 LFE1 BL1 BR1 */
+        const __m128d center0 = _mm_cvtps_pd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)));
+        const __m128d center1 = _mm_cvtps_pd(_mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)));
+        const __m128d lr0 = _mm_div_pd(_mm_add_pd(_mm_add_pd(_mm_cvtps_pd(a), center0), _mm_cvtps_pd(b)), divby3);
+        const __m128d lr1 = _mm_div_pd(_mm_add_pd(_mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(b, b)), center1), _mm_cvtps_pd(_mm_movehl_ps(c, c))), divby3);
+        _mm_storeu_ps(dst, _mm_movelh_ps(_mm_cvtpd_ps(lr0), _mm_cvtpd_ps(lr1)));
+        i -= 2; src += 12; dst += 4;
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    if (i) {
+        const double front_center = (double) src[2];
+        dst[0] = (float) ((src[0] + front_center + src[4]) / 3.0);  /* left */
+        dst[1] = (float) ((src[1] + front_center + src[5]) / 3.0);  /* right */
+    }
+
+    cvt->len_cvt /= 3;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+#endif
+
 /* Convert from 5.1 to stereo. Average left and right, discard subwoofer. */
 static void SDLCALL
 SDL_Convert51ToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
@@ -146,6 +197,44 @@ SDL_Convert51ToQuad(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 }
 
 
+#if HAVE_SSE_INTRINSICS
+/* Duplicate a mono channel to both stereo channels */
+static void SDLCALL
+SDL_ConvertMonoToStereo_SSE(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 2);
+    int i = cvt->len_cvt / sizeof (float);
+
+    LOG_DEBUG_CONVERT("mono", "stereo (using SSE)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    /* Work back from the end, since the data grows; do the odd samples at
+       the end first, so the SSE blocks can't overwrite input they need. */
+    while (i & 3) {
+        src--;
+        dst -= 2;
+        dst[0] = dst[1] = *src;
+        i--;
+    }
+
+    while (i) {   /* 4 * float32 */
+        __m128 samples;
+        src -= 4;
+        dst -= 8;
+        samples = _mm_loadu_ps(src);
+        _mm_storeu_ps(dst, _mm_unpacklo_ps(samples, samples));
+        _mm_storeu_ps(dst+4, _mm_unpackhi_ps(samples, samples));
+        i -= 4;
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+#endif
+
 /* Duplicate a mono channel to both stereo channels */
 static void SDLCALL
 SDL_ConvertMonoToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
@@ -170,6 +259,56 @@ SDL_ConvertMonoToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 }
 
 
+#if HAVE_SSE_INTRINSICS
+/* Duplicate a stereo channel to a pseudo-5.1 stream */
+static void SDLCALL
+SDL_ConvertStereoTo51_SSE(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 3);
+    const __m128 divby2 = _mm_set1_ps(0.5f);
+    int i = cvt->len_cvt / 8;
+    float lf, rf, ce;
+
+    LOG_DEBUG_CONVERT("stereo", "5.1 (using SSE)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    /* Work back from the end, the odd frame first; see SDL_ConvertStereoTo51(). */
+    if (i & 1) {
+        dst -= 6;
+        src -= 2;
+        lf = src[0];
+        rf = src[1];
+        ce = (lf + rf) * 0.5f;
+        dst[0] = lf + (lf - ce);  /* FL */
+        dst[1] = rf + (rf - ce);  /* FR */
+        dst[2] = ce;  /* FC */
+        dst[3] = ce;  /* !!! FIXME: wrong! This is the subwoofer. */
+        dst[4] = lf;  /* BL */
+        dst[5] = rf;  /* BR */
+        i--;
+    }
+
+    while (i) {   /* 2 * 2 float32 */
+        __m128 lr, center, front;
+        src -= 4;
+        dst -= 12;
+        lr = _mm_loadu_ps(src);  /* L0 R0 L1 R1 */
+        center = _mm_mul_ps(_mm_add_ps(lr, _mm_shuffle_ps(lr, lr, _MM_SHUFFLE(2, 3, 0, 1))), divby2);
+        front = _mm_add_ps(lr, _mm_sub_ps(lr, center));
+        _mm_storeu_ps(dst, _mm_movelh_ps(front, center));  /* FL0 FR0 FC0 LFE0 */
+        _mm_storeu_ps(dst+4, _mm_shuffle_ps(lr, front, _MM_SHUFFLE(3, 2, 1, 0)));  /* BL0 BR0 FL1 FR1 */
+        _mm_storeu_ps(dst+8, _mm_movehl_ps(lr, center));  /* FC1 LFE1 BL1 BR1 */
+        i -= 2;
+    }
+
+    cvt->len_cvt *= 3;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+#endif
+
 /* Duplicate a stereo channel to a pseudo-5.1 stream */
 static void SDLCALL
 SDL_ConvertStereoTo51(SDL_AudioCVT * cvt, SDL_AudioFormat format)
@@ -364,7 +503,63 @@ SDL_ResampleAudioSimple(const int chans, const double rate_incr,
     return (int) ((dst - outbuf) * ((int) sizeof (float)));
 }
 
-/* We keep one special-case fast path around for an extremely common audio format. */
+/* We keep special-case fast paths around for extremely common audio formats. */
+static int
+SDL_ResampleAudioSimple_si16_c1(const double rate_incr,
+                        Sint16 *last_sample, const Sint16 *inbuf,
+                        const int inbuflen, Sint16 *outbuf, const int outbuflen)
+{
+    const int framelen = 2;  /* mono 16 bit */
+    const int total = (inbuflen / framelen);
+    const int finalpos = total - 1;
+    const int dest_samples = (int)(((double)total) * rate_incr);
+    const double src_incr = 1.0 / rate_incr;
+    Sint16 *dst;
+    double idx;
+
+    SDL_assert((dest_samples * framelen) <= outbuflen);
+    SDL_assert((inbuflen % framelen) == 0);
+
+    if (rate_incr > 1.0) {
+        Sint16 *target = (outbuf + 1);
+        const Sint16 final_sample = inbuf[finalpos];
+        Sint16 earlier_sample = inbuf[finalpos];
+        dst = outbuf + dest_samples;
+        idx = (double) total;
+
+        while (dst > target) {
+            const int pos = (int) idx;
+            const Sint16 val = inbuf[pos - 1];
+            SDL_assert(pos >= 0.0);
+            *(--dst) = (((Sint32) val) + ((Sint32) earlier_sample)) >> 1;
+            earlier_sample = val;
+            idx -= src_incr;
+        }
+
+        /* do last sample, interpolated against previous run's state. */
+        *(--dst) = (((Sint32) inbuf[0]) + ((Sint32) last_sample[0])) >> 1;
+        last_sample[0] = final_sample;
+
+        dst = (outbuf + dest_samples);
+    } else {
+        Sint16 *target = (outbuf + dest_samples);
+        Sint16 last = last_sample[0];
+        dst = outbuf;
+        idx = 0.0;
+        while (dst < target) {
+            const int pos = (int) idx;
+            const Sint16 val = inbuf[pos];
+            SDL_assert(pos <= finalpos);
+            *(dst++) = (((Sint32) val) + ((Sint32) last)) >> 1;
+            last = val;
+            idx += src_incr;
+        }
+        last_sample[0] = last;
+    }
+
+    return (int) ((dst - outbuf) * ((int) sizeof (Sint16)));
+}
+
 static int
 SDL_ResampleAudioSimple_si16_c2(const double rate_incr,
                         Sint16 *last_sample, const Sint16 *inbuf,
@@ -432,6 +627,23 @@ SDL_ResampleAudioSimple_si16_c2(const double rate_incr,
     return (int) ((dst - outbuf) * ((int) sizeof (Sint16)));
 }
 
+static void SDLCALL
+SDL_ResampleCVT_si16_c1(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint16 *src = (const Sint16 *) cvt->buf;
+    const int srclen = cvt->len_cvt;
+    Sint16 *dst = (Sint16 *) cvt->buf;
+    const int dstlen = (cvt->len * cvt->len_mult);
+    Sint16 state = src[0];
+
+    SDL_assert(format == AUDIO_S16SYS);
+
+    cvt->len_cvt = SDL_ResampleAudioSimple_si16_c1(cvt->rate_incr, &state, src, srclen, dst, dstlen);
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, format);
+    }
+}
+
 static void SDLCALL
 SDL_ResampleCVT_si16_c2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
 {
@@ -453,29 +665,6 @@ SDL_ResampleCVT_si16_c2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
 }
 
 
-int
-SDL_ConvertAudio(SDL_AudioCVT * cvt)
-{
-    /* !!! FIXME: (cvt) should be const; stack-copy it here. */
-    /* !!! FIXME: (actually, we can't...len_cvt needs to be updated. Grr.) */
-
-    /* Make sure there's data to convert */
-    if (cvt->buf == NULL) {
-        return SDL_SetError("No buffer allocated for conversion");
-    }
-
-    /* Return okay if no conversion is necessary */
-    cvt->len_cvt = cvt->len;
-    if (cvt->filters[0] == NULL) {
-        return 0;
-    }
-
-    /* Set up the conversion and go! */
-    cvt->filter_index = 0;
-    cvt->filters[0] (cvt, cvt->src_format);
-    return 0;
-}
-
 static void SDLCALL
 SDL_Convert_Byteswap(SDL_AudioCVT *cvt, SDL_AudioFormat format)
 {
@@ -649,6 +838,147 @@ ChooseCVTResampler(const int dst_channels)
     return NULL;
 }
 
+/* Rather than have every filter make a pass over the whole buffer,
+   SDL_ConvertAudio() runs the whole chain over one small block at a time,
+   so the data stays in the cache between filters. Chains that never grow
+   the data work on each block in place; the rest go through a scratch
+   buffer on the stack. The resamplers need to see the whole buffer at once, so they run
+   by themselves, with the filters before and after them blocked separately. */
+#define SDL_AUDIOCVT_BLOCK_SIZE (8 * 1024)
+
+static SDL_bool
+IsCVTResampler(const SDL_AudioFilter filter)
+{
+    return ((filter == SDL_ResampleCVT_c1) || (filter == SDL_ResampleCVT_c2) ||
+            (filter == SDL_ResampleCVT_c4) || (filter == SDL_ResampleCVT_c6) ||
+            (filter == SDL_ResampleCVT_c8) ||
+            (filter == SDL_ResampleCVT_si16_c1) || (filter == SDL_ResampleCVT_si16_c2));
+}
+
+/* Run filters [first, last) over cvt->buf in one go. */
+static void
+SDL_RunCVTFilters(SDL_AudioCVT *cvt, const int first, const int last, const SDL_AudioFormat format)
+{
+    const SDL_AudioFilter stop = cvt->filters[last];
+
+    cvt->filters[last] = NULL;
+    cvt->filter_index = first;
+    cvt->filters[first] (cvt, format);
+    cvt->filters[last] = stop;
+}
+
+/* Run filters [first, last) over cvt->buf a block at a time. */
+static void
+SDL_RunCVTFiltersBlocked(SDL_AudioCVT *cvt, const int first, const int last, const SDL_AudioFormat format)
+{
+    Uint8 scratch[SDL_AUDIOCVT_BLOCK_SIZE + 16];
+    /* align for the SIMD converters' sake. */
+    Uint8 *block = (Uint8 *) ((((size_t) scratch) + 15) & ~((size_t) 15));
+    Uint8 *buf = cvt->buf;
+    const int len = cvt->len_cvt;
+    /* 24 samples is a whole number of frames for any channel count we have
+       converters for, and every filter's output is an exact fraction of its
+       input for that. No filter grows the data more than len_mult does. */
+    const int granule = (SDL_AUDIO_BITSIZE(format) / 8) * 24;
+    const int blocklen = ((SDL_AUDIOCVT_BLOCK_SIZE / cvt->len_mult) / granule) * granule;
+    int outblocklen, outlen, offset;
+
+    if (((last - first) < 2) || (blocklen == 0) || (len <= blocklen)) {
+        SDL_RunCVTFilters(cvt, first, last, format);  /* not worth it. */
+        return;
+    }
+
+    /* Run a granule through first to see how the block size changes. If the
+       data grows, the blocks have to be done from the end, so the output
+       doesn't overwrite input we haven't read yet. */
+    SDL_memcpy(block, buf, granule);
+    cvt->buf = block;
+    cvt->len_cvt = granule;
+    SDL_RunCVTFilters(cvt, first, last, format);
+    outblocklen = (blocklen / granule) * cvt->len_cvt;
+
+    outlen = 0;
+    if (cvt->len_mult == 1) {
+        /* Nothing in the chain grows the data: convert each block where it
+           sits, then pack it down behind the previous one. */
+        for (offset = 0; offset < len; offset += blocklen) {
+            cvt->buf = buf + offset;
+            cvt->len_cvt = SDL_min(blocklen, len - offset);
+            SDL_RunCVTFilters(cvt, first, last, format);
+            if (offset != outlen) {
+                SDL_memmove(buf + outlen, cvt->buf, cvt->len_cvt);
+            }
+            outlen += cvt->len_cvt;
+        }
+    } else if (outblocklen <= blocklen) {
+        for (offset = 0; offset < len; offset += blocklen) {
+            const int inlen = SDL_min(blocklen, len - offset);
+            SDL_memcpy(block, buf + offset, inlen);
+            cvt->len_cvt = inlen;
+            SDL_RunCVTFilters(cvt, first, last, format);
+            SDL_memcpy(buf + outlen, block, cvt->len_cvt);
+            outlen += cvt->len_cvt;
+        }
+    } else {
+        for (offset = ((len - 1) / blocklen) * blocklen; offset >= 0; offset -= blocklen) {
+            const int inlen = SDL_min(blocklen, len - offset);
+            SDL_memcpy(block, buf + offset, inlen);
+            cvt->len_cvt = inlen;
+            SDL_RunCVTFilters(cvt, first, last, format);
+            SDL_memcpy(buf + ((offset / blocklen) * outblocklen), block, cvt->len_cvt);
+            outlen += cvt->len_cvt;
+        }
+    }
+
+    cvt->buf = buf;
+    cvt->len_cvt = outlen;
+}
+
+int
+SDL_ConvertAudio(SDL_AudioCVT * cvt)
+{
+    SDL_AudioFormat format;
+    int resampler, count;
+
+    /* !!! FIXME: (cvt) should be const; stack-copy it here. */
+    /* !!! FIXME: (actually, we can't...len_cvt needs to be updated. Grr.) */
+
+    /* Make sure there's data to convert */
+    if (cvt->buf == NULL) {
+        return SDL_SetError("No buffer allocated for conversion");
+    }
+
+    /* Return okay if no conversion is necessary */
+    cvt->len_cvt = cvt->len;
+    if (cvt->filters[0] == NULL) {
+        return 0;
+    }
+
+    resampler = -1;
+    for (count = 0; (count < SDL_arraysize(cvt->filters) - 1) && cvt->filters[count]; count++) {
+        if (IsCVTResampler(cvt->filters[count])) {
+            resampler = count;
+        }
+    }
+
+    /* Set up the conversion and go! */
+    if (resampler < 0) {
+        SDL_RunCVTFiltersBlocked(cvt, 0, count, cvt->src_format);
+    } else {
+        /* Everything but the int16 resamplers works in float. */
+        format = (resampler == 0) ? cvt->src_format : AUDIO_F32SYS;
+        if (resampler > 0) {
+            SDL_RunCVTFiltersBlocked(cvt, 0, resampler, cvt->src_format);
+        }
+        SDL_RunCVTFilters(cvt, resampler, resampler + 1, format);
+        if ((resampler + 1) < count) {
+            SDL_RunCVTFiltersBlocked(cvt, resampler + 1, count, format);
+        }
+    }
+
+    return 0;
+}
+
 static int
 SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
                           const int src_rate, const int dst_rate)
@@ -730,16 +1060,16 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
        everything else to be a degenerate case that we might have to make
        multiple passes over the data to convert to and from float32 as
        necessary. That being said, we keep one special case around for
-       efficiency: stereo data in Sint16 format, in the native byte order,
-       that only needs resampling. This is likely to be the most popular
+       efficiency: mono or stereo data in Sint16 format, in the native byte
+       order, that only needs resampling. This is likely to be the most popular
        legacy format, that apps, hardware and the OS are likely to be able
        to process directly, so we handle this one case directly without
        unnecessary conversions. This means that apps on embedded devices
        without floating point hardware should consider aiming for this
        format as well. */
-    if ((src_channels == 2) && (dst_channels == 2) && (src_fmt == AUDIO_S16SYS) && (dst_fmt == AUDIO_S16SYS) && (src_rate != dst_rate)) {
+    if ((src_channels <= 2) && (src_channels == dst_channels) && (src_fmt == AUDIO_S16SYS) && (dst_fmt == AUDIO_S16SYS) && (src_rate != dst_rate)) {
         cvt->needed = 1;
-        cvt->filters[cvt->filter_index++] = SDL_ResampleCVT_si16_c2;
+        cvt->filters[cvt->filter_index++] = (src_channels == 1) ? SDL_ResampleCVT_si16_c1 : SDL_ResampleCVT_si16_c2;
         if (src_rate < dst_rate) {
             const double mult = ((double) dst_rate) / ((double) src_rate);
             cvt->len_mult *= (int) SDL_ceil(mult);
@@ -785,14 +1115,30 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
 
     /* Channel conversion */
     if (src_channels != dst_channels) {
+        SDL_AudioFilter mono_to_stereo = SDL_ConvertMonoToStereo;
+        SDL_AudioFilter stereo_to_51 = SDL_ConvertStereoTo51;
+        SDL_AudioFilter from_51_to_stereo = SDL_Convert51ToStereo;
+
+        #if HAVE_SSE_INTRINSICS
+        if (SDL_HasSSE()) {
+            mono_to_stereo = SDL_ConvertMonoToStereo_SSE;
+            stereo_to_51 = SDL_ConvertStereoTo51_SSE;
+        }
+        #endif
+        #if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            from_51_to_stereo = SDL_Convert51ToStereo_SSE2;
+        }
+        #endif
+
         if ((src_channels == 1) && (dst_channels > 1)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertMonoToStereo;
+            cvt->filters[cvt->filter_index++] = mono_to_stereo;
             cvt->len_mult *= 2;
             src_channels = 2;
             cvt->len_ratio *= 2;
         }
         if ((src_channels == 2) && (dst_channels == 6)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertStereoTo51;
+            cvt->filters[cvt->filter_index++] = stereo_to_51;
             src_channels = 6;
             cvt->len_mult *= 3;
             cvt->len_ratio *= 3;
@@ -804,13 +1150,13 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
             cvt->len_ratio *= 2;
         }
         while ((src_channels * 2) <= dst_channels) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertMonoToStereo;
+            cvt->filters[cvt->filter_index++] = mono_to_stereo;
             cvt->len_mult *= 2;
             src_channels *= 2;
             cvt->len_ratio *= 2;
         }
         if ((src_channels == 6) && (dst_channels <= 2)) {
-            cvt->filters[cvt->filter_index++] = SDL_Convert51ToStereo;
+            cvt->filters[cvt->filter_index++] = from_51_to_stereo;
             src_channels = 2;
             cvt->len_ratio /= 3;
         }
@@ -1032,6 +1378,21 @@ SDL_ResampleAudioStream(SDL_AudioStream *stream, const void *_inbuf, const int i
     return SDL_ResampleAudioSimple(chans, stream->rate_incr, state->resampler_state.f, inbuf, inbuflen, outbuf, outbuflen);
 }
 
+static int
+SDL_ResampleAudioStream_si16_c1(SDL_AudioStream *stream, const void *_inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
+{
+    const Sint16 *inbuf = (const Sint16 *) _inbuf;
+    Sint16 *outbuf = (Sint16 *) _outbuf;
+    SDL_AudioStreamResamplerState *state = (SDL_AudioStreamResamplerState*)stream->resampler_state;
+
+    if (!state->resampler_seeded) {
+        state->resampler_state.si16[0] = inbuf[0];
+        state->resampler_seeded = SDL_TRUE;
+    }
+
+    return SDL_ResampleAudioSimple_si16_c1(stream->rate_incr, state->resampler_state.si16, inbuf, inbuflen, outbuf, outbuflen);
+}
+
 static int
 SDL_ResampleAudioStream_si16_c2(SDL_AudioStream *stream, const void *_inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
 {
@@ -1063,6 +1424,610 @@ SDL_CleanupAudioStreamResampler(SDL_AudioStream *stream)
     SDL_free(stream->resampler_state);
 }
 
+/* Windowed-sinc polyphase resampler.
+
+   Each output frame is the dot product of (taps) input frames around it
+   with one row ("phase") of a table of Kaiser-windowed sinc coefficients.
+   If the rates reduce to a ratio with a small enough numerator, there is a
+   row for every place an output frame can fall between two input frames,
+   so no interpolation is needed; otherwise the table has
+   RESAMPLER_MAX_PHASES rows and we interpolate between the nearest two. */
+
+#define RESAMPLER_MAX_PHASES 512
+#define RESAMPLER_MAX_TAPS 512
+
+typedef struct
+{
+    int taps;       /* filter length when upsampling, a multiple of 8. */
+    double cutoff;  /* passband edge, as a fraction of the lower Nyquist frequency. */
+    double beta;    /* Kaiser window shape: higher means more stopband attenuation. */
+} SDL_ResamplerPreset;
+
+/* indexed by SDL_ResamplerQuality - 1. */
+static const SDL_ResamplerPreset resampler_presets[] = {
+    { 16, 0.80, 6.0 },
+    { 32, 0.90, 8.0 },
+    { 64, 0.95, 10.0 }
+};
+
+/* Multiply (taps) interleaved frames of (chans) channels at (src) by
+   (coeffs) and sum them into one frame at (dst). (taps) is a multiple of 8. */
+typedef void (*SDL_ResampleKernel)(const float *src, const float *coeffs, const int taps, const int chans, float *dst);
+
+typedef struct
+{
+    SDL_ResampleKernel kernel;
+    float *coeffs;        /* (num_phases + 1) rows of (taps) coefficients. */
+    int taps;
+    int chans;
+    Uint32 num_phases;
+    Uint32 in_rate;       /* src_rate / gcd(src_rate, dst_rate) */
+    Uint32 out_rate;      /* dst_rate / gcd(src_rate, dst_rate) */
+    float *buffer;        /* input frames we still need, then new input. */
+    int buffer_frames;
+    int buffer_capacity;  /* in frames. */
+    int pos;              /* frame in (buffer) the next output frame is at... */
+    Uint32 frac;          /* ...plus this many (1 / out_rate) frames. */
+    float *scratch;       /* one frame, for interpolating between phases. */
+} SDL_PolyphaseResamplerState;
+
+static void
+SDL_ResampleKernel_Scalar(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    int i, j;
+
+    for (j = 0; j < chans; j++) {
+        dst[j] = 0.0f;
+    }
+    for (i = 0; i < taps; i++) {
+        const float c = coeffs[i];
+        for (j = 0; j < chans; j++) {
+            dst[j] += src[j] * c;
+        }
+        src += chans;
+    }
+}
+
+#if HAVE_SSE_INTRINSICS
+static void
+SDL_ResampleKernel_c1_SSE(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    int i;
+
+    for (i = 0; i < taps; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(coeffs + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(src + i + 4), _mm_loadu_ps(coeffs + i + 4)));
+    }
+    acc0 = _mm_add_ps(acc0, acc1);
+    acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+    acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1, 1, 1, 1)));
+    _mm_store_ss(dst, acc0);
+}
+
+static void
+SDL_ResampleKernel_c2_SSE(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    int i;
+
+    for (i = 0; i < taps; i += 4) {
+        const __m128 c = _mm_loadu_ps(coeffs + i);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src), _mm_unpacklo_ps(c, c)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(src + 4), _mm_unpackhi_ps(c, c)));
+        src += 8;
+    }
+    acc0 = _mm_add_ps(acc0, acc1);
+    acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+    _mm_storel_pi((__m64 *) dst, acc0);
+}
+
+static void
+SDL_ResampleKernel_c4_SSE(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    int i;
+
+    for (i = 0; i < taps; i += 2) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src), _mm_set1_ps(coeffs[i])));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(src + 4), _mm_set1_ps(coeffs[i + 1])));
+        src += 8;
+    }
+    _mm_storeu_ps(dst, _mm_add_ps(acc0, acc1));
+}
+
+static void
+SDL_ResampleKernel_c6_SSE(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    /* two frames at a time are three whole vectors. */
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    float sums[12];
+    int i;
+
+    for (i = 0; i < taps; i += 2) {
+        const __m128 c0 = _mm_set1_ps(coeffs[i]);
+        const __m128 c1 = _mm_set1_ps(coeffs[i + 1]);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src), c0));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(src + 4), _mm_shuffle_ps(c0, c1, _MM_SHUFFLE(0, 0, 0, 0))));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(src + 8), c1));
+        src += 12;
+    }
+    _mm_storeu_ps(sums, acc0);
+    _mm_storeu_ps(sums + 4, acc1);
+    _mm_storeu_ps(sums + 8, acc2);
+    for (i = 0; i < 6; i++) {
+        dst[i] = sums[i] + sums[i + 6];
+    }
+}
+
+static void
+SDL_ResampleKernel_c8_SSE(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    int i;
+
+    for (i = 0; i < taps; i++) {
+        const __m128 c = _mm_set1_ps(coeffs[i]);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src), c));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(src + 4), c));
+        src += 8;
+    }
+    _mm_storeu_ps(dst, acc0);
+    _mm_storeu_ps(dst + 4, acc1);
+}
+#endif
+
+#if HAVE_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static void
+SDL_ResampleKernel_c1_AVX2(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    __m256 acc = _mm256_setzero_ps();
+    __m128 sum;
+    int i;
+
+    for (i = 0; i < taps; i += 8) {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(coeffs + i)));
+    }
+    sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+    _mm_store_ss(dst, sum);
+}
+
+SDL_TARGETING("avx2") static void
+SDL_ResampleKernel_c2_AVX2(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    const __m256i lo = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i hi = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m128 sum;
+    int i;
+
+    for (i = 0; i < taps; i += 8) {
+        const __m256 c = _mm256_loadu_ps(coeffs + i);
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_permutevar8x32_ps(c, lo)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(src + 8), _mm256_permutevar8x32_ps(c, hi)));
+        src += 16;
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    sum = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    _mm_storel_pi((__m64 *) dst, sum);
+}
+
+SDL_TARGETING("avx2") static void
+SDL_ResampleKernel_c4_AVX2(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    const __m256i lo = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m256i hi = _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3);
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    int i;
+
+    for (i = 0; i < taps; i += 4) {
+        const __m256 c = _mm256_castps128_ps256(_mm_loadu_ps(coeffs + i));
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_permutevar8x32_ps(c, lo)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(src + 8), _mm256_permutevar8x32_ps(c, hi)));
+        src += 16;
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    _mm_storeu_ps(dst, _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1)));
+}
+
+SDL_TARGETING("avx2") static void
+SDL_ResampleKernel_c6_AVX2(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    /* four frames at a time are three whole vectors. */
+    const __m256i idx0 = _mm256_setr_epi32(0, 0, 0, 0, 0, 0, 1, 1);
+    const __m256i idx1 = _mm256_setr_epi32(1, 1, 1, 1, 2, 2, 2, 2);
+    const __m256i idx2 = _mm256_setr_epi32(2, 2, 3, 3, 3, 3, 3, 3);
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    float sums[24];
+    int i;
+
+    for (i = 0; i < taps; i += 4) {
+        const __m256 c = _mm256_castps128_ps256(_mm_loadu_ps(coeffs + i));
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_permutevar8x32_ps(c, idx0)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(src + 8), _mm256_permutevar8x32_ps(c, idx1)));
+        acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(_mm256_loadu_ps(src + 16), _mm256_permutevar8x32_ps(c, idx2)));
+        src += 24;
+    }
+    _mm256_storeu_ps(sums, acc0);
+    _mm256_storeu_ps(sums + 8, acc1);
+    _mm256_storeu_ps(sums + 16, acc2);
+    for (i = 0; i < 6; i++) {
+        dst[i] = (sums[i] + sums[i + 6]) + (sums[i + 12] + sums[i + 18]);
+    }
+}
+
+SDL_TARGETING("avx2") static void
+SDL_ResampleKernel_c8_AVX2(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    int i;
+
+    for (i = 0; i < taps; i += 2) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_broadcast_ss(coeffs + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(src + 8), _mm256_broadcast_ss(coeffs + i + 1)));
+        src += 16;
+    }
+    _mm256_storeu_ps(dst, _mm256_add_ps(acc0, acc1));
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void
+SDL_ResampleKernel_c1_NEON(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    float32x2_t sum;
+    int i;
+
+    for (i = 0; i < taps; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(src + i), vld1q_f32(coeffs + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(src + i + 4), vld1q_f32(coeffs + i + 4));
+    }
+    acc0 = vaddq_f32(acc0, acc1);
+    sum = vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0));
+    sum = vpadd_f32(sum, sum);
+    vst1_lane_f32(dst, sum, 0);
+}
+
+static void
+SDL_ResampleKernel_c2_NEON(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int i;
+
+    for (i = 0; i < taps; i += 4) {
+        const float32x4_t c = vld1q_f32(coeffs + i);
+        const float32x4x2_t cc = vzipq_f32(c, c);
+        acc0 = vmlaq_f32(acc0, vld1q_f32(src), cc.val[0]);
+        acc1 = vmlaq_f32(acc1, vld1q_f32(src + 4), cc.val[1]);
+        src += 8;
+    }
+    acc0 = vaddq_f32(acc0, acc1);
+    vst1_f32(dst, vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0)));
+}
+
+static void
+SDL_ResampleKernel_c4_NEON(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int i;
+
+    for (i = 0; i < taps; i += 2) {
+        acc0 = vmlaq_n_f32(acc0, vld1q_f32(src), coeffs[i]);
+        acc1 = vmlaq_n_f32(acc1, vld1q_f32(src + 4), coeffs[i + 1]);
+        src += 8;
+    }
+    vst1q_f32(dst, vaddq_f32(acc0, acc1));
+}
+
+static void
+SDL_ResampleKernel_c6_NEON(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x2_t acc1 = vdup_n_f32(0.0f);
+    int i;
+
+    for (i = 0; i < taps; i++) {
+        acc0 = vmlaq_n_f32(acc0, vld1q_f32(src), coeffs[i]);
+        acc1 = vmla_n_f32(acc1, vld1_f32(src + 4), coeffs[i]);
+        src += 6;
+    }
+    vst1q_f32(dst, acc0);
+    vst1_f32(dst + 4, acc1);
+}
+
+static void
+SDL_ResampleKernel_c8_NEON(const float *src, const float *coeffs, const int taps, const int chans, float *dst)
+{
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int i;
+
+    for (i = 0; i < taps; i++) {
+        acc0 = vmlaq_n_f32(acc0, vld1q_f32(src), coeffs[i]);
+        acc1 = vmlaq_n_f32(acc1, vld1q_f32(src + 4), coeffs[i]);
+        src += 8;
+    }
+    vst1q_f32(dst, acc0);
+    vst1q_f32(dst + 4, acc1);
+}
+#endif
+
+static SDL_ResampleKernel
+ChooseResampleKernel(const int chans)
+{
+#if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        switch (chans) {
+        case 1: return SDL_ResampleKernel_c1_AVX2;
+        case 2: return SDL_ResampleKernel_c2_AVX2;
+        case 4: return SDL_ResampleKernel_c4_AVX2;
+        case 6: return SDL_ResampleKernel_c6_AVX2;
+        case 8: return SDL_ResampleKernel_c8_AVX2;
+        default: break;
+        }
+    }
+#endif
+#if HAVE_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        switch (chans) {
+        case 1: return SDL_ResampleKernel_c1_SSE;
+        case 2: return SDL_ResampleKernel_c2_SSE;
+        case 4: return SDL_ResampleKernel_c4_SSE;
+        case 6: return SDL_ResampleKernel_c6_SSE;
+        case 8: return SDL_ResampleKernel_c8_SSE;
+        default: break;
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        switch (chans) {
+        case 1: return SDL_ResampleKernel_c1_NEON;
+        case 2: return SDL_ResampleKernel_c2_NEON;
+        case 4: return SDL_ResampleKernel_c4_NEON;
+        case 6: return SDL_ResampleKernel_c6_NEON;
+        case 8: return SDL_ResampleKernel_c8_NEON;
+        default: break;
+        }
+    }
+#endif
+    return SDL_ResampleKernel_Scalar;
+}
+
+static double
+ResamplerBesselI0(const double x)
+{
+    /* power series; converges quickly for the window shapes we use. */
+    const double xx = (x * x) * 0.25;
+    double sum = 1.0;
+    double term = 1.0;
+    int k;
+
+    for (k = 1; k < 100; k++) {
+        term *= xx / ((double) k * (double) k);
+        sum += term;
+        if (term < (sum * 1e-12)) {
+            break;
+        }
+    }
+    return sum;
+}
+
+static void
+BuildResamplerTable(float *coeffs, const int taps, const Uint32 num_phases, const double cutoff, const double beta)
+{
+    const double half = (double) (taps / 2);
+    const double i0beta = ResamplerBesselI0(beta);
+    Uint32 phase;
+    int i;
+
+    /* row (phase) is for an output frame (phase / num_phases) of the way
+       from input frame (taps / 2 - 1) to the one after it. */
+    for (phase = 0; phase <= num_phases; phase++) {
+        const double offset = ((double) phase) / ((double) num_phases);
+        float *row = coeffs + (phase * taps);
+        double sum = 0.0;
+
+        for (i = 0; i < taps; i++) {
+            const double x = ((double) (i + 1) - half) - offset;
+            const double r = x / half;
+            double value;
+
+            if (SDL_fabs(x) < 1e-9) {
+                value = cutoff;
+            } else {
+                value = SDL_sin(M_PI * cutoff * x) / (M_PI * x);
+            }
+
+            if ((r <= -1.0) || (r >= 1.0)) {
+                value = 0.0;
+            } else {
+                value *= ResamplerBesselI0(beta * SDL_sqrt(1.0 - (r * r))) / i0beta;
+            }
+
+            row[i] = (float) value;
+            sum += value;
+        }
+
+        /* normalize so a constant signal comes out at the same level. */
+        for (i = 0; i < taps; i++) {
+            row[i] = (float) (row[i] / sum);
+        }
+    }
+}
+
+static int
+SDL_ResampleAudioStream_Polyphase(SDL_AudioStream *stream, const void *inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
+{
+    SDL_PolyphaseResamplerState *state = (SDL_PolyphaseResamplerState *) stream->resampler_state;
+    const int chans = state->chans;
+    const int framelen = chans * (int) sizeof (float);
+    const int half = state->taps / 2;
+    const int maxframes = outbuflen / framelen;
+    float *dst = (float *) _outbuf;
+    int total = state->buffer_frames + (inbuflen / framelen);
+    int outframes = 0;
+    int start, i;
+
+    SDL_assert((inbuflen % framelen) == 0);
+
+    if (total > state->buffer_capacity) {
+        float *ptr = (float *) SDL_realloc(state->buffer, total * framelen);
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return 0;
+        }
+        state->buffer = ptr;
+        state->buffer_capacity = total;
+    }
+
+    /* Copy the input first, so it's fine if (inbuf) and (outbuf) overlap. */
+    SDL_memcpy(state->buffer + (state->buffer_frames * chans), inbuf, inbuflen);
+
+    while ((outframes < maxframes) && ((state->pos + half) < total)) {
+        const float *src = state->buffer + ((state->pos - half + 1) * chans);
+        const Uint64 idx = ((Uint64) state->frac) * state->num_phases;
+        const Uint32 phase = (Uint32) (idx / state->out_rate);
+        const Uint32 rem = (Uint32) (idx % state->out_rate);
+        const float *coeffs = state->coeffs + (phase * state->taps);
+
+        state->kernel(src, coeffs, state->taps, chans, dst);
+        if (rem) {
+            const float weight = ((float) rem) / ((float) state->out_rate);
+            state->kernel(src, coeffs + state->taps, state->taps, chans, state->scratch);
+            for (i = 0; i < chans; i++) {
+                dst[i] += (state->scratch[i] - dst[i]) * weight;
+            }
+        }
+
+        dst += chans;
+        outframes++;
+        state->frac += state->in_rate;
+        state->pos += (int) (state->frac / state->out_rate);
+        state->frac %= state->out_rate;
+    }
+
+    /* Keep what the next output frames still need. */
+    start = SDL_min(state->pos - half + 1, total);
+    if (start > 0) {
+        SDL_memmove(state->buffer, state->buffer + (start * chans), (total - start) * framelen);
+        state->pos -= start;
+        total -= start;
+    }
+    state->buffer_frames = total;
+
+    return outframes * framelen;
+}
+
+static void
+SDL_ResetAudioStreamResampler_Polyphase(SDL_AudioStream *stream)
+{
+    /* Start out with silence before the first input frame. */
+    SDL_PolyphaseResamplerState *state = (SDL_PolyphaseResamplerState *) stream->resampler_state;
+    state->buffer_frames = (state->taps / 2) - 1;
+    state->pos = state->buffer_frames;
+    state->frac = 0;
+    SDL_memset(state->buffer, '\0', state->buffer_frames * state->chans * sizeof (float));
+}
+
+static void
+SDL_CleanupAudioStreamResampler_Polyphase(SDL_AudioStream *stream)
+{
+    SDL_PolyphaseResamplerState *state = (SDL_PolyphaseResamplerState *) stream->resampler_state;
+    if (state) {
+        SDL_free(state->coeffs);
+        SDL_free(state->buffer);
+        SDL_free(state->scratch);
+        SDL_free(state);
+    }
+
+    stream->resampler_state = NULL;
+    stream->resampler_func = NULL;
+    stream->reset_resampler_func = NULL;
+    stream->cleanup_resampler_func = NULL;
+}
+
+static SDL_bool
+SetupPolyphaseResampling(SDL_AudioStream *stream, const SDL_ResamplerQuality quality)
+{
+    const SDL_ResamplerPreset *preset = &resampler_presets[quality - 1];
+    const int chans = (int) stream->pre_resample_channels;
+    Uint32 in_rate = (Uint32) stream->src_rate;
+    Uint32 out_rate = (Uint32) stream->dst_rate;
+    Uint32 a = in_rate, b = out_rate;
+    double cutoff = preset->cutoff;
+    double taps = (double) preset->taps;
+    SDL_PolyphaseResamplerState *state;
+
+    SDL_assert((quality > SDL_RESAMPLER_DEFAULT) && (quality <= SDL_arraysize(resampler_presets)));
+
+    while (b) {
+        const Uint32 r = a % b;
+        a = b;
+        b = r;
+    }
+    in_rate /= a;
+    out_rate /= a;
+
+    /* When downsampling, filter below the output's Nyquist frequency, and
+       widen the filter to keep the same transition band. */
+    if (stream->rate_incr < 1.0) {
+        cutoff *= stream->rate_incr;
+        taps /= stream->rate_incr;
+    }
+
+    state = (SDL_PolyphaseResamplerState *) SDL_calloc(1, sizeof (*state));
+    if (!state) {
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+
+    state->chans = chans;
+    state->taps = SDL_min(((int) SDL_ceil(taps) + 7) & ~7, RESAMPLER_MAX_TAPS);
+    state->in_rate = in_rate;
+    state->out_rate = out_rate;
+    state->num_phases = SDL_min(out_rate, RESAMPLER_MAX_PHASES);
+    state->kernel = ChooseResampleKernel(chans);
+    state->coeffs = (float *) SDL_malloc((state->num_phases + 1) * state->taps * sizeof (float));
+    state->buffer_capacity = state->taps;
+    state->buffer = (float *) SDL_malloc(state->buffer_capacity * chans * sizeof (float));
+    state->scratch = (float *) SDL_malloc(chans * sizeof (float));
+
+    stream->resampler_state = state;
+    stream->resampler_func = SDL_ResampleAudioStream_Polyphase;
+    stream->reset_resampler_func = SDL_ResetAudioStreamResampler_Polyphase;
+    stream->cleanup_resampler_func = SDL_CleanupAudioStreamResampler_Polyphase;
+
+    if (!state->coeffs || !state->buffer || !state->scratch) {
+        SDL_CleanupAudioStreamResampler_Polyphase(stream);
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+
+    BuildResamplerTable(state->coeffs, state->taps, state->num_phases, cutoff, preset->beta);
+    SDL_ResetAudioStreamResampler_Polyphase(stream);
+
+    return SDL_TRUE;
+}
+
 SDL_AudioStream *
 SDL_NewAudioStream(const SDL_AudioFormat src_format,
                    const Uint8 src_channels,
@@ -1074,9 +2039,6 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
     const int packetlen = 4096;  /* !!! FIXME: good enough for now. */
     Uint8 pre_resample_channels;
     SDL_AudioStream *retval;
-#ifndef HAVE_LIBSAMPLERATE_H
-    const SDL_bool SRC_available = SDL_FALSE;
-#endif
 
     retval = (SDL_AudioStream *) SDL_calloc(1, sizeof (SDL_AudioStream));
     if (!retval) {
@@ -1108,18 +2070,29 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
             SDL_FreeAudioStream(retval);
             return NULL;  /* SDL_BuildAudioCVT should have called SDL_SetError. */
         }
-    /* fast path special case for stereo Sint16 data that just needs resampling. */
-    } else if ((!SRC_available) && (src_channels == 2) && (dst_channels == 2) && (src_format == AUDIO_S16SYS) && (dst_format == AUDIO_S16SYS)) {
+    /* fast path special case for mono or stereo Sint16 data that just needs
+       resampling: stay in the integer domain, with at most a byteswap on
+       either side, instead of going through float. */
+    } else if ((SDL_AudioResamplerQuality == SDL_RESAMPLER_DEFAULT) && (src_channels <= 2) && (src_channels == dst_channels) &&
+               ((src_format & ~SDL_AUDIO_MASK_ENDIAN) == AUDIO_S16LSB) && ((dst_format & ~SDL_AUDIO_MASK_ENDIAN) == AUDIO_S16LSB)) {
         SDL_assert(src_rate != dst_rate);
+        if (SDL_BuildAudioCVT(&retval->cvt_before_resampling, src_format, src_channels, src_rate, AUDIO_S16SYS, src_channels, src_rate) < 0) {
+            SDL_FreeAudioStream(retval);
+            return NULL;  /* SDL_BuildAudioCVT should have called SDL_SetError. */
+        }
         retval->resampler_state = SDL_calloc(1, sizeof(SDL_AudioStreamResamplerState));
         if (!retval->resampler_state) {
             SDL_FreeAudioStream(retval);
             SDL_OutOfMemory();
             return NULL;
         }
-        retval->resampler_func = SDL_ResampleAudioStream_si16_c2;
+        retval->resampler_func = (src_channels == 1) ? SDL_ResampleAudioStream_si16_c1 : SDL_ResampleAudioStream_si16_c2;
         retval->reset_resampler_func = SDL_ResetAudioStreamResampler;
         retval->cleanup_resampler_func = SDL_CleanupAudioStreamResampler;
+        if (SDL_BuildAudioCVT(&retval->cvt_after_resampling, AUDIO_S16SYS, dst_channels, dst_rate, dst_format, dst_channels, dst_rate) < 0) {
+            SDL_FreeAudioStream(retval);
+            return NULL;  /* SDL_BuildAudioCVT should have called SDL_SetError. */
+        }
     } else {
         /* Don't resample at first. Just get us to Float32 format. */
         /* !!! FIXME: convert to int32 on devices without hardware float. */
@@ -1128,8 +2101,14 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
             return NULL;  /* SDL_BuildAudioCVT should have called SDL_SetError. */
         }
 
+        if (SDL_AudioResamplerQuality != SDL_RESAMPLER_DEFAULT) {
+            SetupPolyphaseResampling(retval, SDL_AudioResamplerQuality);
+        }
+
 #ifdef HAVE_LIBSAMPLERATE_H
-        SetupLibSampleRateResampling(retval);
+        if (!retval->resampler_func) {
+            SetupLibSampleRateResampling(retval);
+        }
 #endif
 
         if (!retval->resampler_func) {
@@ -1151,7 +2130,7 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
         }
     }
 
-    retval->queue = SDL_NewDataQueue(packetlen, packetlen * 2);
+    retval->queue = SDL_NewDataQueue(packetlen, packetlen * 2, 0);
     if (!retval->queue) {
         SDL_FreeAudioStream(retval);
         return NULL;  /* SDL_NewDataQueue should have called SDL_SetError. */
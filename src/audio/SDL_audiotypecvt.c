@@ -24,9 +24,7 @@
 #include "SDL_audio_c.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_assert.h"
-
-/* !!! FIXME: write NEON code. */
-#define HAVE_NEON_INTRINSICS 0
+#include "../cpuinfo/SDL_simd.h"
 
 #ifdef __SSE2__
 #define HAVE_SSE2_INTRINSICS 1
@@ -446,7 +444,7 @@ SDL_Convert_U16_to_F32_SSE2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
     if ((((size_t) src) & 15) == 0) {
         /* Aligned! Do SSE blocks as long as we have 16 bytes available. */
         const __m128 divby32767 = _mm_set1_ps(DIVBY32767);
-        const __m128 minus1 = _mm_set1_ps(1.0f);
+        const __m128 minus1 = _mm_set1_ps(-1.0f);
         while (i >= 8) {   /* 8 * 16-bit */
             const __m128i ints = _mm_load_si128((__m128i const *) src);  /* get 8 sint16 into an XMM register. */
             /* treat as int32, shift left to clear every other sint16, then back right with zero-extend. Now sint32. */
@@ -540,10 +538,10 @@ SDL_Convert_F32_to_S8_SSE2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
         const __m128 mulby127 = _mm_set1_ps(127.0f);
         __m128i *mmdst = (__m128i *) dst;
         while (i >= 16) {   /* 16 * float32 */
-            const __m128i ints1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src), mulby127));  /* load 4 floats, convert to sint32 */
-            const __m128i ints2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src+4), mulby127));  /* load 4 floats, convert to sint32 */
-            const __m128i ints3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src+8), mulby127));  /* load 4 floats, convert to sint32 */
-            const __m128i ints4 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src+12), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(src), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints2 = _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(src+4), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints3 = _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(src+8), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints4 = _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(src+12), mulby127));  /* load 4 floats, convert to sint32 */
             _mm_store_si128(mmdst, _mm_packs_epi16(_mm_packs_epi32(ints1, ints2), _mm_packs_epi32(ints3, ints4)));  /* pack down, store out. */
             i -= 16; src += 16; mmdst++;
         }
@@ -585,10 +583,10 @@ SDL_Convert_F32_to_U8_SSE2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
         const __m128 mulby127 = _mm_set1_ps(127.0f);
         __m128i *mmdst = (__m128i *) dst;
         while (i >= 16) {   /* 16 * float32 */
-            const __m128i ints1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src), add1), mulby127));  /* load 4 floats, convert to sint32 */
-            const __m128i ints2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src+4), add1), mulby127));  /* load 4 floats, convert to sint32 */
-            const __m128i ints3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src+8), add1), mulby127));  /* load 4 floats, convert to sint32 */
-            const __m128i ints4 = _mm_cvtps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src+12), add1), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src), add1), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints2 = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src+4), add1), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints3 = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src+8), add1), mulby127));  /* load 4 floats, convert to sint32 */
+            const __m128i ints4 = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src+12), add1), mulby127));  /* load 4 floats, convert to sint32 */
             _mm_store_si128(mmdst, _mm_packus_epi16(_mm_packs_epi32(ints1, ints2), _mm_packs_epi32(ints3, ints4)));  /* pack down, store out. */
             i -= 16; src += 16; mmdst++;
         }
@@ -629,8 +627,8 @@ SDL_Convert_F32_to_S16_SSE2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
         const __m128 mulby32767 = _mm_set1_ps(32767.0f);
         __m128i *mmdst = (__m128i *) dst;
         while (i >= 8) {   /* 8 * float32 */
-            const __m128i ints1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src), mulby32767));  /* load 4 floats, convert to sint32 */
-            const __m128i ints2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src+4), mulby32767));  /* load 4 floats, convert to sint32 */
+            const __m128i ints1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(src), mulby32767));  /* load 4 floats, convert to sint32 */
+            const __m128i ints2 = _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(src+4), mulby32767));  /* load 4 floats, convert to sint32 */
             _mm_store_si128(mmdst, _mm_packs_epi32(ints1, ints2));  /* pack to sint16, store out. */
             i -= 8; src += 8; mmdst++;
         }
@@ -668,19 +666,22 @@ SDL_Convert_F32_to_U16_SSE2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
     /* Make sure src is aligned too. */
     if ((((size_t) src) & 15) == 0) {
         /* Aligned! Do SSE blocks as long as we have 16 bytes available. */
-        /* This calculates differently than the scalar path because SSE2 can't
-           pack int32 data down to unsigned int16. _mm_packs_epi32 does signed
-           saturation, so that would corrupt our data. _mm_packus_epi32 exists,
-           but not before SSE 4.1. So we convert from float to sint16, packing
-           that down with legit signed saturation, and then xor the top bit
-           against 1. This results in the correct unsigned 16-bit value, even
-           though it looks like dark magic. */
+        /* SSE2 can't pack int32 data down to unsigned int16. _mm_packs_epi32
+           does signed saturation, so that would corrupt our data.
+           _mm_packus_epi32 exists, but not before SSE 4.1. So we calculate
+           the unsigned value like the scalar path does, subtract 32768 to
+           move it into sint16 range, pack that down with legit signed
+           saturation, and then xor the top bit against 1. This results in
+           the same unsigned 16-bit value, even though it looks like dark
+           magic. */
+        const __m128 add1 = _mm_set1_ps(1.0f);
         const __m128 mulby32767 = _mm_set1_ps(32767.0f);
+        const __m128i bias = _mm_set1_epi32(32768);
         const __m128i topbit = _mm_set1_epi16(-32768);
         __m128i *mmdst = (__m128i *) dst;
         while (i >= 8) {   /* 8 * float32 */
-            const __m128i ints1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src), mulby32767));  /* load 4 floats, convert to sint32 */
-            const __m128i ints2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(src+4), mulby32767));  /* load 4 floats, convert to sint32 */
+            const __m128i ints1 = _mm_sub_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src), add1), mulby32767)), bias);  /* load 4 floats, convert to sint32 */
+            const __m128i ints2 = _mm_sub_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_load_ps(src+4), add1), mulby32767)), bias);  /* load 4 floats, convert to sint32 */
             _mm_store_si128(mmdst, _mm_xor_si128(_mm_packs_epi32(ints1, ints2), topbit));  /* pack to sint16, xor top bit, store out. */
             i -= 8; src += 8; mmdst++;
         }
@@ -725,7 +726,7 @@ SDL_Convert_F32_to_S32_SSE2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
             /* bitshift the whole register over, so _mm_cvtps_pd can read the top floats in the bottom of the vector. */
             const __m128d doubles1 = _mm_mul_pd(_mm_cvtps_pd(_mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(floats), 8))), mulby2147483647);
             const __m128d doubles2 = _mm_mul_pd(_mm_cvtps_pd(floats), mulby2147483647);
-            _mm_store_si128(mmdst, _mm_or_si128(_mm_slli_si128(_mm_cvtpd_epi32(doubles1), 8), _mm_cvtpd_epi32(doubles2)));
+            _mm_store_si128(mmdst, _mm_or_si128(_mm_slli_si128(_mm_cvttpd_epi32(doubles1), 8), _mm_cvttpd_epi32(doubles2)));
             i -= 4; src += 4; mmdst++;
         }
         dst = (Sint32 *) mmdst;
@@ -743,6 +744,575 @@ SDL_Convert_F32_to_S32_SSE2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
 }
 #endif
 
+#if HAVE_AVX2_INTRINSICS
+/* These truncate when converting float to int, like the scalar and SSE2
+   versions, so they give the same results as the scalar code no matter how
+   the buffer is aligned. Unaligned loads and stores are
+   nearly free on anything with AVX2, so there's no alignment dance;
+   converters that grow the data work from the end of the buffer. */
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_S8_to_F32_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint8 *src = (const Sint8 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const __m256 divby127 = _mm256_set1_ps(DIVBY127);
+    int i = cvt->len_cvt;
+
+    LOG_DEBUG_CONVERT("AUDIO_S8", "AUDIO_F32 (using AVX2)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = (((float) src[i]) * DIVBY127);
+    }
+
+    while (i) {
+        i -= 8;
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *) (src + i)))), divby127));
+    }
+
+    cvt->len_cvt *= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_U8_to_F32_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Uint8 *src = (const Uint8 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const __m256 divby127 = _mm256_set1_ps(DIVBY127);
+    const __m256 minus1 = _mm256_set1_ps(-1.0f);
+    int i = cvt->len_cvt;
+
+    LOG_DEBUG_CONVERT("AUDIO_U8", "AUDIO_F32 (using AVX2)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = ((((float) src[i]) * DIVBY127) - 1.0f);
+    }
+
+    while (i) {
+        i -= 8;
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) (src + i)))), divby127), minus1));
+    }
+
+    cvt->len_cvt *= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_S16_to_F32_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint16 *src = (const Sint16 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const __m256 divby32767 = _mm256_set1_ps(DIVBY32767);
+    int i = cvt->len_cvt / sizeof (Sint16);
+
+    LOG_DEBUG_CONVERT("AUDIO_S16", "AUDIO_F32 (using AVX2)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = (((float) src[i]) * DIVBY32767);
+    }
+
+    while (i) {
+        i -= 8;
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (src + i)))), divby32767));
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_U16_to_F32_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Uint16 *src = (const Uint16 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const __m256 divby32767 = _mm256_set1_ps(DIVBY32767);
+    const __m256 minus1 = _mm256_set1_ps(-1.0f);
+    int i = cvt->len_cvt / sizeof (Uint16);
+
+    LOG_DEBUG_CONVERT("AUDIO_U16", "AUDIO_F32 (using AVX2)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = ((((float) src[i]) * DIVBY32767) - 1.0f);
+    }
+
+    while (i) {
+        i -= 8;
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) (src + i)))), divby32767), minus1));
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_S32_to_F32_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint32 *src = (const Sint32 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const __m256d divby2147483647 = _mm256_set1_pd(DIVBY2147483647);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_S32", "AUDIO_F32 (using AVX2)");
+
+    for (i = cvt->len_cvt / sizeof (Sint32); i >= 8; i -= 8, src += 8, dst += 8) {
+        const __m256i ints = _mm256_loadu_si256((const __m256i *) src);
+        const __m128 floats1 = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(ints)), divby2147483647));
+        const __m128 floats2 = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(ints, 1)), divby2147483647));
+        _mm256_storeu_ps(dst, _mm256_insertf128_ps(_mm256_castps128_ps256(floats1), floats2, 1));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (float) (((double) *src) * DIVBY2147483647);
+    }
+
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_F32_to_S8_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Sint8 *dst = (Sint8 *) cvt->buf;
+    const __m256 mulby127 = _mm256_set1_ps(127.0f);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_S8 (using AVX2)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const __m256i ints = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src), mulby127));
+        const __m128i shorts = _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+        _mm_storel_epi64((__m128i *) dst, _mm_packs_epi16(shorts, shorts));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Sint8) (*src * 127.0f);
+    }
+
+    cvt->len_cvt /= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S8);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_F32_to_U8_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Uint8 *dst = (Uint8 *) cvt->buf;
+    const __m256 add1 = _mm256_set1_ps(1.0f);
+    const __m256 mulby127 = _mm256_set1_ps(127.0f);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_U8 (using AVX2)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const __m256i ints = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(src), add1), mulby127));
+        const __m128i shorts = _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+        _mm_storel_epi64((__m128i *) dst, _mm_packus_epi16(shorts, shorts));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Uint8) ((*src + 1.0f) * 127.0f);
+    }
+
+    cvt->len_cvt /= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_U8);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_F32_to_S16_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Sint16 *dst = (Sint16 *) cvt->buf;
+    const __m256 mulby32767 = _mm256_set1_ps(32767.0f);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_S16 (using AVX2)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const __m256i ints = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src), mulby32767));
+        _mm_storeu_si128((__m128i *) dst, _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1)));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Sint16) (*src * 32767.0f);
+    }
+
+    cvt->len_cvt /= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S16SYS);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_F32_to_U16_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Uint16 *dst = (Uint16 *) cvt->buf;
+    const __m256 add1 = _mm256_set1_ps(1.0f);
+    const __m256 mulby32767 = _mm256_set1_ps(32767.0f);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_U16 (using AVX2)");
+
+    /* Unlike SSE2, we have an unsigned saturating pack down to 16 bits. */
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const __m256i ints = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(src), add1), mulby32767));
+        _mm_storeu_si128((__m128i *) dst, _mm_packus_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1)));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Uint16) ((*src + 1.0f) * 32767.0f);
+    }
+
+    cvt->len_cvt /= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_U16SYS);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert_F32_to_S32_AVX2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Sint32 *dst = (Sint32 *) cvt->buf;
+    const __m256d mulby2147483647 = _mm256_set1_pd(2147483647.0);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_S32 (using AVX2)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const __m128i ints1 = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(src)), mulby2147483647));
+        const __m128i ints2 = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(src + 4)), mulby2147483647));
+        _mm256_storeu_si256((__m256i *) dst, _mm256_inserti128_si256(_mm256_castsi128_si256(ints1), ints2, 1));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Sint32) (((double) *src) * 2147483647.0);
+    }
+
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S32SYS);
+    }
+}
+#endif
+
+
+#if HAVE_NEON_INTRINSICS
+/* NEON converts float to int by truncating, like the scalar code does, and
+   saturates when narrowing. The S32 converters do their math in double
+   precision like the scalar code, which needs AArch64; 32-bit ARM has no
+   double precision vectors, so there they run the scalar loop. */
+
+static void SDLCALL
+SDL_Convert_S8_to_F32_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint8 *src = (const Sint8 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const float32x4_t divby127 = vdupq_n_f32(DIVBY127);
+    int i = cvt->len_cvt;
+
+    LOG_DEBUG_CONVERT("AUDIO_S8", "AUDIO_F32 (using NEON)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = (((float) src[i]) * DIVBY127);
+    }
+
+    while (i) {
+        int16x8_t shorts;
+        i -= 8;
+        shorts = vmovl_s8(vld1_s8(src + i));
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(shorts))), divby127));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(shorts))), divby127));
+    }
+
+    cvt->len_cvt *= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_U8_to_F32_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Uint8 *src = (const Uint8 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const float32x4_t divby127 = vdupq_n_f32(DIVBY127);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    int i = cvt->len_cvt;
+
+    LOG_DEBUG_CONVERT("AUDIO_U8", "AUDIO_F32 (using NEON)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = ((((float) src[i]) * DIVBY127) - 1.0f);
+    }
+
+    while (i) {
+        uint16x8_t shorts;
+        i -= 8;
+        shorts = vmovl_u8(vld1_u8(src + i));
+        vst1q_f32(dst + i, vsubq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(shorts))), divby127), one));
+        vst1q_f32(dst + i + 4, vsubq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(shorts))), divby127), one));
+    }
+
+    cvt->len_cvt *= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_F32_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint16 *src = (const Sint16 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const float32x4_t divby32767 = vdupq_n_f32(DIVBY32767);
+    int i = cvt->len_cvt / sizeof (Sint16);
+
+    LOG_DEBUG_CONVERT("AUDIO_S16", "AUDIO_F32 (using NEON)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = (((float) src[i]) * DIVBY32767);
+    }
+
+    while (i) {
+        int16x8_t shorts;
+        i -= 8;
+        shorts = vld1q_s16(src + i);
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(shorts))), divby32767));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(shorts))), divby32767));
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_U16_to_F32_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Uint16 *src = (const Uint16 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    const float32x4_t divby32767 = vdupq_n_f32(DIVBY32767);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    int i = cvt->len_cvt / sizeof (Uint16);
+
+    LOG_DEBUG_CONVERT("AUDIO_U16", "AUDIO_F32 (using NEON)");
+
+    while (i & 7) {
+        --i;
+        dst[i] = ((((float) src[i]) * DIVBY32767) - 1.0f);
+    }
+
+    while (i) {
+        uint16x8_t shorts;
+        i -= 8;
+        shorts = vld1q_u16(src + i);
+        vst1q_f32(dst + i, vsubq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(shorts))), divby32767), one));
+        vst1q_f32(dst + i + 4, vsubq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(shorts))), divby32767), one));
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_S32_to_F32_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const Sint32 *src = (const Sint32 *) cvt->buf;
+    float *dst = (float *) cvt->buf;
+    int i = cvt->len_cvt / sizeof (Sint32);
+
+    LOG_DEBUG_CONVERT("AUDIO_S32", "AUDIO_F32 (using NEON)");
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    {
+        const float64x2_t divby2147483647 = vdupq_n_f64(DIVBY2147483647);
+        for (; i >= 4; i -= 4, src += 4, dst += 4) {
+            const int32x4_t ints = vld1q_s32(src);
+            const float64x2_t lo = vmulq_f64(vcvtq_f64_s64(vmovl_s32(vget_low_s32(ints))), divby2147483647);
+            const float64x2_t hi = vmulq_f64(vcvtq_f64_s64(vmovl_s32(vget_high_s32(ints))), divby2147483647);
+            vst1q_f32(dst, vcombine_f32(vcvt_f32_f64(lo), vcvt_f32_f64(hi)));
+        }
+    }
+#endif
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (float) (((double) *src) * DIVBY2147483647);
+    }
+
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_F32SYS);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S8_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Sint8 *dst = (Sint8 *) cvt->buf;
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_S8 (using NEON)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const int32x4_t ints1 = vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(src), 127.0f));
+        const int32x4_t ints2 = vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(src + 4), 127.0f));
+        vst1_s8(dst, vqmovn_s16(vcombine_s16(vqmovn_s32(ints1), vqmovn_s32(ints2))));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Sint8) (*src * 127.0f);
+    }
+
+    cvt->len_cvt /= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S8);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_U8_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Uint8 *dst = (Uint8 *) cvt->buf;
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_U8 (using NEON)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const uint32x4_t uints1 = vcvtq_u32_f32(vmulq_n_f32(vaddq_f32(vld1q_f32(src), one), 127.0f));
+        const uint32x4_t uints2 = vcvtq_u32_f32(vmulq_n_f32(vaddq_f32(vld1q_f32(src + 4), one), 127.0f));
+        vst1_u8(dst, vqmovn_u16(vcombine_u16(vqmovn_u32(uints1), vqmovn_u32(uints2))));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Uint8) ((*src + 1.0f) * 127.0f);
+    }
+
+    cvt->len_cvt /= 4;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_U8);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S16_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Sint16 *dst = (Sint16 *) cvt->buf;
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_S16 (using NEON)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const int32x4_t ints1 = vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(src), 32767.0f));
+        const int32x4_t ints2 = vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(src + 4), 32767.0f));
+        vst1q_s16(dst, vcombine_s16(vqmovn_s32(ints1), vqmovn_s32(ints2)));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Sint16) (*src * 32767.0f);
+    }
+
+    cvt->len_cvt /= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S16SYS);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_U16_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Uint16 *dst = (Uint16 *) cvt->buf;
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    int i;
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_U16 (using NEON)");
+
+    for (i = cvt->len_cvt / sizeof (float); i >= 8; i -= 8, src += 8, dst += 8) {
+        const uint32x4_t uints1 = vcvtq_u32_f32(vmulq_n_f32(vaddq_f32(vld1q_f32(src), one), 32767.0f));
+        const uint32x4_t uints2 = vcvtq_u32_f32(vmulq_n_f32(vaddq_f32(vld1q_f32(src + 4), one), 32767.0f));
+        vst1q_u16(dst, vcombine_u16(vqmovn_u32(uints1), vqmovn_u32(uints2)));
+    }
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Uint16) ((*src + 1.0f) * 32767.0f);
+    }
+
+    cvt->len_cvt /= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_U16SYS);
+    }
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S32_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) cvt->buf;
+    Sint32 *dst = (Sint32 *) cvt->buf;
+    int i = cvt->len_cvt / sizeof (float);
+
+    LOG_DEBUG_CONVERT("AUDIO_F32", "AUDIO_S32 (using NEON)");
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    /* Truncate to 64 bits and narrow with saturation, which is what the
+       scalar conversion to Sint32 does on AArch64. */
+    for (; i >= 4; i -= 4, src += 4, dst += 4) {
+        const float32x4_t floats = vld1q_f32(src);
+        const int64x2_t lo = vcvtq_s64_f64(vmulq_n_f64(vcvt_f64_f32(vget_low_f32(floats)), 2147483647.0));
+        const int64x2_t hi = vcvtq_s64_f64(vmulq_n_f64(vcvt_f64_f32(vget_high_f32(floats)), 2147483647.0));
+        vst1q_s32(dst, vcombine_s32(vqmovn_s64(lo), vqmovn_s64(hi)));
+    }
+#endif
+
+    /* Finish off any leftovers with scalar operations. */
+    for (; i; --i, ++src, ++dst) {
+        *dst = (Sint32) (((double) *src) * 2147483647.0);
+    }
+
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, AUDIO_S32SYS);
+    }
+}
+#endif
+
 
 void SDL_ChooseAudioConverters(void)
 {
@@ -765,6 +1335,13 @@ void SDL_ChooseAudioConverters(void)
         SDL_Convert_F32_to_S32 = SDL_Convert_F32_to_S32_##fntype; \
         converters_chosen = SDL_TRUE
 
+    #if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_CONVERTER_FUNCS(AVX2);
+        return;
+    }
+    #endif
+
     #if HAVE_SSE2_INTRINSICS
     if (SDL_HasSSE2()) {
         SET_CONVERTER_FUNCS(SSE2);
@@ -772,6 +1349,13 @@ void SDL_ChooseAudioConverters(void)
     }
     #endif
 
+    #if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SET_CONVERTER_FUNCS(NEON);
+        return;
+    }
+    #endif
+
     #if NEED_SCALAR_CONVERTER_FALLBACKS
     SET_CONVERTER_FUNCS(Scalar);
     #endif
@@ -25,7 +25,13 @@
 #include "SDL_cpuinfo.h"
 #include "SDL_timer.h"
 #include "SDL_audio.h"
+#include "SDL_audio_c.h"
 #include "SDL_sysaudio.h"
+#include "../cpuinfo/SDL_simd.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
 
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
@@ -86,14 +92,466 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 
 
+/* SIMD versions of the S16, S32 and F32 mixers. They give the same results
+   as the scalar code below: the volume adjustment rounds toward zero, and
+   the sum saturates. Each one mixes as many whole vectors as fit in (len)
+   and returns how many bytes that was; the scalar code does the rest. */
+
+#if HAVE_SSE2_INTRINSICS
+static SDL_INLINE __m128i
+MixByteswap16_SSE2(const __m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+static SDL_INLINE __m128i
+MixByteswap32_SSE2(__m128i x)
+{
+    x = MixByteswap16_SSE2(x);
+    x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+/* (volume) holds the volume in the low half of each 32-bit lane. */
+static SDL_INLINE __m128i
+MixAdjustVolumeS16_SSE2(const __m128i x, const __m128i volume)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(x, zero), volume);
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(x, zero), volume);
+    /* add 127 to negative products, so the shift rounds toward zero. */
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_srli_epi32(_mm_srai_epi32(lo, 31), 25)), 7);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, _mm_srli_epi32(_mm_srai_epi32(hi, 31), 25)), 7);
+    return _mm_packs_epi32(lo, hi);
+}
+
+static SDL_INLINE __m128i
+MixAdjustVolumeS32_SSE2(const __m128i x, const __m128i volume)
+{
+    /* x * volume needs up to 39 bits, so split x into (hi * 128 + lo):
+       floor(x * volume / 128) is (hi * volume) + ((lo * volume) >> 7). */
+    const __m128i hi = _mm_srai_epi32(x, 7);
+    const __m128i lo = _mm_madd_epi16(_mm_and_si128(x, _mm_set1_epi32(127)), volume);
+    const __m128i even = _mm_mul_epu32(hi, volume);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(hi, 32), volume);
+    const __m128i hiv = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                           _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    const __m128i inexact = _mm_cmpgt_epi32(_mm_and_si128(lo, _mm_set1_epi32(127)), _mm_setzero_si128());
+    const __m128i negative = _mm_srai_epi32(x, 31);
+    /* ...and one more for inexact negative products to round toward zero. */
+    return _mm_sub_epi32(_mm_add_epi32(hiv, _mm_srai_epi32(lo, 7)), _mm_and_si128(inexact, negative));
+}
+
+static SDL_INLINE __m128i
+MixAddsS32_SSE2(const __m128i a, const __m128i b)
+{
+    const __m128i sum = _mm_add_epi32(a, b);
+    /* it overflowed if a and b have the same sign and the sum doesn't. */
+    const __m128i overflow = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum)), 31);
+    const __m128i limit = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7FFFFFFF));
+    return _mm_or_si128(_mm_and_si128(overflow, limit), _mm_andnot_si128(overflow, sum));
+}
+
+static Uint32
+SDL_MixAudio_S16_SSE2(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    const __m128i vol = _mm_set1_epi32(volume);
+    Uint32 i;
+
+    for (i = 0; (i + 16) <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        if (swap) {
+            s = MixByteswap16_SSE2(s);
+            d = MixByteswap16_SSE2(d);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolumeS16_SSE2(s, vol);
+        }
+        d = _mm_adds_epi16(d, s);
+        if (swap) {
+            d = MixByteswap16_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_S32_SSE2(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    const __m128i vol = _mm_set1_epi32(volume);
+    Uint32 i;
+
+    for (i = 0; (i + 16) <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        if (swap) {
+            s = MixByteswap32_SSE2(s);
+            d = MixByteswap32_SSE2(d);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolumeS32_SSE2(s, vol);
+        }
+        d = MixAddsS32_SSE2(d, s);
+        if (swap) {
+            d = MixByteswap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_F32_SSE2(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    const __m128 fvolume = _mm_set1_ps((float) volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m128 max_audioval = _mm_set1_ps(3.402823466e+38F);
+    const __m128 min_audioval = _mm_set1_ps(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; (i + 16) <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        __m128 sum;
+        if (swap) {
+            s = MixByteswap32_SSE2(s);
+            d = MixByteswap32_SSE2(d);
+        }
+        sum = _mm_mul_ps(_mm_mul_ps(_mm_castsi128_ps(s), fvolume), fmaxvolume);
+        sum = _mm_add_ps(_mm_castsi128_ps(d), sum);
+        /* in this order, NaNs pass through like they do in the scalar code. */
+        sum = _mm_min_ps(max_audioval, _mm_max_ps(min_audioval, sum));
+        d = _mm_castps_si128(sum);
+        if (swap) {
+            d = MixByteswap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static Uint32
+SDL_MixAudio_S16_AVX2(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i swap16 = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                            1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    Uint32 i;
+
+    for (i = 0; (i + 32) <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        if (swap) {
+            s = _mm256_shuffle_epi8(s, swap16);
+            d = _mm256_shuffle_epi8(d, swap16);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(s, zero), vol);
+            __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(s, zero), vol);
+            lo = _mm256_srai_epi32(_mm256_add_epi32(lo, _mm256_srli_epi32(_mm256_srai_epi32(lo, 31), 25)), 7);
+            hi = _mm256_srai_epi32(_mm256_add_epi32(hi, _mm256_srli_epi32(_mm256_srai_epi32(hi, 31), 25)), 7);
+            s = _mm256_packs_epi32(lo, hi);
+        }
+        d = _mm256_adds_epi16(d, s);
+        if (swap) {
+            d = _mm256_shuffle_epi8(d, swap16);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+SDL_TARGETING("avx2") static Uint32
+SDL_MixAudio_S32_AVX2(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    const __m256i mask = _mm256_set1_epi32(127);
+    const __m256i maxval = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i swap32 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    Uint32 i;
+
+    for (i = 0; (i + 32) <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        __m256i sum, overflow, limit;
+        if (swap) {
+            s = _mm256_shuffle_epi8(s, swap32);
+            d = _mm256_shuffle_epi8(d, swap32);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            /* same split as MixAdjustVolumeS32_SSE2(). */
+            const __m256i lo = _mm256_mullo_epi32(_mm256_and_si256(s, mask), vol);
+            const __m256i hiv = _mm256_mullo_epi32(_mm256_srai_epi32(s, 7), vol);
+            const __m256i inexact = _mm256_cmpgt_epi32(_mm256_and_si256(lo, mask), _mm256_setzero_si256());
+            s = _mm256_sub_epi32(_mm256_add_epi32(hiv, _mm256_srai_epi32(lo, 7)), _mm256_and_si256(inexact, _mm256_srai_epi32(s, 31)));
+        }
+        sum = _mm256_add_epi32(d, s);
+        overflow = _mm256_srai_epi32(_mm256_andnot_si256(_mm256_xor_si256(d, s), _mm256_xor_si256(d, sum)), 31);
+        limit = _mm256_xor_si256(_mm256_srai_epi32(d, 31), maxval);
+        d = _mm256_blendv_epi8(sum, limit, overflow);
+        if (swap) {
+            d = _mm256_shuffle_epi8(d, swap32);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+SDL_TARGETING("avx2") static Uint32
+SDL_MixAudio_F32_AVX2(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    const __m256 fvolume = _mm256_set1_ps((float) volume);
+    const __m256 fmaxvolume = _mm256_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m256 max_audioval = _mm256_set1_ps(3.402823466e+38F);
+    const __m256 min_audioval = _mm256_set1_ps(-3.402823466e+38F);
+    const __m256i swap32 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    Uint32 i;
+
+    for (i = 0; (i + 32) <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        __m256 sum;
+        if (swap) {
+            s = _mm256_shuffle_epi8(s, swap32);
+            d = _mm256_shuffle_epi8(d, swap32);
+        }
+        sum = _mm256_mul_ps(_mm256_mul_ps(_mm256_castsi256_ps(s), fvolume), fmaxvolume);
+        sum = _mm256_add_ps(_mm256_castsi256_ps(d), sum);
+        sum = _mm256_min_ps(max_audioval, _mm256_max_ps(min_audioval, sum));
+        d = _mm256_castps_si256(sum);
+        if (swap) {
+            d = _mm256_shuffle_epi8(d, swap32);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static Uint32
+SDL_MixAudio_S16_NEON(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    Uint32 i;
+
+    for (i = 0; (i + 16) <= len; i += 16) {
+        uint8x16_t s8 = vld1q_u8(src + i);
+        uint8x16_t d8 = vld1q_u8(dst + i);
+        int16x8_t s, d;
+        if (swap) {
+            s8 = vrev16q_u8(s8);
+            d8 = vrev16q_u8(d8);
+        }
+        s = vreinterpretq_s16_u8(s8);
+        d = vreinterpretq_s16_u8(d8);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            int32x4_t lo = vmull_n_s16(vget_low_s16(s), (int16_t) volume);
+            int32x4_t hi = vmull_n_s16(vget_high_s16(s), (int16_t) volume);
+            /* add 127 to negative products, so the shift rounds toward zero. */
+            lo = vshrq_n_s32(vaddq_s32(lo, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(lo, 31)), 25))), 7);
+            hi = vshrq_n_s32(vaddq_s32(hi, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(hi, 31)), 25))), 7);
+            s = vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+        }
+        d8 = vreinterpretq_u8_s16(vqaddq_s16(d, s));
+        if (swap) {
+            d8 = vrev16q_u8(d8);
+        }
+        vst1q_u8(dst + i, d8);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_S32_NEON(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    Uint32 i;
+
+    for (i = 0; (i + 16) <= len; i += 16) {
+        uint8x16_t s8 = vld1q_u8(src + i);
+        uint8x16_t d8 = vld1q_u8(dst + i);
+        int32x4_t s, d;
+        if (swap) {
+            s8 = vrev32q_u8(s8);
+            d8 = vrev32q_u8(d8);
+        }
+        s = vreinterpretq_s32_u8(s8);
+        d = vreinterpretq_s32_u8(d8);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            int64x2_t lo = vmull_n_s32(vget_low_s32(s), (int32_t) volume);
+            int64x2_t hi = vmull_n_s32(vget_high_s32(s), (int32_t) volume);
+            lo = vshrq_n_s64(vaddq_s64(lo, vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_s64(vshrq_n_s64(lo, 63)), 57))), 7);
+            hi = vshrq_n_s64(vaddq_s64(hi, vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_s64(vshrq_n_s64(hi, 63)), 57))), 7);
+            s = vcombine_s32(vmovn_s64(lo), vmovn_s64(hi));
+        }
+        d8 = vreinterpretq_u8_s32(vqaddq_s32(d, s));
+        if (swap) {
+            d8 = vrev32q_u8(d8);
+        }
+        vst1q_u8(dst + i, d8);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_F32_NEON(Uint8 *dst, const Uint8 *src, const Uint32 len, const int volume, const SDL_bool swap)
+{
+    const float fvolume = (float) volume;
+    const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
+    const float32x4_t max_audioval = vdupq_n_f32(3.402823466e+38F);
+    const float32x4_t min_audioval = vdupq_n_f32(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; (i + 16) <= len; i += 16) {
+        uint8x16_t s8 = vld1q_u8(src + i);
+        uint8x16_t d8 = vld1q_u8(dst + i);
+        float32x4_t sum;
+        if (swap) {
+            s8 = vrev32q_u8(s8);
+            d8 = vrev32q_u8(d8);
+        }
+        sum = vmulq_n_f32(vmulq_n_f32(vreinterpretq_f32_u8(s8), fvolume), fmaxvolume);
+        sum = vaddq_f32(vreinterpretq_f32_u8(d8), sum);
+        sum = vminq_f32(max_audioval, vmaxq_f32(min_audioval, sum));
+        d8 = vreinterpretq_u8_f32(sum);
+        if (swap) {
+            d8 = vrev32q_u8(d8);
+        }
+        vst1q_u8(dst + i, d8);
+    }
+    return i;
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* These use the same bits as SDL_BLIT_CPU_FEATURES does for the blitters. */
+#define SDL_MIX_CPU_SSE2    0x00000008
+#define SDL_MIX_CPU_AVX2    0x00000040
+#define SDL_MIX_CPU_NEON    0x00000080
+
+static Uint32
+SDL_GetMixFeatures(void)
+{
+    static Uint32 features = 0xffffffff;
+
+    if (features == 0xffffffff) {
+        const char *override = SDL_getenv("SDL_MIX_CPU_FEATURES");
+        Uint32 available = 0;
+
+        /* Allow an override for testing .. */
+        if (override) {
+            SDL_sscanf(override, "%u", &available);
+        } else {
+            if (SDL_HasSSE2()) {
+                available |= SDL_MIX_CPU_SSE2;
+            }
+            if (SDL_HasAVX2()) {
+                available |= SDL_MIX_CPU_AVX2;
+            }
+            if (SDL_HasNEON()) {
+                available |= SDL_MIX_CPU_NEON;
+            }
+        }
+        features = available;
+    }
+    return features;
+}
+
+static Uint32
+SDL_MixAudioFormat_SIMD(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
+                        Uint32 len, int volume)
+{
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+    const Uint32 features = SDL_GetMixFeatures();
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    const SDL_bool swap = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_TRUE : SDL_FALSE;
+#else
+    const SDL_bool swap = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_FALSE : SDL_TRUE;
+#endif
+
+    switch (format & ~SDL_AUDIO_MASK_ENDIAN) {
+    case AUDIO_S16LSB:
+#if HAVE_AVX2_INTRINSICS
+        if (features & SDL_MIX_CPU_AVX2) {
+            return SDL_MixAudio_S16_AVX2(dst, src, len, volume, swap);
+        }
+#endif
+#if HAVE_SSE2_INTRINSICS
+        if (features & SDL_MIX_CPU_SSE2) {
+            return SDL_MixAudio_S16_SSE2(dst, src, len, volume, swap);
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (features & SDL_MIX_CPU_NEON) {
+            return SDL_MixAudio_S16_NEON(dst, src, len, volume, swap);
+        }
+#endif
+        break;
+
+    case AUDIO_S32LSB:
+#if HAVE_AVX2_INTRINSICS
+        if (features & SDL_MIX_CPU_AVX2) {
+            return SDL_MixAudio_S32_AVX2(dst, src, len, volume, swap);
+        }
+#endif
+#if HAVE_SSE2_INTRINSICS
+        if (features & SDL_MIX_CPU_SSE2) {
+            return SDL_MixAudio_S32_SSE2(dst, src, len, volume, swap);
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (features & SDL_MIX_CPU_NEON) {
+            return SDL_MixAudio_S32_NEON(dst, src, len, volume, swap);
+        }
+#endif
+        break;
+
+    case AUDIO_F32LSB:
+#if HAVE_AVX2_INTRINSICS
+        if (features & SDL_MIX_CPU_AVX2) {
+            return SDL_MixAudio_F32_AVX2(dst, src, len, volume, swap);
+        }
+#endif
+#if HAVE_SSE2_INTRINSICS
+        if (features & SDL_MIX_CPU_SSE2) {
+            return SDL_MixAudio_F32_SSE2(dst, src, len, volume, swap);
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (features & SDL_MIX_CPU_NEON) {
+            return SDL_MixAudio_F32_NEON(dst, src, len, volume, swap);
+        }
+#endif
+        break;
+
+    default:
+        break;
+    }
+#endif
+    return 0;
+}
+
+
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
                    Uint32 len, int volume)
 {
+    Uint32 mixed;
+
     if (volume == 0) {
         return;
     }
 
+    mixed = SDL_MixAudioFormat_SIMD(dst, src, format, len, volume);
+    dst += mixed;
+    src += mixed;
+    len -= mixed;
+
     switch (format) {
 
     case AUDIO_U8:
@@ -366,4 +824,381 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
     }
 }
 
+
+/* The multi-voice mixer: every voice converts its audio to float samples
+   in the mixer's channel layout and rate with an SDL_AudioStream, and they
+   are summed into a float accumulator a block at a time, so the output is
+   clamped and converted to the mixer's format only once. */
+
+#define MIXER_MAX_CHANNELS 8
+#define MIXER_BLOCK_FRAMES 1024
+
+typedef struct SDL_AudioMixerVoice
+{
+    SDL_AudioStream *stream;    /* NULL if this slot is free */
+    float gains[MIXER_MAX_CHANNELS];
+    SDL_bool unity_gain;
+} SDL_AudioMixerVoice;
+
+struct _SDL_AudioMixer
+{
+    SDL_mutex *lock;
+    SDL_AudioFormat format;
+    int channels;
+    int rate;
+    int frame_size;
+    SDL_AudioCVT cvt;           /* accumulator to output format */
+    float *accum;
+    float *scratch;
+    SDL_AudioMixerVoice *voices;    /* voice ID (n) lives in slot (n-1) */
+    int num_voices;
+};
+
+SDL_AudioMixer *
+SDL_NewAudioMixer(SDL_AudioFormat format, Uint8 channels, int rate)
+{
+    const size_t blocklen = MIXER_BLOCK_FRAMES * channels * sizeof (float);
+    SDL_AudioMixer *mixer;
+
+    if ((channels < 1) || (channels > MIXER_MAX_CHANNELS)) {
+        SDL_InvalidParamError("channels");
+        return NULL;
+    } else if (rate <= 0) {
+        SDL_InvalidParamError("rate");
+        return NULL;
+    }
+
+    mixer = (SDL_AudioMixer *) SDL_calloc(1, sizeof (SDL_AudioMixer));
+    if (!mixer) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    mixer->format = format;
+    mixer->channels = channels;
+    mixer->rate = rate;
+    mixer->frame_size = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+
+    if (SDL_BuildAudioCVT(&mixer->cvt, AUDIO_F32SYS, channels, rate, format, channels, rate) < 0) {
+        SDL_free(mixer);
+        return NULL;
+    }
+
+    /* the accumulator is converted in place, and never grows doing so. */
+    mixer->accum = (float *) SDL_malloc(blocklen);
+    mixer->scratch = (float *) SDL_malloc(blocklen);
+    mixer->lock = SDL_CreateMutex();
+    if (!mixer->accum || !mixer->scratch || !mixer->lock) {
+        SDL_FreeAudioMixer(mixer);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    return mixer;
+}
+
+static SDL_AudioMixerVoice *
+GetAudioMixerVoice(SDL_AudioMixer *mixer, int voice)
+{
+    if ((voice < 1) || (voice > mixer->num_voices) || !mixer->voices[voice - 1].stream) {
+        SDL_SetError("Invalid voice ID");
+        return NULL;
+    }
+    return &mixer->voices[voice - 1];
+}
+
+static void
+SetAudioMixerVoiceGain(SDL_AudioMixerVoice *voice, int channels, float gain, float pan)
+{
+    int i;
+
+    for (i = 0; i < channels; i++) {
+        voice->gains[i] = gain;
+    }
+
+    /* pan balances the front left and right channels, so it does nothing for mono. */
+    if (channels >= 2) {
+        if (pan < 0.0f) {
+            voice->gains[1] *= 1.0f + pan;
+        } else {
+            voice->gains[0] *= 1.0f - pan;
+        }
+    }
+
+    voice->unity_gain = SDL_TRUE;
+    for (i = 0; i < channels; i++) {
+        if (voice->gains[i] != 1.0f) {
+            voice->unity_gain = SDL_FALSE;
+        }
+    }
+}
+
+int
+SDL_AudioMixerAddVoice(SDL_AudioMixer *mixer, SDL_AudioFormat src_format,
+                       Uint8 src_channels, int src_rate)
+{
+    SDL_AudioStream *stream;
+    int i;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    stream = SDL_NewAudioStream(src_format, src_channels, src_rate,
+                                AUDIO_F32SYS, mixer->channels, mixer->rate);
+    if (!stream) {
+        return -1;
+    }
+
+    SDL_LockMutex(mixer->lock);
+
+    for (i = 0; i < mixer->num_voices; i++) {
+        if (!mixer->voices[i].stream) {
+            break;
+        }
+    }
+
+    if (i == mixer->num_voices) {
+        void *ptr = SDL_realloc(mixer->voices, (i + 1) * sizeof (SDL_AudioMixerVoice));
+        if (!ptr) {
+            SDL_UnlockMutex(mixer->lock);
+            SDL_FreeAudioStream(stream);
+            return SDL_OutOfMemory();
+        }
+        mixer->voices = (SDL_AudioMixerVoice *) ptr;
+        mixer->num_voices++;
+    }
+
+    mixer->voices[i].stream = stream;
+    SetAudioMixerVoiceGain(&mixer->voices[i], mixer->channels, 1.0f, 0.0f);
+
+    SDL_UnlockMutex(mixer->lock);
+
+    return i + 1;
+}
+
+int
+SDL_AudioMixerRemoveVoice(SDL_AudioMixer *mixer, int voice)
+{
+    SDL_AudioMixerVoice *v;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    v = GetAudioMixerVoice(mixer, voice);
+    if (v) {
+        SDL_FreeAudioStream(v->stream);
+        v->stream = NULL;
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return v ? 0 : -1;
+}
+
+int
+SDL_AudioMixerSetVoiceGain(SDL_AudioMixer *mixer, int voice, float gain, float pan)
+{
+    SDL_AudioMixerVoice *v;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    } else if (!(gain >= 0.0f)) {
+        return SDL_InvalidParamError("gain");
+    } else if (!(pan >= -1.0f && pan <= 1.0f)) {
+        return SDL_InvalidParamError("pan");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    v = GetAudioMixerVoice(mixer, voice);
+    if (v) {
+        SetAudioMixerVoiceGain(v, mixer->channels, gain, pan);
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return v ? 0 : -1;
+}
+
+int
+SDL_AudioMixerPutVoice(SDL_AudioMixer *mixer, int voice, const void *buf, Uint32 len)
+{
+    SDL_AudioMixerVoice *v;
+    int retval = -1;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    v = GetAudioMixerVoice(mixer, voice);
+    if (v) {
+        retval = SDL_AudioStreamPut(v->stream, buf, len);
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return retval;
+}
+
+int
+SDL_AudioMixerClearVoice(SDL_AudioMixer *mixer, int voice)
+{
+    SDL_AudioMixerVoice *v;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    v = GetAudioMixerVoice(mixer, voice);
+    if (v) {
+        SDL_AudioStreamClear(v->stream);
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return v ? 0 : -1;
+}
+
+int
+SDL_AudioMixerVoiceAvailable(SDL_AudioMixer *mixer, int voice)
+{
+    SDL_AudioMixerVoice *v;
+    int retval = -1;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    v = GetAudioMixerVoice(mixer, voice);
+    if (v) {
+        /* the stream holds float samples, report bytes in the mixer's format. */
+        const int frames = SDL_AudioStreamAvailable(v->stream) / (int) (mixer->channels * sizeof (float));
+        retval = frames * mixer->frame_size;
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return retval;
+}
+
+static void
+MixAudioMixerVoice(float *accum, const float *src, const int samples,
+                   const SDL_AudioMixerVoice *voice, const int channels,
+                   const SDL_bool first)
+{
+    int i, c;
+
+    if (first) {
+        /* the first voice was read straight into the accumulator. */
+        if (!voice->unity_gain) {
+            for (i = 0; i < samples; i += channels) {
+                for (c = 0; c < channels; c++) {
+                    accum[i + c] *= voice->gains[c];
+                }
+            }
+        }
+    } else if (voice->unity_gain) {
+        for (i = 0; i < samples; i++) {
+            accum[i] += src[i];
+        }
+    } else {
+        for (i = 0; i < samples; i += channels) {
+            for (c = 0; c < channels; c++) {
+                accum[i + c] += src[i + c] * voice->gains[c];
+            }
+        }
+    }
+}
+
+int
+SDL_AudioMixerGet(SDL_AudioMixer *mixer, void *buf, Uint32 len)
+{
+    Uint8 *dst = (Uint8 *) buf;
+    Uint32 remaining = len;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if ((len % mixer->frame_size) != 0) {
+        return SDL_SetError("Can't request partial sample frames");
+    }
+
+    SDL_LockMutex(mixer->lock);
+
+    while (remaining > 0) {
+        const int frames = (int) SDL_min(remaining / mixer->frame_size, MIXER_BLOCK_FRAMES);
+        const int samples = frames * mixer->channels;
+        float *accum = mixer->accum;
+        int mixed = 0;
+        int i;
+
+        for (i = 0; i < mixer->num_voices; i++) {
+            const SDL_AudioMixerVoice *voice = &mixer->voices[i];
+            float *src = mixed ? mixer->scratch : accum;
+            int got;
+
+            if (!voice->stream) {
+                continue;
+            }
+
+            got = SDL_AudioStreamGet(voice->stream, src, samples * sizeof (float));
+            if (got <= 0) {
+                continue;
+            }
+
+            got /= sizeof (float);
+            if (!mixed) {
+                SDL_memset(accum + got, '\0', (samples - got) * sizeof (float));
+            }
+            MixAudioMixerVoice(accum, src, got, voice, mixer->channels, mixed ? SDL_FALSE : SDL_TRUE);
+            mixed = 1;
+        }
+
+        if (!mixed) {
+            SDL_memset(accum, '\0', samples * sizeof (float));
+        } else {
+            for (i = 0; i < samples; i++) {
+                if (accum[i] > 1.0f) {
+                    accum[i] = 1.0f;
+                } else if (accum[i] < -1.0f) {
+                    accum[i] = -1.0f;
+                }
+            }
+        }
+
+        mixer->cvt.buf = (Uint8 *) accum;
+        mixer->cvt.len = samples * sizeof (float);
+        mixer->cvt.len_cvt = mixer->cvt.len;
+        if (mixer->cvt.needed) {
+            SDL_ConvertAudio(&mixer->cvt);
+        }
+        SDL_memcpy(dst, accum, frames * mixer->frame_size);
+
+        dst += frames * mixer->frame_size;
+        remaining -= frames * mixer->frame_size;
+    }
+
+    SDL_UnlockMutex(mixer->lock);
+
+    return (int) len;
+}
+
+void
+SDL_FreeAudioMixer(SDL_AudioMixer *mixer)
+{
+    int i;
+
+    if (mixer) {
+        for (i = 0; i < mixer->num_voices; i++) {
+            SDL_FreeAudioStream(mixer->voices[i].stream);
+        }
+        SDL_free(mixer->voices);
+        SDL_free(mixer->accum);
+        SDL_free(mixer->scratch);
+        SDL_DestroyMutex(mixer->lock);
+        SDL_free(mixer);
+    }
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -51,6 +51,19 @@ extern void SDL_RemoveAudioDevice(const int iscapture, void *handle);
    as appropriate so SDL's list of devices is accurate. */
 extern void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device);
 
+/* Audio targets should call this when a playback device ran out of audio
+   before SDL gave it more (an underrun, or xrun), so it shows up in
+   SDL_GetAudioDeviceStats(). */
+extern void SDL_AudioDeviceUnderrun(SDL_AudioDevice *device);
+
+/* Audio targets without a clock of their own can pace playback with these,
+   as if the device played one buffer every (period) nanoseconds: call
+   SDL_SimulatedPlayDevice() from PlayDevice() and SDL_SimulatedWaitDevice()
+   from WaitDevice(). A buffer that arrives after the last one would have
+   finished playing counts as an underrun. */
+extern void SDL_SimulatedPlayDevice(SDL_AudioDevice *device, Uint64 period);
+extern void SDL_SimulatedWaitDevice(SDL_AudioDevice *device, Uint64 period);
+
 /* This is the size of a packet when using SDL_QueueAudio(). We allocate
    these as necessary and pool them, under the assumption that we'll
    eventually end up with a handful that keep recycling, meeting whatever
@@ -125,6 +138,35 @@ typedef struct SDL_AudioDriver
 } SDL_AudioDriver;
 
 
+/* The ring buffer of a device opened with SDL_OpenAudioDeviceRing(). One
+   side is the app, the other the audio thread, and they never lock. The
+   head and tail count bytes and are left to wrap around; the size is a
+   power of two, so masking them gives the offset into the buffer. */
+typedef struct SDL_AudioRing
+{
+    Uint8 *data;
+    Uint32 size;
+    SDL_atomic_t head;  /* bytes written so far. Only the writer moves it. */
+    SDL_atomic_t tail;  /* bytes read so far. The reader moves it; clearing jumps it to head. */
+    SDL_atomic_t underruns;
+    SDL_atomic_t overruns;
+    SDL_bool stalled;  /* audio thread only: did its last transfer come up short? */
+} SDL_AudioRing;
+
+/* Playback statistics for SDL_GetAudioDeviceStats(). The audio thread
+   updates them under (lock). Callback durations are in performance
+   counter ticks. */
+typedef struct SDL_AudioDeviceStatsData
+{
+    SDL_SpinLock lock;
+    Uint32 callbacks;
+    Uint64 min_callback;
+    Uint64 max_callback;
+    Uint64 total_callback;
+    Uint32 underruns;
+    Uint32 silence_frames;
+} SDL_AudioDeviceStatsData;
+
 /* Define the SDL audio driver structure */
 struct SDL_AudioDevice
 {
@@ -162,6 +204,18 @@ struct SDL_AudioDevice
 
     /* Queued buffers (if app not using callback). */
     SDL_DataQueue *buffer_queue;
+    SDL_bool buffer_queue_lockfree;  /* if true, the app thread doesn't lock the device to use it. */
+
+    /* Ring buffer that replaces buffer_queue (if opened with SDL_OpenAudioDeviceRing()). */
+    SDL_AudioRing *ring;
+    Uint32 ring_reserved;  /* bytes handed out by SDL_ReserveQueuedAudio(), not committed yet. */
+    Uint32 ring_peeked;  /* bytes handed out by SDL_PeekQueuedAudio(), not released yet. */
+
+    /* Playback statistics. */
+    SDL_AudioDeviceStatsData stats;
+
+    /* When the simulated device runs out of audio (see SDL_SimulatedPlayDevice()). */
+    Uint64 simulated_deadline;
 
     /* * * */
     /* Data private to this driver */
@@ -35,7 +35,7 @@ struct MS_ADPCM_decodestate
     Sint16 iSamp1;
     Sint16 iSamp2;
 };
-static struct MS_ADPCM_decoder
+struct MS_ADPCM_decoder
 {
     WaveFMT wavefmt;
     Uint16 wSamplesPerBlock;
@@ -43,96 +43,164 @@ static struct MS_ADPCM_decoder
     Sint16 aCoeff[7][2];
     /* * * */
     struct MS_ADPCM_decodestate state[2];
-} MS_ADPCM_state;
+};
 
 static int
-InitMS_ADPCM(WaveFMT * format)
+InitMS_ADPCM(struct MS_ADPCM_decoder *decoder, WaveFMT * format, Uint32 fmtlen)
 {
     Uint8 *rogue_feel;
+    Uint32 channels, datalen;
     int i;
 
+    /* The coefficients follow the extra info size and samples per block */
+    if (fmtlen < sizeof(*format) + 3 * sizeof(Uint16) + 7 * 2 * sizeof(Sint16)) {
+        SDL_SetError("MS ADPCM format chunk too short");
+        return (-1);
+    }
+
     /* Set the rogue pointer to the MS_ADPCM specific data */
-    MS_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    MS_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    MS_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    MS_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    MS_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    MS_ADPCM_state.wavefmt.bitspersample =
+    decoder->wavefmt.encoding = SDL_SwapLE16(format->encoding);
+    decoder->wavefmt.channels = SDL_SwapLE16(format->channels);
+    decoder->wavefmt.frequency = SDL_SwapLE32(format->frequency);
+    decoder->wavefmt.byterate = SDL_SwapLE32(format->byterate);
+    decoder->wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
+    decoder->wavefmt.bitspersample =
         SDL_SwapLE16(format->bitspersample);
     rogue_feel = (Uint8 *) format + sizeof(*format);
     if (sizeof(*format) == 16) {
         /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
         rogue_feel += sizeof(Uint16);
     }
-    MS_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    decoder->wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
     rogue_feel += sizeof(Uint16);
-    MS_ADPCM_state.wNumCoef = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    decoder->wNumCoef = ((rogue_feel[1] << 8) | rogue_feel[0]);
     rogue_feel += sizeof(Uint16);
-    if (MS_ADPCM_state.wNumCoef != 7) {
+    if (decoder->wNumCoef != 7) {
         SDL_SetError("Unknown set of MS_ADPCM coefficients");
         return (-1);
     }
-    for (i = 0; i < MS_ADPCM_state.wNumCoef; ++i) {
-        MS_ADPCM_state.aCoeff[i][0] = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    for (i = 0; i < decoder->wNumCoef; ++i) {
+        decoder->aCoeff[i][0] = ((rogue_feel[1] << 8) | rogue_feel[0]);
         rogue_feel += sizeof(Uint16);
-        MS_ADPCM_state.aCoeff[i][1] = ((rogue_feel[1] << 8) | rogue_feel[0]);
+        decoder->aCoeff[i][1] = ((rogue_feel[1] << 8) | rogue_feel[0]);
         rogue_feel += sizeof(Uint16);
     }
+
+    /* Make sure a block holds as many samples as it claims to */
+    channels = decoder->wavefmt.channels;
+    if ((channels < 1) || (channels > SDL_arraysize(decoder->state))) {
+        SDL_SetError("MS ADPCM decoder can only handle %u channels",
+                     (unsigned int)SDL_arraysize(decoder->state));
+        return (-1);
+    }
+    datalen = (decoder->wSamplesPerBlock - 2) * channels;
+    if ((decoder->wSamplesPerBlock < 2) || (datalen & 1) ||
+        ((7 * channels) + (datalen / 2) > decoder->wavefmt.blockalign)) {
+        SDL_SetError("Invalid MS ADPCM block size");
+        return (-1);
+    }
     return (0);
 }
 
-static Sint32
-MS_ADPCM_nibble(struct MS_ADPCM_decodestate *state,
-                Uint8 nybble, Sint16 * coeff)
+/* How iDelta scales after each nibble */
+static const Sint32 MS_ADPCM_adaptive[16] = {
+    230, 230, 230, 230, 307, 409, 512, 614,
+    768, 614, 512, 409, 307, 230, 230, 230
+};
+
+/* The signed value of each nibble */
+static const Sint32 MS_ADPCM_signed_nibble[16] = {
+    0, 1, 2, 3, 4, 5, 6, 7,
+    -8, -7, -6, -5, -4, -3, -2, -1
+};
+
+/* Decode one block of wavefmt.blockalign bytes into wSamplesPerBlock frames.
+   Each channel only depends on its own earlier samples, so they're decoded
+   one at a time, which keeps a channel's state in registers. */
+static int
+MS_ADPCM_decode_block(struct MS_ADPCM_decoder *decoder,
+                      const Uint8 * encoded, Uint8 * decoded)
 {
     const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
     const Sint32 min_audioval = -(1 << (16 - 1));
-    const Sint32 adaptive[] = {
-        230, 230, 230, 230, 307, 409, 512, 614,
-        768, 614, 512, 409, 307, 230, 230, 230
-    };
-    Sint32 new_sample, delta;
-
-    new_sample = ((state->iSamp1 * coeff[0]) +
-                  (state->iSamp2 * coeff[1])) / 256;
-    if (nybble & 0x08) {
-        new_sample += state->iDelta * (nybble - 0x10);
-    } else {
-        new_sample += state->iDelta * nybble;
-    }
-    if (new_sample < min_audioval) {
-        new_sample = min_audioval;
-    } else if (new_sample > max_audioval) {
-        new_sample = max_audioval;
+    const int channels = decoder->wavefmt.channels;
+    const int samples = (decoder->wSamplesPerBlock - 2) * channels;
+    Sint16 *output = (Sint16 *) decoded;
+    int c, i;
+
+    /* The block header has the predictor for each channel, then iDelta,
+       then iSamp1, then iSamp2, each as one little-endian word per channel. */
+    for (c = 0; c < channels; ++c) {
+        struct MS_ADPCM_decodestate *state = &decoder->state[c];
+        const Uint8 *word = encoded + channels + c * sizeof(Sint16);
+
+        state->hPredictor = encoded[c];
+        if (state->hPredictor >= decoder->wNumCoef) {
+            SDL_SetError("Invalid MS ADPCM predictor");
+            return (-1);
+        }
+        state->iDelta = ((word[1] << 8) | word[0]);
+        word += channels * sizeof(Sint16);
+        state->iSamp1 = ((word[1] << 8) | word[0]);
+        word += channels * sizeof(Sint16);
+        state->iSamp2 = ((word[1] << 8) | word[0]);
+
+        /* Store the two initial samples we start with */
+        output[c] = SDL_SwapLE16(state->iSamp2);
+        output[channels + c] = SDL_SwapLE16(state->iSamp1);
     }
-    delta = ((Sint32) state->iDelta * adaptive[nybble]) / 256;
-    if (delta < 16) {
-        delta = 16;
+    encoded += 7 * channels;
+    output += 2 * channels;
+
+    /* Decode and store the other samples in this block. Sample i is in
+       the high nibble of byte i/2 if i is even, the low one if it's odd. */
+    for (c = 0; c < channels; ++c) {
+        const struct MS_ADPCM_decodestate *state = &decoder->state[c];
+        const Sint32 coeff1 = decoder->aCoeff[state->hPredictor][0];
+        const Sint32 coeff2 = decoder->aCoeff[state->hPredictor][1];
+        Sint32 delta = state->iDelta;
+        Sint32 sample1 = state->iSamp1;
+        Sint32 sample2 = state->iSamp2;
+
+        for (i = c; i < samples; i += channels) {
+            const Uint8 nybble = (encoded[i >> 1] >> ((~i & 1) << 2)) & 0x0F;
+            Sint32 new_sample = ((sample1 * coeff1) + (sample2 * coeff2)) / 256;
+
+            new_sample += delta * MS_ADPCM_signed_nibble[nybble];
+            if (new_sample < min_audioval) {
+                new_sample = min_audioval;
+            } else if (new_sample > max_audioval) {
+                new_sample = max_audioval;
+            }
+            output[i] = SDL_SwapLE16((Sint16) new_sample);
+
+            delta = (delta * MS_ADPCM_adaptive[nybble]) / 256;
+            if (delta < 16) {
+                delta = 16;
+            }
+            delta &= 0xFFFF;  /* iDelta is only a 16-bit word */
+            sample2 = sample1;
+            sample1 = new_sample;
+        }
     }
-    state->iDelta = (Uint16) delta;
-    state->iSamp2 = state->iSamp1;
-    state->iSamp1 = (Sint16) new_sample;
-    return (new_sample);
+    return (0);
 }
 
 static int
-MS_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+MS_ADPCM_decode(struct MS_ADPCM_decoder *decoder,
+                Uint8 ** audio_buf, Uint32 * audio_len)
 {
-    struct MS_ADPCM_decodestate *state[2];
     Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    Sint8 nybble;
-    Uint8 stereo;
-    Sint16 *coeff[2];
-    Sint32 new_sample;
+    Sint32 encoded_len, decoded_blocklen;
 
     /* Allocate the proper sized output buffer */
     encoded_len = *audio_len;
     encoded = *audio_buf;
     freeable = *audio_buf;
-    *audio_len = (encoded_len / MS_ADPCM_state.wavefmt.blockalign) *
-        MS_ADPCM_state.wSamplesPerBlock *
-        MS_ADPCM_state.wavefmt.channels * sizeof(Sint16);
+    decoded_blocklen = decoder->wSamplesPerBlock *
+        decoder->wavefmt.channels * sizeof(Sint16);
+    *audio_len = (encoded_len / decoder->wavefmt.blockalign) *
+        decoded_blocklen;
     *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
     if (*audio_buf == NULL) {
         return SDL_OutOfMemory();
@@ -140,76 +208,16 @@ MS_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
     decoded = *audio_buf;
 
     /* Get ready... Go! */
-    stereo = (MS_ADPCM_state.wavefmt.channels == 2);
-    state[0] = &MS_ADPCM_state.state[0];
-    state[1] = &MS_ADPCM_state.state[stereo];
-    while (encoded_len >= MS_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
-        state[0]->hPredictor = *encoded++;
-        if (stereo) {
-            state[1]->hPredictor = *encoded++;
-        }
-        state[0]->iDelta = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iDelta = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        state[0]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        state[0]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
+    while (encoded_len >= decoder->wavefmt.blockalign) {
+        if (MS_ADPCM_decode_block(decoder, encoded, decoded) < 0) {
+            SDL_free(*audio_buf);
+            *audio_buf = NULL;
+            SDL_free(freeable);
+            return (-1);
         }
-        coeff[0] = MS_ADPCM_state.aCoeff[state[0]->hPredictor];
-        coeff[1] = MS_ADPCM_state.aCoeff[state[1]->hPredictor];
-
-        /* Store the two initial samples we start with */
-        decoded[0] = state[0]->iSamp2 & 0xFF;
-        decoded[1] = state[0]->iSamp2 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp2 & 0xFF;
-            decoded[1] = state[1]->iSamp2 >> 8;
-            decoded += 2;
-        }
-        decoded[0] = state[0]->iSamp1 & 0xFF;
-        decoded[1] = state[0]->iSamp1 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp1 & 0xFF;
-            decoded[1] = state[1]->iSamp1 >> 8;
-            decoded += 2;
-        }
-
-        /* Decode and store the other samples in this block */
-        samplesleft = (MS_ADPCM_state.wSamplesPerBlock - 2) *
-            MS_ADPCM_state.wavefmt.channels;
-        while (samplesleft > 0) {
-            nybble = (*encoded) >> 4;
-            new_sample = MS_ADPCM_nibble(state[0], nybble, coeff[0]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            nybble = (*encoded) & 0x0F;
-            new_sample = MS_ADPCM_nibble(state[1], nybble, coeff[1]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            ++encoded;
-            samplesleft -= 2;
-        }
-        encoded_len -= MS_ADPCM_state.wavefmt.blockalign;
+        encoded += decoder->wavefmt.blockalign;
+        decoded += decoded_blocklen;
+        encoded_len -= decoder->wavefmt.blockalign;
     }
     SDL_free(freeable);
     return (0);
@@ -220,144 +228,181 @@ struct IMA_ADPCM_decodestate
     Sint32 sample;
     Sint8 index;
 };
-static struct IMA_ADPCM_decoder
+struct IMA_ADPCM_decoder
 {
     WaveFMT wavefmt;
     Uint16 wSamplesPerBlock;
     /* * * */
     struct IMA_ADPCM_decodestate state[2];
-} IMA_ADPCM_state;
+};
 
 static int
-InitIMA_ADPCM(WaveFMT * format)
+InitIMA_ADPCM(struct IMA_ADPCM_decoder *decoder, WaveFMT * format, Uint32 fmtlen)
 {
     Uint8 *rogue_feel;
+    Uint32 channels;
+
+    /* The samples per block follow the extra info size */
+    if (fmtlen < sizeof(*format) + 2 * sizeof(Uint16)) {
+        SDL_SetError("IMA ADPCM format chunk too short");
+        return (-1);
+    }
 
     /* Set the rogue pointer to the IMA_ADPCM specific data */
-    IMA_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    IMA_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    IMA_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    IMA_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    IMA_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    IMA_ADPCM_state.wavefmt.bitspersample =
+    decoder->wavefmt.encoding = SDL_SwapLE16(format->encoding);
+    decoder->wavefmt.channels = SDL_SwapLE16(format->channels);
+    decoder->wavefmt.frequency = SDL_SwapLE32(format->frequency);
+    decoder->wavefmt.byterate = SDL_SwapLE32(format->byterate);
+    decoder->wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
+    decoder->wavefmt.bitspersample =
         SDL_SwapLE16(format->bitspersample);
     rogue_feel = (Uint8 *) format + sizeof(*format);
     if (sizeof(*format) == 16) {
         /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
         rogue_feel += sizeof(Uint16);
     }
-    IMA_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    decoder->wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+
+    /* Check to make sure we have enough variables in the state array */
+    channels = decoder->wavefmt.channels;
+    if ((channels < 1) || (channels > SDL_arraysize(decoder->state))) {
+        SDL_SetError("IMA ADPCM decoder can only handle %u channels",
+                     (unsigned int)SDL_arraysize(decoder->state));
+        return (-1);
+    }
+
+    /* Samples after the first come in runs of 8 per channel */
+    if ((decoder->wSamplesPerBlock < 1) ||
+        (((decoder->wSamplesPerBlock - 1) % 8) != 0) ||
+        ((4 * channels) + ((decoder->wSamplesPerBlock - 1) / 2) * channels >
+         decoder->wavefmt.blockalign)) {
+        SDL_SetError("Invalid IMA ADPCM block size");
+        return (-1);
+    }
     return (0);
 }
 
-static Sint32
-IMA_ADPCM_nibble(struct IMA_ADPCM_decodestate *state, Uint8 nybble)
+/* How the step index moves after each nibble */
+static const Sint8 IMA_ADPCM_index_table[16] = {
+    -1, -1, -1, -1,
+    2, 4, 6, 8,
+    -1, -1, -1, -1,
+    2, 4, 6, 8
+};
+
+static const Sint32 IMA_ADPCM_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+    143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
+    1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+    22385, 24623, 27086, 29794, 32767
+};
+
+/* Decode one nibble, keeping the state in the caller's locals */
+static SDL_INLINE Sint32
+IMA_ADPCM_nibble(Sint32 * sample, int *index, Uint8 nybble)
 {
     const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
     const Sint32 min_audioval = -(1 << (16 - 1));
-    const int index_table[16] = {
-        -1, -1, -1, -1,
-        2, 4, 6, 8,
-        -1, -1, -1, -1,
-        2, 4, 6, 8
-    };
-    const Sint32 step_table[89] = {
-        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
-        34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
-        143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
-        449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
-        1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
-        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
-        9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
-        22385, 24623, 27086, 29794, 32767
-    };
-    Sint32 delta, step;
-
-    /* Compute difference and new sample value */
-    if (state->index > 88) {
-        state->index = 88;
-    } else if (state->index < 0) {
-        state->index = 0;
-    }
-    /* explicit cast to avoid gcc warning about using 'char' as array index */
-    step = step_table[(int)state->index];
-    delta = step >> 3;
-    if (nybble & 0x04)
-        delta += step;
-    if (nybble & 0x02)
-        delta += (step >> 1);
-    if (nybble & 0x01)
-        delta += (step >> 2);
-    if (nybble & 0x08)
+    const Sint32 step = IMA_ADPCM_step_table[*index];
+    Sint32 delta;
+
+    /* Compute difference and new sample value, without branches; each
+       bit of the nibble adds a shifted step, like the reference decoder. */
+    delta = (step >> 3) +
+        (step & -(Sint32) ((nybble >> 2) & 1)) +
+        ((step >> 1) & -(Sint32) ((nybble >> 1) & 1)) +
+        ((step >> 2) & -(Sint32) (nybble & 1));
+    if (nybble & 0x08) {
         delta = -delta;
-    state->sample += delta;
-
-    /* Update index value */
-    state->index += index_table[nybble];
+    }
+    *sample += delta;
 
     /* Clamp output sample */
-    if (state->sample > max_audioval) {
-        state->sample = max_audioval;
-    } else if (state->sample < min_audioval) {
-        state->sample = min_audioval;
+    if (*sample > max_audioval) {
+        *sample = max_audioval;
+    } else if (*sample < min_audioval) {
+        *sample = min_audioval;
     }
-    return (state->sample);
+
+    /* Update index value */
+    *index += IMA_ADPCM_index_table[nybble];
+    if (*index > 88) {
+        *index = 88;
+    } else if (*index < 0) {
+        *index = 0;
+    }
+    return (*sample);
 }
 
-/* Fill the decode buffer with a channel block of data (8 samples) */
+/* Decode one block of wavefmt.blockalign bytes into wSamplesPerBlock frames.
+   After the header, each channel has 4 bytes (8 samples) in turn. Each
+   channel only depends on its own earlier samples, so they're decoded one
+   at a time, which keeps a channel's state in registers. */
 static void
-Fill_IMA_ADPCM_block(Uint8 * decoded, Uint8 * encoded,
-                     int channel, int numchannels,
-                     struct IMA_ADPCM_decodestate *state)
+IMA_ADPCM_decode_block(struct IMA_ADPCM_decoder *decoder,
+                       const Uint8 * encoded, Uint8 * decoded)
 {
-    int i;
-    Sint8 nybble;
-    Sint32 new_sample;
-
-    decoded += (channel * 2);
-    for (i = 0; i < 4; ++i) {
-        nybble = (*encoded) & 0x0F;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-
-        nybble = (*encoded) >> 4;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-
-        ++encoded;
+    const int channels = decoder->wavefmt.channels;
+    const int groups = (decoder->wSamplesPerBlock - 1) / 8;
+    Sint16 *output = (Sint16 *) decoded;
+    int c, g, i;
+
+    for (c = 0; c < channels; ++c) {
+        const Uint8 *header = encoded + 4 * c;
+        const Uint8 *data = encoded + 4 * channels + 4 * c;
+        Sint16 *out = output + c;
+        Sint32 sample;
+        int index;
+
+        /* Fill the state information for this block; the fourth byte of
+           the header is reserved, and should be 0. */
+        sample = (Sint16) ((header[1] << 8) | header[0]);
+        index = (Sint8) header[2];
+        if (index > 88) {
+            index = 88;
+        } else if (index < 0) {
+            index = 0;
+        }
+
+        /* Store the initial sample we start with */
+        *out = SDL_SwapLE16((Sint16) sample);
+        out += channels;
+
+        /* Decode and store the other samples in this block */
+        for (g = 0; g < groups; ++g) {
+            for (i = 0; i < 4; ++i) {
+                *out = SDL_SwapLE16((Sint16) IMA_ADPCM_nibble(&sample, &index, data[i] & 0x0F));
+                out += channels;
+                *out = SDL_SwapLE16((Sint16) IMA_ADPCM_nibble(&sample, &index, data[i] >> 4));
+                out += channels;
+            }
+            data += 4 * channels;
+        }
+
+        decoder->state[c].sample = sample;
+        decoder->state[c].index = (Sint8) index;
     }
 }
 
 static int
-IMA_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+IMA_ADPCM_decode(struct IMA_ADPCM_decoder *decoder,
+                 Uint8 ** audio_buf, Uint32 * audio_len)
 {
-    struct IMA_ADPCM_decodestate *state;
     Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    unsigned int c, channels;
-
-    /* Check to make sure we have enough variables in the state array */
-    channels = IMA_ADPCM_state.wavefmt.channels;
-    if (channels > SDL_arraysize(IMA_ADPCM_state.state)) {
-        SDL_SetError("IMA ADPCM decoder can only handle %u channels",
-                     (unsigned int)SDL_arraysize(IMA_ADPCM_state.state));
-        return (-1);
-    }
-    state = IMA_ADPCM_state.state;
+    Sint32 encoded_len, decoded_blocklen;
 
     /* Allocate the proper sized output buffer */
     encoded_len = *audio_len;
     encoded = *audio_buf;
     freeable = *audio_buf;
-    *audio_len = (encoded_len / IMA_ADPCM_state.wavefmt.blockalign) *
-        IMA_ADPCM_state.wSamplesPerBlock *
-        IMA_ADPCM_state.wavefmt.channels * sizeof(Sint16);
+    decoded_blocklen = decoder->wSamplesPerBlock *
+        decoder->wavefmt.channels * sizeof(Sint16);
+    *audio_len = (encoded_len / decoder->wavefmt.blockalign) *
+        decoded_blocklen;
     *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
     if (*audio_buf == NULL) {
         return SDL_OutOfMemory();
@@ -365,39 +410,11 @@ IMA_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
     decoded = *audio_buf;
 
     /* Get ready... Go! */
-    while (encoded_len >= IMA_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
-        for (c = 0; c < channels; ++c) {
-            /* Fill the state information for this block */
-            state[c].sample = ((encoded[1] << 8) | encoded[0]);
-            encoded += 2;
-            if (state[c].sample & 0x8000) {
-                state[c].sample -= 0x10000;
-            }
-            state[c].index = *encoded++;
-            /* Reserved byte in buffer header, should be 0 */
-            if (*encoded++ != 0) {
-                /* Uh oh, corrupt data?  Buggy code? */ ;
-            }
-
-            /* Store the initial sample we start with */
-            decoded[0] = (Uint8) (state[c].sample & 0xFF);
-            decoded[1] = (Uint8) (state[c].sample >> 8);
-            decoded += 2;
-        }
-
-        /* Decode and store the other samples in this block */
-        samplesleft = (IMA_ADPCM_state.wSamplesPerBlock - 1) * channels;
-        while (samplesleft > 0) {
-            for (c = 0; c < channels; ++c) {
-                Fill_IMA_ADPCM_block(decoded, encoded,
-                                     c, channels, &state[c]);
-                encoded += 4;
-                samplesleft -= 8;
-            }
-            decoded += (channels * 8 * 2);
-        }
-        encoded_len -= IMA_ADPCM_state.wavefmt.blockalign;
+    while (encoded_len >= decoder->wavefmt.blockalign) {
+        IMA_ADPCM_decode_block(decoder, encoded, decoded);
+        encoded += decoder->wavefmt.blockalign;
+        decoded += decoded_blocklen;
+        encoded_len -= decoder->wavefmt.blockalign;
     }
     SDL_free(freeable);
     return (0);
@@ -407,41 +424,45 @@ IMA_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
 static const Uint8 extensible_pcm_guid[16] = { 1, 0, 0, 0, 0, 0, 16, 0, 128, 0, 0, 170, 0, 56, 155, 113 };
 static const Uint8 extensible_ieee_guid[16] = { 3, 0, 0, 0, 0, 0, 16, 0, 128, 0, 0, 170, 0, 56, 155, 113 };
 
-SDL_AudioSpec *
-SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
-               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+/* What the RIFF header and fmt chunk of a WAVE file told us */
+typedef struct WaveInfo
+{
+    Uint16 encoding;            /* PCM_CODE, IEEE_FLOAT_CODE or an ADPCM code */
+    Uint32 wavelen;             /* from the RIFF header */
+    Uint32 headerDiff;          /* bytes read since the RIFF header */
+    union
+    {
+        struct MS_ADPCM_decoder ms;
+        struct IMA_ADPCM_decoder ima;
+    } adpcm;
+} WaveInfo;
+
+/* Read everything up to and including the fmt chunk, and fill in spec */
+static int
+ReadWAVEFormat(SDL_RWops * src, WaveInfo * info, SDL_AudioSpec * spec)
 {
     int was_error;
     Chunk chunk;
     int lenread;
-    int IEEE_float_encoded, MS_ADPCM_encoded, IMA_ADPCM_encoded;
-    int samplesize;
 
     /* WAV magic header */
     Uint32 RIFFchunk;
-    Uint32 wavelen = 0;
     Uint32 WAVEmagic;
-    Uint32 headerDiff = 0;
 
     /* FMT chunk */
     WaveFMT *format = NULL;
     WaveExtensibleFMT *ext = NULL;
 
+    SDL_zerop(info);
     SDL_zero(chunk);
 
-    /* Make sure we are passed a valid data source */
-    was_error = 0;
-    if (src == NULL) {
-        was_error = 1;
-        goto done;
-    }
-
     /* Check the magic header */
+    was_error = 0;
     RIFFchunk = SDL_ReadLE32(src);
-    wavelen = SDL_ReadLE32(src);
-    if (wavelen == WAVE) {      /* The RIFFchunk has already been read */
-        WAVEmagic = wavelen;
-        wavelen = RIFFchunk;
+    info->wavelen = SDL_ReadLE32(src);
+    if (info->wavelen == WAVE) {        /* The RIFFchunk has already been read */
+        WAVEmagic = info->wavelen;
+        info->wavelen = RIFFchunk;
         RIFFchunk = RIFF;
     } else {
         WAVEmagic = SDL_ReadLE32(src);
@@ -451,7 +472,7 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         was_error = 1;
         goto done;
     }
-    headerDiff += sizeof(Uint32);       /* for WAVE */
+    info->headerDiff += sizeof(Uint32); /* for WAVE */
 
     /* Read the audio data format chunk */
     chunk.data = NULL;
@@ -464,7 +485,7 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
             goto done;
         }
         /* 2 Uint32's for chunk header+len, plus the lenread */
-        headerDiff += lenread + 2 * sizeof(Uint32);
+        info->headerDiff += lenread + 2 * sizeof(Uint32);
     } while ((chunk.magic == FACT) || (chunk.magic == LIST) || (chunk.magic == BEXT) || (chunk.magic == JUNK));
 
     /* Decode the audio data format */
@@ -474,30 +495,32 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         was_error = 1;
         goto done;
     }
-    IEEE_float_encoded = MS_ADPCM_encoded = IMA_ADPCM_encoded = 0;
-    switch (SDL_SwapLE16(format->encoding)) {
+    if (chunk.length < sizeof(*format)) {
+        SDL_SetError("WAVE format chunk too short");
+        was_error = 1;
+        goto done;
+    }
+    info->encoding = SDL_SwapLE16(format->encoding);
+    switch (info->encoding) {
     case PCM_CODE:
         /* We can understand this */
         break;
     case IEEE_FLOAT_CODE:
-        IEEE_float_encoded = 1;
         /* We can understand this */
         break;
     case MS_ADPCM_CODE:
         /* Try to understand this */
-        if (InitMS_ADPCM(format) < 0) {
+        if (InitMS_ADPCM(&info->adpcm.ms, format, chunk.length) < 0) {
             was_error = 1;
             goto done;
         }
-        MS_ADPCM_encoded = 1;
         break;
     case IMA_ADPCM_CODE:
         /* Try to understand this */
-        if (InitIMA_ADPCM(format) < 0) {
+        if (InitIMA_ADPCM(&info->adpcm.ima, format, chunk.length) < 0) {
             was_error = 1;
             goto done;
         }
-        IMA_ADPCM_encoded = 1;
         break;
     case EXTENSIBLE_CODE:
         /* note that this ignores channel masks, smaller valid bit counts
@@ -505,15 +528,16 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
            to get things that didn't really _need_ WAVE_FORMAT_EXTENSIBLE
            to be useful working when they use this format flag. */
         ext = (WaveExtensibleFMT *) format;
-        if (SDL_SwapLE16(ext->size) < 22) {
+        if ((chunk.length < sizeof(*ext)) || (SDL_SwapLE16(ext->size) < 22)) {
             SDL_SetError("bogus extended .wav header");
             was_error = 1;
             goto done;
         }
+        info->encoding = PCM_CODE;
         if (SDL_memcmp(ext->subformat, extensible_pcm_guid, 16) == 0) {
             break;  /* cool. */
         } else if (SDL_memcmp(ext->subformat, extensible_ieee_guid, 16) == 0) {
-            IEEE_float_encoded = 1;
+            info->encoding = IEEE_FLOAT_CODE;
             break;
         }
         break;
@@ -522,15 +546,14 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         was_error = 1;
         goto done;
     default:
-        SDL_SetError("Unknown WAVE data format: 0x%.4x",
-                     SDL_SwapLE16(format->encoding));
+        SDL_SetError("Unknown WAVE data format: 0x%.4x", info->encoding);
         was_error = 1;
         goto done;
     }
     SDL_zerop(spec);
     spec->freq = SDL_SwapLE32(format->frequency);
 
-    if (IEEE_float_encoded) {
+    if (info->encoding == IEEE_FLOAT_CODE) {
         if ((SDL_SwapLE16(format->bitspersample)) != 32) {
             was_error = 1;
         } else {
@@ -539,7 +562,8 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     } else {
         switch (SDL_SwapLE16(format->bitspersample)) {
         case 4:
-            if (MS_ADPCM_encoded || IMA_ADPCM_encoded) {
+            if ((info->encoding == MS_ADPCM_CODE) ||
+                (info->encoding == IMA_ADPCM_CODE)) {
                 spec->format = AUDIO_S16;
             } else {
                 was_error = 1;
@@ -567,6 +591,41 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     }
     spec->channels = (Uint8) SDL_SwapLE16(format->channels);
     spec->samples = 4096;       /* Good default buffer size */
+    if (spec->channels == 0) {
+        SDL_SetError("WAVE file has no channels");
+        was_error = 1;
+        goto done;
+    }
+
+  done:
+    SDL_free(format);
+    return was_error ? -1 : 0;
+}
+
+SDL_AudioSpec *
+SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
+               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+{
+    int was_error;
+    Chunk chunk;
+    int lenread;
+    int samplesize;
+    WaveInfo info;
+
+    SDL_zero(chunk);
+    SDL_zero(info);
+
+    /* Make sure we are passed a valid data source */
+    was_error = 0;
+    if (src == NULL) {
+        was_error = 1;
+        goto done;
+    }
+
+    if (ReadWAVEFormat(src, &info, spec) < 0) {
+        was_error = 1;
+        goto done;
+    }
 
     /* Read the audio data chunk */
     *audio_buf = NULL;
@@ -581,18 +640,18 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         *audio_len = lenread;
         *audio_buf = chunk.data;
         if (chunk.magic != DATA)
-            headerDiff += lenread + 2 * sizeof(Uint32);
+            info.headerDiff += lenread + 2 * sizeof(Uint32);
     } while (chunk.magic != DATA);
-    headerDiff += 2 * sizeof(Uint32);   /* for the data chunk and len */
+    info.headerDiff += 2 * sizeof(Uint32);      /* for the data chunk and len */
 
-    if (MS_ADPCM_encoded) {
-        if (MS_ADPCM_decode(audio_buf, audio_len) < 0) {
+    if (info.encoding == MS_ADPCM_CODE) {
+        if (MS_ADPCM_decode(&info.adpcm.ms, audio_buf, audio_len) < 0) {
             was_error = 1;
             goto done;
         }
     }
-    if (IMA_ADPCM_encoded) {
-        if (IMA_ADPCM_decode(audio_buf, audio_len) < 0) {
+    if (info.encoding == IMA_ADPCM_CODE) {
+        if (IMA_ADPCM_decode(&info.adpcm.ima, audio_buf, audio_len) < 0) {
             was_error = 1;
             goto done;
         }
@@ -603,13 +662,12 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     *audio_len &= ~(samplesize - 1);
 
   done:
-    SDL_free(format);
     if (src) {
         if (freesrc) {
             SDL_RWclose(src);
         } else {
             /* seek to the end of the file (given by the RIFF chunk) */
-            SDL_RWseek(src, wavelen - chunk.length - headerDiff, RW_SEEK_CUR);
+            SDL_RWseek(src, info.wavelen - chunk.length - info.headerDiff, RW_SEEK_CUR);
         }
     }
     if (was_error) {
@@ -618,6 +676,299 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     return (spec);
 }
 
+/* A WAVE file that is decoded a block at a time, as it's read */
+struct _SDL_WAVStream
+{
+    SDL_RWops *src;
+    int freesrc;
+    WaveInfo info;
+    Sint64 data_start;          /* file offset of the first byte of audio */
+    Sint64 src_pos;             /* where src is now, or -1 if we don't know */
+    Uint32 frame_size;          /* bytes in a decoded sample frame */
+    Uint32 block_size;          /* bytes in an encoded block */
+    Uint32 block_frames;        /* sample frames in an encoded block */
+    Uint32 length;              /* sample frames in the file */
+    Uint32 position;            /* next sample frame to read */
+    Uint8 *block;               /* an encoded block (ADPCM only) */
+    Uint8 *decoded;             /* a decoded block, or PCM bounce buffer */
+    Uint32 decoded_frames;      /* sample frames that fit in decoded */
+    Uint32 decoded_block;       /* the block in decoded, or 0xFFFFFFFF */
+};
+
+SDL_WAVStream *
+SDL_OpenWAVStream_RW(SDL_RWops * src, int freesrc, SDL_AudioSpec * spec)
+{
+    SDL_WAVStream *wav;
+    Uint32 magic, length;
+    Sint64 size;
+
+    if (src == NULL) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (spec == NULL) {
+        SDL_InvalidParamError("spec");
+        goto failed;
+    }
+
+    wav = (SDL_WAVStream *) SDL_calloc(1, sizeof (*wav));
+    if (wav == NULL) {
+        SDL_OutOfMemory();
+        goto failed;
+    }
+    wav->src = src;
+    wav->freesrc = freesrc;
+    wav->decoded_block = 0xFFFFFFFF;
+
+    if (ReadWAVEFormat(src, &wav->info, spec) < 0) {
+        SDL_CloseWAVStream(wav);
+        return NULL;
+    }
+
+    /* Skip to the data chunk, without reading anything in between */
+    for (;;) {
+        magic = SDL_ReadLE32(src);
+        length = SDL_ReadLE32(src);
+        if (magic == DATA) {
+            break;
+        }
+        if ((magic == 0 && length == 0) ||
+            (SDL_RWseek(src, length, RW_SEEK_CUR) < 0)) {
+            SDL_SetError("WAVE file has no data chunk");
+            SDL_CloseWAVStream(wav);
+            return NULL;
+        }
+    }
+    wav->data_start = SDL_RWtell(src);
+    if (wav->data_start < 0) {
+        SDL_SetError("Can't stream a WAVE file from a source that can't seek");
+        SDL_CloseWAVStream(wav);
+        return NULL;
+    }
+    wav->src_pos = wav->data_start;
+
+    /* Files that were cut short, or written as they were recorded, may
+       claim more data than they have. */
+    size = SDL_RWsize(src);
+    if ((size >= 0) && (wav->data_start + length > size)) {
+        length = (Uint32) (size - wav->data_start);
+    }
+
+    wav->frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+    switch (wav->info.encoding) {
+    case MS_ADPCM_CODE:
+        wav->block_size = wav->info.adpcm.ms.wavefmt.blockalign;
+        wav->block_frames = wav->info.adpcm.ms.wSamplesPerBlock;
+        break;
+    case IMA_ADPCM_CODE:
+        wav->block_size = wav->info.adpcm.ima.wavefmt.blockalign;
+        wav->block_frames = wav->info.adpcm.ima.wSamplesPerBlock;
+        break;
+    default:
+        wav->block_size = wav->frame_size;
+        wav->block_frames = 1;
+        break;
+    }
+    wav->length = (length / wav->block_size) * wav->block_frames;
+
+    /* ADPCM is decoded a block at a time; PCM is copied through a buffer
+       of spec->samples frames when it goes to a mixer. */
+    if (wav->block_frames > 1) {
+        wav->decoded_frames = wav->block_frames;
+        wav->block = (Uint8 *) SDL_malloc(wav->block_size);
+    } else {
+        wav->decoded_frames = spec->samples;
+    }
+    wav->decoded = (Uint8 *) SDL_malloc(wav->decoded_frames * wav->frame_size);
+    if ((wav->decoded == NULL) || ((wav->block_frames > 1) && (wav->block == NULL))) {
+        SDL_OutOfMemory();
+        SDL_CloseWAVStream(wav);
+        return NULL;
+    }
+    return wav;
+
+  failed:
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return NULL;
+}
+
+Uint32
+SDL_WAVStreamLength(SDL_WAVStream * wav)
+{
+    if (wav == NULL) {
+        SDL_InvalidParamError("wav");
+        return 0;
+    }
+    return wav->length;
+}
+
+Uint32
+SDL_WAVStreamTell(SDL_WAVStream * wav)
+{
+    if (wav == NULL) {
+        SDL_InvalidParamError("wav");
+        return 0;
+    }
+    return wav->position;
+}
+
+int
+SDL_WAVStreamSeek(SDL_WAVStream * wav, Uint32 frame)
+{
+    if (wav == NULL) {
+        return SDL_InvalidParamError("wav");
+    }
+    if (frame > wav->length) {
+        return SDL_SetError("Can't seek past the end of a WAVE file");
+    }
+    /* Nothing to do until the next read; it'll seek src if it must. */
+    wav->position = frame;
+    return 0;
+}
+
+/* Read whole blocks starting at a block index, seeking only if we must */
+static int
+WAVStream_ReadBlocks(SDL_WAVStream * wav, Uint32 block, void *buf, Uint32 count)
+{
+    const Sint64 offset = wav->data_start + ((Sint64) block) * wav->block_size;
+    size_t got;
+
+    if (wav->src_pos != offset) {
+        if (SDL_RWseek(wav->src, offset, RW_SEEK_SET) < 0) {
+            wav->src_pos = -1;
+            return -1;
+        }
+        wav->src_pos = offset;
+    }
+
+    got = SDL_RWread(wav->src, buf, wav->block_size, count);
+    wav->src_pos += ((Sint64) got) * wav->block_size;
+    if (got != count) {
+        wav->src_pos = -1;      /* we may have read part of a block. */
+        return SDL_SetError("Unexpected end of WAVE data");
+    }
+    return 0;
+}
+
+/* Make some of the audio at the current position available in the
+   decoded buffer, and return how many sample frames (up to max) it holds. */
+static int
+WAVStream_Fill(SDL_WAVStream * wav, Uint32 max, Uint8 ** data)
+{
+    Uint32 frames;
+
+    if (wav->block_frames == 1) {
+        frames = SDL_min(max, wav->decoded_frames);
+        if (WAVStream_ReadBlocks(wav, wav->position, wav->decoded, frames) < 0) {
+            return -1;
+        }
+        *data = wav->decoded;
+    } else {
+        const Uint32 block = wav->position / wav->block_frames;
+        const Uint32 skip = wav->position % wav->block_frames;
+
+        if (block != wav->decoded_block) {
+            wav->decoded_block = 0xFFFFFFFF;
+            if (WAVStream_ReadBlocks(wav, block, wav->block, 1) < 0) {
+                return -1;
+            }
+            if (wav->info.encoding == MS_ADPCM_CODE) {
+                if (MS_ADPCM_decode_block(&wav->info.adpcm.ms, wav->block, wav->decoded) < 0) {
+                    return -1;
+                }
+            } else {
+                IMA_ADPCM_decode_block(&wav->info.adpcm.ima, wav->block, wav->decoded);
+            }
+            wav->decoded_block = block;
+        }
+        frames = SDL_min(max, wav->block_frames - skip);
+        *data = wav->decoded + skip * wav->frame_size;
+    }
+    return (int) frames;
+}
+
+int
+SDL_WAVStreamRead(SDL_WAVStream * wav, void *buf, int len)
+{
+    Uint8 *dst = (Uint8 *) buf;
+    Uint32 frames, left;
+
+    if (wav == NULL) {
+        return SDL_InvalidParamError("wav");
+    } else if (buf == NULL) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    left = SDL_min((Uint32) len / wav->frame_size, wav->length - wav->position);
+    frames = left;
+    if (wav->block_frames == 1) {
+        /* PCM goes straight from the file into the caller's buffer. */
+        if (WAVStream_ReadBlocks(wav, wav->position, dst, frames) < 0) {
+            return -1;
+        }
+        wav->position += frames;
+        left = 0;
+    }
+    while (left > 0) {
+        Uint8 *data;
+        const int got = WAVStream_Fill(wav, left, &data);
+        if (got < 0) {
+            return -1;
+        }
+        SDL_memcpy(dst, data, got * wav->frame_size);
+        dst += got * wav->frame_size;
+        wav->position += got;
+        left -= got;
+    }
+    return (int) (frames * wav->frame_size);
+}
+
+int
+SDL_WAVStreamPutMixerVoice(SDL_WAVStream * wav, SDL_AudioMixer * mixer,
+                           int voice, int len)
+{
+    Uint32 frames, left;
+
+    if (wav == NULL) {
+        return SDL_InvalidParamError("wav");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    left = SDL_min((Uint32) len / wav->frame_size, wav->length - wav->position);
+    frames = left;
+    while (left > 0) {
+        Uint8 *data;
+        const int got = WAVStream_Fill(wav, left, &data);
+        if (got < 0) {
+            return -1;
+        }
+        if (SDL_AudioMixerPutVoice(mixer, voice, data, got * wav->frame_size) < 0) {
+            return -1;
+        }
+        wav->position += got;
+        left -= got;
+    }
+    return (int) (frames * wav->frame_size);
+}
+
+void
+SDL_CloseWAVStream(SDL_WAVStream * wav)
+{
+    if (wav) {
+        if (wav->freesrc) {
+            SDL_RWclose(wav->src);
+        }
+        SDL_free(wav->block);
+        SDL_free(wav->decoded);
+        SDL_free(wav);
+    }
+}
+
 /* Since the WAV memory is allocated in the shared library, it must also
    be freed here.  (Necessary under Win32, VC++)
  */
@@ -353,6 +353,9 @@ ALSA_PlayDevice(_THIS)
                 SDL_Delay(1);
                 continue;
             }
+            if (status == -EPIPE) {
+                SDL_AudioDeviceUnderrun(this);
+            }
             status = ALSA_snd_pcm_recover(this->hidden->pcm_handle, status, 0);
             if (status < 0) {
                 /* Hmm, not much we can do - abort */
@@ -47,7 +47,7 @@
 static void
 DISKAUDIO_WaitDevice(_THIS)
 {
-    SDL_Delay(this->hidden->io_delay);
+    SDL_SimulatedWaitDevice(this, ((Uint64) this->hidden->io_delay) * 1000000);
 }
 
 static void
@@ -61,6 +61,8 @@ DISKAUDIO_PlayDevice(_THIS)
     if (written != this->spec.size) {
         SDL_OpenedAudioDeviceDisconnected(this);
     }
+
+    SDL_SimulatedPlayDevice(this, ((Uint64) this->hidden->io_delay) * 1000000);
 #ifdef DEBUG_AUDIO
     fprintf(stderr, "Wrote %d bytes of audio data\n", written);
 #endif
@@ -30,9 +30,55 @@
 static int
 DUMMYAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
 {
+    this->hidden = (struct SDL_PrivateAudioData *)
+        SDL_calloc(1, sizeof (*this->hidden));
+    if (this->hidden == NULL) {
+        return SDL_OutOfMemory();
+    }
+
+    /* Playback goes to a buffer that we play in (simulated) real time. */
+    if (!iscapture) {
+        this->hidden->mixlen = this->spec.size;
+        this->hidden->mixbuf = (Uint8 *) SDL_malloc(this->hidden->mixlen);
+        if (this->hidden->mixbuf == NULL) {
+            return SDL_OutOfMemory();
+        }
+    }
+
     return 0;                   /* always succeeds. */
 }
 
+static Uint64
+DUMMYAUDIO_BufferPeriod(_THIS)
+{
+    return (((Uint64) this->spec.samples) * 1000000000) / this->spec.freq;
+}
+
+static void
+DUMMYAUDIO_WaitDevice(_THIS)
+{
+    SDL_SimulatedWaitDevice(this, DUMMYAUDIO_BufferPeriod(this));
+}
+
+static void
+DUMMYAUDIO_PlayDevice(_THIS)
+{
+    SDL_SimulatedPlayDevice(this, DUMMYAUDIO_BufferPeriod(this));
+}
+
+static Uint8 *
+DUMMYAUDIO_GetDeviceBuf(_THIS)
+{
+    return this->hidden->mixbuf;
+}
+
+static void
+DUMMYAUDIO_CloseDevice(_THIS)
+{
+    SDL_free(this->hidden->mixbuf);
+    SDL_free(this->hidden);
+}
+
 static int
 DUMMYAUDIO_CaptureFromDevice(_THIS, void *buffer, int buflen)
 {
@@ -49,6 +95,10 @@ DUMMYAUDIO_Init(SDL_AudioDriverImpl * impl)
 {
     /* Set the function pointers */
     impl->OpenDevice = DUMMYAUDIO_OpenDevice;
+    impl->WaitDevice = DUMMYAUDIO_WaitDevice;
+    impl->PlayDevice = DUMMYAUDIO_PlayDevice;
+    impl->GetDeviceBuf = DUMMYAUDIO_GetDeviceBuf;
+    impl->CloseDevice = DUMMYAUDIO_CloseDevice;
     impl->CaptureFromDevice = DUMMYAUDIO_CaptureFromDevice;
 
     impl->OnlyHasDefaultOutputDevice = 1;
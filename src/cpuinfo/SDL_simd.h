@@ -0,0 +1,59 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef SDL_simd_h_
+#define SDL_simd_h_
+
+#include "SDL_cpuinfo.h"
+
+/* SIMD code paths for instruction sets newer than what the library as a
+   whole is built for. With GCC and Clang these functions are marked with
+   SDL_TARGETING("...") so they can be compiled without changing the
+   compiler flags for everything else, and callers must check the matching
+   SDL_Has*() function before using them. */
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define SDL_TARGETING(x) __attribute__((target(x)))
+#include <immintrin.h>
+#define HAVE_SSSE3_INTRINSICS 1
+#define HAVE_SSE41_INTRINSICS 1
+#define HAVE_AVX2_INTRINSICS 1
+#elif defined(_MSC_VER) && (_MSC_VER >= 1700) && (defined(_M_IX86) || defined(_M_X64))
+#include <immintrin.h>
+#define HAVE_SSSE3_INTRINSICS 1
+#define HAVE_SSE41_INTRINSICS 1
+#define HAVE_AVX2_INTRINSICS 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+#ifndef SDL_TARGETING
+#define SDL_TARGETING(x)
+#endif
+
+#endif /* SDL_simd_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -631,3 +631,34 @@
 #define SDL_Vulkan_GetInstanceExtensions SDL_Vulkan_GetInstanceExtensions_REAL
 #define SDL_Vulkan_CreateSurface SDL_Vulkan_CreateSurface_REAL
 #define SDL_Vulkan_GetDrawableSize SDL_Vulkan_GetDrawableSize_REAL
+#define SDL_PushEvents SDL_PushEvents_REAL
+#define SDL_GetEventQueueStats SDL_GetEventQueueStats_REAL
+#define SDL_GetEventPushCount SDL_GetEventPushCount_REAL
+#define SDL_ResetEventQueueStats SDL_ResetEventQueueStats_REAL
+#define SDL_AddTimerNS SDL_AddTimerNS_REAL
+#define SDL_GetTimerStats SDL_GetTimerStats_REAL
+#define SDL_ReserveQueuedAudio SDL_ReserveQueuedAudio_REAL
+#define SDL_CommitQueuedAudio SDL_CommitQueuedAudio_REAL
+#define SDL_PeekQueuedAudio SDL_PeekQueuedAudio_REAL
+#define SDL_ReleaseQueuedAudio SDL_ReleaseQueuedAudio_REAL
+#define SDL_NewAudioMixer SDL_NewAudioMixer_REAL
+#define SDL_AudioMixerAddVoice SDL_AudioMixerAddVoice_REAL
+#define SDL_AudioMixerRemoveVoice SDL_AudioMixerRemoveVoice_REAL
+#define SDL_AudioMixerSetVoiceGain SDL_AudioMixerSetVoiceGain_REAL
+#define SDL_AudioMixerPutVoice SDL_AudioMixerPutVoice_REAL
+#define SDL_AudioMixerClearVoice SDL_AudioMixerClearVoice_REAL
+#define SDL_AudioMixerVoiceAvailable SDL_AudioMixerVoiceAvailable_REAL
+#define SDL_AudioMixerGet SDL_AudioMixerGet_REAL
+#define SDL_FreeAudioMixer SDL_FreeAudioMixer_REAL
+#define SDL_OpenAudioDeviceRing SDL_OpenAudioDeviceRing_REAL
+#define SDL_GetAudioRingStatus SDL_GetAudioRingStatus_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_ResetAudioDeviceStats SDL_ResetAudioDeviceStats_REAL
+#define SDL_OpenWAVStream_RW SDL_OpenWAVStream_RW_REAL
+#define SDL_WAVStreamLength SDL_WAVStreamLength_REAL
+#define SDL_WAVStreamTell SDL_WAVStreamTell_REAL
+#define SDL_WAVStreamSeek SDL_WAVStreamSeek_REAL
+#define SDL_WAVStreamRead SDL_WAVStreamRead_REAL
+#define SDL_WAVStreamPutMixerVoice SDL_WAVStreamPutMixerVoice_REAL
+#define SDL_CloseWAVStream SDL_CloseWAVStream_REAL
+#define SDL_SoftStretchLinear SDL_SoftStretchLinear_REAL
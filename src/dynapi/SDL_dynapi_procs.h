@@ -663,3 +663,34 @@ SDL_DYNAPI_PROC(void,SDL_Vulkan_UnloadLibrary,(void),(),)
 SDL_DYNAPI_PROC(SDL_bool,SDL_Vulkan_GetInstanceExtensions,(SDL_Window *a, unsigned *b, const char **c),(a,b,c),return)
 SDL_DYNAPI_PROC(SDL_bool,SDL_Vulkan_CreateSurface,(SDL_Window *a, VkInstance b, VkSurfaceKHR *c),(a,b,c),return)
 SDL_DYNAPI_PROC(void,SDL_Vulkan_GetDrawableSize,(SDL_Window *a, int *b, int *c),(a,b,c),)
+SDL_DYNAPI_PROC(int,SDL_PushEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetEventQueueStats,(SDL_EventQueueStats *a),(a),return)
+SDL_DYNAPI_PROC(Uint32,SDL_GetEventPushCount,(Uint32 a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ResetEventQueueStats,(void),(),)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerNS,(Uint64 a, SDL_NSTimerCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GetTimerStats,(SDL_TimerID a, SDL_TimerStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void*,SDL_ReserveQueuedAudio,(SDL_AudioDeviceID a, Uint32 *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_CommitQueuedAudio,(SDL_AudioDeviceID a, Uint32 b),(a,b),return)
+SDL_DYNAPI_PROC(const void*,SDL_PeekQueuedAudio,(SDL_AudioDeviceID a, Uint32 *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_ReleaseQueuedAudio,(SDL_AudioDeviceID a, Uint32 b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AudioMixer*,SDL_NewAudioMixer,(SDL_AudioFormat a, Uint8 b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerAddVoice,(SDL_AudioMixer *a, SDL_AudioFormat b, Uint8 c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerRemoveVoice,(SDL_AudioMixer *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerSetVoiceGain,(SDL_AudioMixer *a, int b, float c, float d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerPutVoice,(SDL_AudioMixer *a, int b, const void *c, Uint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerClearVoice,(SDL_AudioMixer *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerVoiceAvailable,(SDL_AudioMixer *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerGet,(SDL_AudioMixer *a, void *b, Uint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_FreeAudioMixer,(SDL_AudioMixer *a),(a),)
+SDL_DYNAPI_PROC(SDL_AudioDeviceID,SDL_OpenAudioDeviceRing,(const char *a, int b, const SDL_AudioSpec *c, SDL_AudioSpec *d, int e, Uint32 f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioRingStatus,(SDL_AudioDeviceID a, SDL_AudioRingStatus *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a, SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetAudioDeviceStats,(SDL_AudioDeviceID a),(a),)
+SDL_DYNAPI_PROC(SDL_WAVStream*,SDL_OpenWAVStream_RW,(SDL_RWops *a, int b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Uint32,SDL_WAVStreamLength,(SDL_WAVStream *a),(a),return)
+SDL_DYNAPI_PROC(Uint32,SDL_WAVStreamTell,(SDL_WAVStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_WAVStreamSeek,(SDL_WAVStream *a, Uint32 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_WAVStreamRead,(SDL_WAVStream *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_WAVStreamPutMixerVoice,(SDL_WAVStream *a, SDL_AudioMixer *b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_CloseWAVStream,(SDL_WAVStream *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_SoftStretchLinear,(SDL_Surface *a, const SDL_Rect *b, SDL_Surface *c, const SDL_Rect *d),(a,b,c,d),return)
@@ -24,6 +24,7 @@
 
 #include "SDL.h"
 #include "SDL_events.h"
+#include "SDL_bits.h"
 #include "SDL_syswm.h"
 #include "SDL_thread.h"
 #include "SDL_events_c.h"
@@ -56,16 +57,61 @@ typedef struct {
 
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static Uint32 SDL_userevents = SDL_USEREVENT;
+static SDL_bool SDL_coalesce_events = SDL_FALSE;
+
+typedef struct {
+    Uint32 counts[256];
+} SDL_EventCountBlock;
+
+/* Event queue statistics -- only touched with the queue locked */
+static struct
+{
+    Uint64 frequency;
+    Uint32 pushed;
+    Uint32 coalesced;
+    Uint32 dropped;
+    Uint32 latency[SDL_EVENT_LATENCY_BUCKETS];
+    SDL_EventCountBlock *pushed_by_type[256];
+} SDL_EventStats;
 
 /* Private data -- event queue */
 typedef struct _SDL_EventEntry
 {
     SDL_Event event;
     SDL_SysWMmsg msg;
+    Uint32 serial;
+    Uint64 timestamp;
     struct _SDL_EventEntry *prev;
     struct _SDL_EventEntry *next;
+    struct _SDL_EventEntry *type_prev;
+    struct _SDL_EventEntry *type_next;
 } SDL_EventEntry;
 
+/* Every queued event is also linked into a list for its category, which is
+   the high byte of the event type (SDL_KEYDOWN and SDL_KEYUP share one,
+   all the mouse events share another, etc.) This lets range queries and
+   flushes skip over the events they aren't interested in.
+ */
+#define SDL_EVENT_CATEGORIES    256
+
+typedef struct
+{
+    SDL_EventEntry *head;
+    SDL_EventEntry *tail;
+    int count;
+} SDL_EventCategory;
+
+/* Queue entries are allocated a slab at a time and recycled through the
+   free list, so a busy queue doesn't call SDL_malloc() per event.
+ */
+#define SDL_EVENT_SLAB_ENTRIES  128
+
+typedef struct _SDL_EventSlab
+{
+    SDL_EventEntry entries[SDL_EVENT_SLAB_ENTRIES];
+    struct _SDL_EventSlab *next;
+} SDL_EventSlab;
+
 typedef struct _SDL_SysWMEntry
 {
     SDL_SysWMmsg msg;
@@ -81,9 +127,51 @@ static struct
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
+    SDL_EventSlab *slabs;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+    Uint32 serial;
+    SDL_EventCategory categories[SDL_EVENT_CATEGORIES];
+} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL, NULL };
+
+/* User events can have types past SDL_LASTEVENT, those share the last category */
+#define SDL_EventCategoryOf(type) \
+    ((int)(((type) > SDL_LASTEVENT) ? (SDL_EVENT_CATEGORIES-1) : ((type) >> 8)))
+
+/* Producers stage events in a bounded lock-free ring, which is drained into
+   the event queue whenever the queue lock is held. This keeps threads calling
+   SDL_PushEvent() from contending with the thread polling for events.
+
+   The number of entries must be a power of 2.
+ */
+#define SDL_EVENT_RING_ENTRIES  1024
+#define SDL_EVENT_RING_MASK     (SDL_EVENT_RING_ENTRIES-1)
+
+typedef struct
+{
+    SDL_atomic_t sequence;
+    SDL_Event event;
+    Uint64 timestamp;
+} SDL_EventRingEntry;
+
+static struct
+{
+    SDL_atomic_t ready;
+
+    char cache_pad1[SDL_CACHELINE_SIZE-sizeof(SDL_atomic_t)];
+
+    SDL_atomic_t enqueue_pos;
+
+    char cache_pad2[SDL_CACHELINE_SIZE-sizeof(SDL_atomic_t)];
+
+    /* Only changed with the event queue locked, producers read it to count
+       the staged events */
+    SDL_atomic_t dequeue_pos;
+
+    char cache_pad3[SDL_CACHELINE_SIZE-sizeof(SDL_atomic_t)];
+
+    SDL_EventRingEntry entries[SDL_EVENT_RING_ENTRIES];
+} SDL_EventRing;
 
 
 #ifdef SDL_DEBUG_EVENTS
@@ -310,6 +398,321 @@ SDL_DebugPrintEvent(const SDL_Event *event)
 
 
 
+/* Stage an event in the lock-free ring, returns SDL_FALSE if it has to go
+   through the locked path instead.
+
+   The entry sequence numbers are read and written directly with barriers
+   rather than with SDL_AtomicGet()/SDL_AtomicSet(), so the only locked
+   operation on this path is claiming the queue position.
+ */
+static SDL_bool
+SDL_EnqueueEventRing(const SDL_Event *event)
+{
+    SDL_EventRingEntry *entry;
+    unsigned queue_pos;
+    unsigned dequeue_pos;
+    unsigned entry_seq;
+    int delta;
+
+    if (!SDL_EventRing.ready.value) {
+        return SDL_FALSE;
+    }
+
+    /* The window manager message is stored alongside the queue entry */
+    if (event->type == SDL_SYSWMEVENT) {
+        return SDL_FALSE;
+    }
+
+    queue_pos = (unsigned)SDL_EventRing.enqueue_pos.value;
+    for ( ; ; ) {
+        entry = &SDL_EventRing.entries[queue_pos & SDL_EVENT_RING_MASK];
+        entry_seq = (unsigned)entry->sequence.value;
+        SDL_MemoryBarrierAcquire();
+
+        delta = (int)(entry_seq - queue_pos);
+        if (delta == 0) {
+            /* Events staged ahead of this one count against the queue limit
+               too, let the locked path report a full queue. The drain adds
+               to the queue count before it moves dequeue_pos, so this can
+               only overestimate. */
+            dequeue_pos = (unsigned)SDL_EventRing.dequeue_pos.value;
+            SDL_MemoryBarrierAcquire();
+            if (SDL_EventQ.count.value + (int)(queue_pos - dequeue_pos) >= SDL_MAX_QUEUED_EVENTS) {
+                return SDL_FALSE;
+            }
+
+            /* The entry and the queue position match, try to increment the queue position */
+            if (SDL_AtomicCAS(&SDL_EventRing.enqueue_pos, (int)queue_pos, (int)(queue_pos+1))) {
+                /* We own the entry, fill it! */
+                entry->event = *event;
+                entry->timestamp = SDL_GetPerformanceCounter();
+                SDL_MemoryBarrierRelease();
+                entry->sequence.value = (int)(queue_pos+1);
+                return SDL_TRUE;
+            }
+        } else if (delta < 0) {
+            /* The ring is full, it needs to be drained by the locked path */
+            return SDL_FALSE;
+        }
+        /* Another thread got here first, get the new queue position */
+        queue_pos = (unsigned)SDL_EventRing.enqueue_pos.value;
+    }
+}
+
+/* Count an event entering the queue -- called with the queue locked */
+static void
+SDL_CountPushedEvent(Uint32 type)
+{
+    Uint8 hi = ((type >> 8) & 0xff);
+    Uint8 lo = (type & 0xff);
+
+    ++SDL_EventStats.pushed;
+
+    if (!SDL_EventStats.pushed_by_type[hi]) {
+        SDL_EventStats.pushed_by_type[hi] = (SDL_EventCountBlock *) SDL_calloc(1, sizeof(SDL_EventCountBlock));
+        if (!SDL_EventStats.pushed_by_type[hi]) {
+            /* Out of memory, nothing we can do... */
+            return;
+        }
+    }
+    ++SDL_EventStats.pushed_by_type[hi]->counts[lo];
+}
+
+/* Get a queue entry holding a copy of the event -- called with the queue locked */
+static SDL_EventEntry *
+SDL_NewEventEntry(const SDL_Event *event, Uint64 timestamp)
+{
+    SDL_EventEntry *entry;
+    SDL_EventSlab *slab;
+    int i;
+
+    if (SDL_EventQ.free == NULL) {
+        slab = (SDL_EventSlab *)SDL_malloc(sizeof(*slab));
+        if (!slab) {
+            return NULL;
+        }
+        slab->next = SDL_EventQ.slabs;
+        SDL_EventQ.slabs = slab;
+        for (i = 0; i < SDL_EVENT_SLAB_ENTRIES; ++i) {
+            slab->entries[i].next = SDL_EventQ.free;
+            SDL_EventQ.free = &slab->entries[i];
+        }
+    }
+    entry = SDL_EventQ.free;
+    SDL_EventQ.free = entry->next;
+
+    #ifdef SDL_DEBUG_EVENTS
+    SDL_DebugPrintEvent(event);
+    #endif
+
+    entry->event = *event;
+    if (event->type == SDL_SYSWMEVENT) {
+        entry->msg = *event->syswm.msg;
+        entry->event.syswm.msg = &entry->msg;
+    }
+    entry->timestamp = timestamp;
+
+    SDL_CountPushedEvent(event->type);
+
+    return entry;
+}
+
+/* Returns SDL_TRUE if every type in the category falls in [minType, maxType] */
+static SDL_bool
+SDL_EventCategoryInRange(int category, Uint32 minType, Uint32 maxType)
+{
+    const Uint32 first = ((Uint32)category << 8);
+    const Uint32 last = (category == SDL_EVENT_CATEGORIES-1) ? 0xFFFFFFFF : (first | 0xFF);
+
+    return (minType <= first && last <= maxType);
+}
+
+/* Add a queued entry to the tail of its category -- called with the queue locked */
+static void
+SDL_LinkEventCategory(SDL_EventEntry *entry)
+{
+    SDL_EventCategory *category = &SDL_EventQ.categories[SDL_EventCategoryOf(entry->event.type)];
+
+    entry->serial = SDL_EventQ.serial++;
+    entry->type_next = NULL;
+    entry->type_prev = category->tail;
+    if (category->tail) {
+        category->tail->type_next = entry;
+    } else {
+        category->head = entry;
+    }
+    category->tail = entry;
+    ++category->count;
+}
+
+static void SDLCALL
+SDL_EventCoalescingChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_coalesce_events = (hint && *hint != '0') ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Merge an event into the most recently queued one if it only updates it,
+   returns SDL_TRUE if the event was merged -- called with the queue locked
+ */
+static SDL_bool
+SDL_CoalesceEvent(SDL_EventEntry *queued, const SDL_Event *event)
+{
+    SDL_Event *last;
+
+    if (!SDL_coalesce_events || !queued || queued->event.type != event->type) {
+        return SDL_FALSE;
+    }
+
+    last = &queued->event;
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+        if (last->motion.windowID != event->motion.windowID ||
+            last->motion.which != event->motion.which ||
+            last->motion.state != event->motion.state) {
+            return SDL_FALSE;
+        }
+        last->motion.x = event->motion.x;
+        last->motion.y = event->motion.y;
+        last->motion.xrel += event->motion.xrel;
+        last->motion.yrel += event->motion.yrel;
+        break;
+
+    case SDL_WINDOWEVENT:
+        if (last->window.windowID != event->window.windowID ||
+            last->window.event != event->window.event) {
+            return SDL_FALSE;
+        }
+        switch (event->window.event) {
+        case SDL_WINDOWEVENT_MOVED:
+        case SDL_WINDOWEVENT_RESIZED:
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+            last->window.data1 = event->window.data1;
+            last->window.data2 = event->window.data2;
+            break;
+        default:
+            return SDL_FALSE;
+        }
+        break;
+
+    case SDL_JOYAXISMOTION:
+        if (last->jaxis.which != event->jaxis.which ||
+            last->jaxis.axis != event->jaxis.axis) {
+            return SDL_FALSE;
+        }
+        last->jaxis.value = event->jaxis.value;
+        break;
+
+    case SDL_JOYBALLMOTION:
+        if (last->jball.which != event->jball.which ||
+            last->jball.ball != event->jball.ball) {
+            return SDL_FALSE;
+        }
+        last->jball.xrel += event->jball.xrel;
+        last->jball.yrel += event->jball.yrel;
+        break;
+
+    case SDL_CONTROLLERAXISMOTION:
+        if (last->caxis.which != event->caxis.which ||
+            last->caxis.axis != event->caxis.axis) {
+            return SDL_FALSE;
+        }
+        last->caxis.value = event->caxis.value;
+        break;
+
+    default:
+        return SDL_FALSE;
+    }
+
+    last->common.timestamp = event->common.timestamp;
+
+    /* The merged event keeps the time the first one was queued */
+    SDL_CountPushedEvent(event->type);
+    ++SDL_EventStats.coalesced;
+    return SDL_TRUE;
+}
+
+/* Append an event to the tail of the queue -- called with the queue locked */
+static SDL_bool
+SDL_AppendEvent(const SDL_Event *event, Uint64 timestamp)
+{
+    SDL_EventEntry *entry = SDL_NewEventEntry(event, timestamp);
+
+    if (!entry) {
+        return SDL_FALSE;
+    }
+
+    if (SDL_EventQ.tail) {
+        SDL_EventQ.tail->next = entry;
+        entry->prev = SDL_EventQ.tail;
+        SDL_EventQ.tail = entry;
+        entry->next = NULL;
+    } else {
+        SDL_assert(!SDL_EventQ.head);
+        SDL_EventQ.head = entry;
+        SDL_EventQ.tail = entry;
+        entry->prev = NULL;
+        entry->next = NULL;
+    }
+    SDL_LinkEventCategory(entry);
+    return SDL_TRUE;
+}
+
+/* Move staged events from the ring into the queue -- called with the queue locked
+
+   If wait_for_writers is set, this also waits for entries that have been
+   claimed but not yet filled, so an event appended afterwards is guaranteed
+   to come after every event staged before this call.
+ */
+static void
+SDL_DrainEventRing(SDL_bool wait_for_writers)
+{
+    SDL_EventRingEntry *entry;
+    unsigned queue_pos = (unsigned)SDL_EventRing.dequeue_pos.value;
+    unsigned end_pos = queue_pos;
+    int added = 0;
+    int count;
+
+    if (wait_for_writers) {
+        end_pos = (unsigned)SDL_EventRing.enqueue_pos.value;
+    }
+
+    for ( ; ; ) {
+        entry = &SDL_EventRing.entries[queue_pos & SDL_EVENT_RING_MASK];
+        if ((int)((unsigned)entry->sequence.value - (queue_pos+1)) < 0) {
+            if ((int)(end_pos - queue_pos) > 0) {
+                /* Another thread is still filling this entry */
+                SDL_Delay(0);
+                continue;
+            }
+            /* We've hit empty, or an entry that hasn't been filled yet */
+            break;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        if (SDL_CoalesceEvent(SDL_EventQ.tail, &entry->event)) {
+            /* Merged into the last queued event */
+        } else if (SDL_AppendEvent(&entry->event, entry->timestamp)) {
+            ++added;
+        } else {
+            /* Out of memory, the event is lost */
+            ++SDL_EventStats.dropped;
+        }
+        SDL_MemoryBarrierRelease();
+        entry->sequence.value = (int)(queue_pos+SDL_EVENT_RING_ENTRIES);
+        ++queue_pos;
+    }
+
+    /* Count the events before they stop being staged, see SDL_EnqueueEventRing() */
+    if (added > 0) {
+        count = SDL_AtomicAdd(&SDL_EventQ.count, added) + added;
+        if (count > SDL_EventQ.max_events_seen) {
+            SDL_EventQ.max_events_seen = count;
+        }
+    }
+    SDL_MemoryBarrierRelease();
+    SDL_EventRing.dequeue_pos.value = (int)queue_pos;
+}
+
 /* Public functions */
 
 void
@@ -317,7 +720,7 @@ SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
     int i;
-    SDL_EventEntry *entry;
+    SDL_EventSlab *slab;
     SDL_SysWMEntry *wmmsg;
 
     if (SDL_EventQ.lock) {
@@ -326,21 +729,23 @@ SDL_StopEventLoop(void)
 
     SDL_AtomicSet(&SDL_EventQ.active, 0);
 
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
+
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
                 SDL_EventQ.max_events_seen);
+        SDL_Log("SDL EVENT QUEUE: Events pushed: %u, coalesced: %u, dropped: %u\n",
+                (unsigned int) SDL_EventStats.pushed,
+                (unsigned int) SDL_EventStats.coalesced,
+                (unsigned int) SDL_EventStats.dropped);
     }
 
     /* Clean out EventQ */
-    for (entry = SDL_EventQ.head; entry; ) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
-        entry = next;
-    }
-    for (entry = SDL_EventQ.free; entry; ) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
-        entry = next;
+    SDL_DrainEventRing(SDL_FALSE);
+    for (slab = SDL_EventQ.slabs; slab; ) {
+        SDL_EventSlab *next = slab->next;
+        SDL_free(slab);
+        slab = next;
     }
     for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; ) {
         SDL_SysWMEntry *next = wmmsg->next;
@@ -358,8 +763,10 @@ SDL_StopEventLoop(void)
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
+    SDL_EventQ.slabs = NULL;
     SDL_EventQ.wmmsg_used = NULL;
     SDL_EventQ.wmmsg_free = NULL;
+    SDL_zero(SDL_EventQ.categories);
 
     /* Clear disabled event state */
     for (i = 0; i < SDL_arraysize(SDL_disabled_events); ++i) {
@@ -367,6 +774,12 @@ SDL_StopEventLoop(void)
         SDL_disabled_events[i] = NULL;
     }
 
+    /* Clear statistics */
+    for (i = 0; i < SDL_arraysize(SDL_EventStats.pushed_by_type); ++i) {
+        SDL_free(SDL_EventStats.pushed_by_type[i]);
+    }
+    SDL_zero(SDL_EventStats);
+
     while (SDL_event_watchers) {
         SDL_EventWatcher *tmp = SDL_event_watchers;
         SDL_event_watchers = tmp->next;
@@ -401,6 +814,22 @@ SDL_StartEventLoop(void)
     }
 #endif /* !SDL_THREADS_DISABLED */
 
+    /* Set up the staging ring, it stays consistent across restarts */
+    if (!SDL_AtomicGet(&SDL_EventRing.ready)) {
+        int i;
+
+        for (i = 0; i < SDL_EVENT_RING_ENTRIES; ++i) {
+            SDL_AtomicSet(&SDL_EventRing.entries[i].sequence, i);
+        }
+        SDL_AtomicSet(&SDL_EventRing.enqueue_pos, 0);
+        SDL_AtomicSet(&SDL_EventRing.dequeue_pos, 0);
+        SDL_AtomicSet(&SDL_EventRing.ready, 1);
+    }
+
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
+
+    SDL_EventStats.frequency = SDL_GetPerformanceFrequency();
+
     /* Process most event types */
     SDL_EventState(SDL_TEXTINPUT, SDL_DISABLE);
     SDL_EventState(SDL_TEXTEDITING, SDL_DISABLE);
@@ -416,46 +845,26 @@ SDL_StartEventLoop(void)
 static int
 SDL_AddEvent(SDL_Event * event)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
+    int initial_count;
     int final_count;
 
+    /* Keep staged events ahead of this one */
+    SDL_DrainEventRing(SDL_TRUE);
+
+    initial_count = SDL_AtomicGet(&SDL_EventQ.count);
     if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
         SDL_SetError("Event queue is full (%d events)", initial_count);
+        ++SDL_EventStats.dropped;
         return 0;
     }
 
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (!entry) {
-            return 0;
-        }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
+    if (SDL_CoalesceEvent(SDL_EventQ.tail, event)) {
+        return 1;
     }
 
-    #ifdef SDL_DEBUG_EVENTS
-    SDL_DebugPrintEvent(event);
-    #endif
-
-    entry->event = *event;
-    if (event->type == SDL_SYSWMEVENT) {
-        entry->msg = *event->syswm.msg;
-        entry->event.syswm.msg = &entry->msg;
-    }
-
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
-        entry->next = NULL;
-    } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
-        entry->prev = NULL;
-        entry->next = NULL;
+    if (!SDL_AppendEvent(event, SDL_GetPerformanceCounter())) {
+        ++SDL_EventStats.dropped;
+        return 0;
     }
 
     final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
@@ -466,10 +875,18 @@ SDL_AddEvent(SDL_Event * event)
     return 1;
 }
 
-/* Remove an event from the queue -- called with the queue locked */
+/* Remove an event from the queue -- called with the queue locked
+
+   The time it spent queued is recorded against now, a performance counter
+   value read once by the caller for a whole batch of removals.
+ */
 static void
-SDL_CutEvent(SDL_EventEntry *entry)
+SDL_CutEvent(SDL_EventEntry *entry, Uint64 now)
 {
+    SDL_EventCategory *category;
+    Uint64 usec;
+    int bucket;
+
     if (entry->prev) {
         entry->prev->next = entry->next;
     }
@@ -486,12 +903,159 @@ SDL_CutEvent(SDL_EventEntry *entry)
         SDL_EventQ.tail = entry->prev;
     }
 
+    category = &SDL_EventQ.categories[SDL_EventCategoryOf(entry->event.type)];
+    if (entry->type_prev) {
+        entry->type_prev->type_next = entry->type_next;
+    } else {
+        SDL_assert(entry == category->head);
+        category->head = entry->type_next;
+    }
+    if (entry->type_next) {
+        entry->type_next->type_prev = entry->type_prev;
+    } else {
+        SDL_assert(entry == category->tail);
+        category->tail = entry->type_prev;
+    }
+    SDL_assert(category->count > 0);
+    --category->count;
+
+    if (SDL_EventStats.frequency) {
+        usec = ((now - entry->timestamp) * 1000000) / SDL_EventStats.frequency;
+        bucket = SDL_MostSignificantBitIndex32((Uint32)SDL_min(usec, 0xFFFFFFFF)) + 1;
+        ++SDL_EventStats.latency[SDL_min(bucket, SDL_EVENT_LATENCY_BUCKETS-1)];
+    }
+
     entry->next = SDL_EventQ.free;
     SDL_EventQ.free = entry;
     SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
     SDL_AtomicAdd(&SDL_EventQ.count, -1);
 }
 
+/* Copy a queued event out, and remove it for SDL_GETEVENT -- called with the queue locked */
+static void
+SDL_TakeEvent(SDL_EventEntry *entry, SDL_Event *event, SDL_eventaction action, Uint64 now)
+{
+    SDL_SysWMEntry *wmmsg;
+
+    *event = entry->event;
+    if (entry->event.type == SDL_SYSWMEVENT) {
+        /* We need to copy the wmmsg somewhere safe.
+           For now we'll guarantee it's valid at least until
+           the next call to SDL_PeepEvents()
+         */
+        if (SDL_EventQ.wmmsg_free) {
+            wmmsg = SDL_EventQ.wmmsg_free;
+            SDL_EventQ.wmmsg_free = wmmsg->next;
+        } else {
+            wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
+        }
+        wmmsg->msg = *entry->event.syswm.msg;
+        wmmsg->next = SDL_EventQ.wmmsg_used;
+        SDL_EventQ.wmmsg_used = wmmsg;
+        event->syswm.msg = &wmmsg->msg;
+    }
+
+    if (action == SDL_GETEVENT) {
+        SDL_CutEvent(entry, now);
+    }
+}
+
+/* Count the queued events in [minType, maxType] -- called with the queue locked */
+static int
+SDL_CountEvents(Uint32 minType, Uint32 maxType)
+{
+    SDL_EventEntry *entry;
+    Uint32 type;
+    int i, count = 0;
+
+    if (minType > maxType) {
+        return 0;
+    }
+    for (i = SDL_EventCategoryOf(minType); i <= SDL_EventCategoryOf(maxType); ++i) {
+        if (SDL_EventQ.categories[i].count == 0) {
+            continue;
+        }
+        if (SDL_EventCategoryInRange(i, minType, maxType)) {
+            count += SDL_EventQ.categories[i].count;
+            continue;
+        }
+        for (entry = SDL_EventQ.categories[i].head; entry; entry = entry->type_next) {
+            type = entry->event.type;
+            if (minType <= type && type <= maxType) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+/* Copy out up to numevents events in [minType, maxType], oldest first, only
+   visiting the categories that overlap the range -- called with the queue locked
+ */
+static int
+SDL_GetEventsInRange(SDL_Event * events, int numevents, SDL_eventaction action,
+                     Uint32 minType, Uint32 maxType)
+{
+    SDL_EventEntry *cursors[SDL_EVENT_CATEGORIES];
+    SDL_EventEntry *entry, *next;
+    SDL_bool whole_queue = SDL_TRUE;
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 type;
+    int num_cursors = 0;
+    int i, best, used = 0;
+
+    if (minType > maxType) {
+        return 0;
+    }
+
+    for (i = 0; i < SDL_EVENT_CATEGORIES; ++i) {
+        if (SDL_EventQ.categories[i].count == 0) {
+            continue;
+        }
+        if (!SDL_EventCategoryInRange(i, minType, maxType)) {
+            whole_queue = SDL_FALSE;
+        }
+        if (i >= SDL_EventCategoryOf(minType) && i <= SDL_EventCategoryOf(maxType)) {
+            cursors[num_cursors++] = SDL_EventQ.categories[i].head;
+        }
+    }
+
+    if (whole_queue) {
+        /* Everything in the queue matches, just walk it in order */
+        for (entry = SDL_EventQ.head; entry && used < numevents; entry = next) {
+            next = entry->next;
+            SDL_TakeEvent(entry, &events[used++], action, now);
+        }
+        return used;
+    }
+
+    /* Merge the matching categories by their position in the queue */
+    while (used < numevents) {
+        best = -1;
+        for (i = 0; i < num_cursors; ++i) {
+            /* Skip the part of a category that falls outside the range */
+            while (cursors[i]) {
+                type = cursors[i]->event.type;
+                if (minType <= type && type <= maxType) {
+                    break;
+                }
+                cursors[i] = cursors[i]->type_next;
+            }
+            if (cursors[i] &&
+                (best < 0 || (Sint32)(cursors[i]->serial - cursors[best]->serial) < 0)) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        entry = cursors[best];
+        cursors[best] = entry->type_next;
+        SDL_TakeEvent(entry, &events[used++], action, now);
+    }
+    return used;
+}
+
 /* Lock the event queue, take a peep at it, and unlock it */
 int
 SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
@@ -507,17 +1071,29 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
         }
         return (-1);
     }
-    /* Lock the event queue */
+
     used = 0;
+    if (action == SDL_ADDEVENT) {
+        /* Most events can be queued without taking the lock */
+        for (i = 0; i < numevents; ++i) {
+            if (!SDL_EnqueueEventRing(&events[i])) {
+                break;
+            }
+            ++used;
+        }
+        if (i == numevents) {
+            return (used);
+        }
+    }
+
+    /* Lock the event queue */
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
         if (action == SDL_ADDEVENT) {
-            for (i = 0; i < numevents; ++i) {
+            for ( ; i < numevents; ++i) {
                 used += SDL_AddEvent(&events[i]);
             }
         } else {
-            SDL_EventEntry *entry, *next;
             SDL_SysWMEntry *wmmsg, *wmmsg_next;
-            Uint32 type;
 
             if (action == SDL_GETEVENT) {
                 /* Clean out any used wmmsg data
@@ -531,35 +1107,12 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
                 SDL_EventQ.wmmsg_used = NULL;
             }
 
-            for (entry = SDL_EventQ.head; entry && (!events || used < numevents); entry = next) {
-                next = entry->next;
-                type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        events[used] = entry->event;
-                        if (entry->event.type == SDL_SYSWMEVENT) {
-                            /* We need to copy the wmmsg somewhere safe.
-                               For now we'll guarantee it's valid at least until
-                               the next call to SDL_PeepEvents()
-                             */
-                            if (SDL_EventQ.wmmsg_free) {
-                                wmmsg = SDL_EventQ.wmmsg_free;
-                                SDL_EventQ.wmmsg_free = wmmsg->next;
-                            } else {
-                                wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
-                            }
-                            wmmsg->msg = *entry->event.syswm.msg;
-                            wmmsg->next = SDL_EventQ.wmmsg_used;
-                            SDL_EventQ.wmmsg_used = wmmsg;
-                            events[used].syswm.msg = &wmmsg->msg;
-                        }
-
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
-                        }
-                    }
-                    ++used;
-                }
+            SDL_DrainEventRing(SDL_FALSE);
+
+            if (events) {
+                used = SDL_GetEventsInRange(events, numevents, action, minType, maxType);
+            } else {
+                used = SDL_CountEvents(minType, maxType);
             }
         }
         if (SDL_EventQ.lock) {
@@ -608,12 +1161,20 @@ SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     /* Lock the event queue */
     if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) == 0) {
         SDL_EventEntry *entry, *next;
+        Uint64 now = SDL_GetPerformanceCounter();
         Uint32 type;
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            type = entry->event.type;
-            if (minType <= type && type <= maxType) {
-                SDL_CutEvent(entry);
+        int i;
+
+        SDL_DrainEventRing(SDL_FALSE);
+
+        /* Only visit the categories that overlap the range */
+        for (i = SDL_EventCategoryOf(minType); minType <= maxType && i <= SDL_EventCategoryOf(maxType); ++i) {
+            for (entry = SDL_EventQ.categories[i].head; entry; entry = next) {
+                next = entry->type_next;
+                type = entry->event.type;
+                if (minType <= type && type <= maxType) {
+                    SDL_CutEvent(entry, now);
+                }
             }
         }
         SDL_UnlockMutex(SDL_EventQ.lock);
@@ -709,6 +1270,120 @@ SDL_PushEvent(SDL_Event * event)
     return 1;
 }
 
+int
+SDL_PushEvents(SDL_Event * events, int numevents)
+{
+    SDL_EventWatcher *curr;
+    SDL_EventEntry *head = NULL;
+    SDL_EventEntry *tail = NULL;
+    SDL_EventEntry *entry;
+    Uint32 timestamp;
+    Uint64 now;
+    int count, used, accepted, i;
+
+    if (!events && numevents > 0) {
+        return SDL_InvalidParamError("events");
+    }
+
+    /* Don't look after we've quit */
+    if (!SDL_AtomicGet(&SDL_EventQ.active)) {
+        return (-1);
+    }
+
+    timestamp = SDL_GetTicks();
+    now = SDL_GetPerformanceCounter();
+
+    if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) < 0) {
+        return SDL_SetError("Couldn't lock event queue");
+    }
+
+    /* Keep staged events ahead of this batch */
+    SDL_DrainEventRing(SDL_TRUE);
+
+    count = SDL_AtomicGet(&SDL_EventQ.count);
+    used = 0;
+    accepted = 0;
+    for (i = 0; i < numevents; ++i) {
+        SDL_Event *event = &events[i];
+
+        event->common.timestamp = timestamp;
+
+        if (SDL_EventOK && !SDL_EventOK(SDL_EventOKParam, event)) {
+            /* The caller can't tell which events these were, so count them */
+            ++SDL_EventStats.dropped;
+            continue;
+        }
+
+        for (curr = SDL_event_watchers; curr; curr = curr->next) {
+            curr->callback(curr->userdata, event);
+        }
+
+        if (SDL_CoalesceEvent(tail ? tail : SDL_EventQ.tail, event)) {
+            ++accepted;
+            continue;
+        }
+
+        if (count + used >= SDL_MAX_QUEUED_EVENTS) {
+            SDL_SetError("Event queue is full (%d events)", count + used);
+            break;
+        }
+
+        entry = SDL_NewEventEntry(event, now);
+        if (!entry) {
+            SDL_OutOfMemory();
+            break;
+        }
+        entry->prev = tail;
+        entry->next = NULL;
+        if (tail) {
+            tail->next = entry;
+        } else {
+            head = entry;
+        }
+        tail = entry;
+        ++used;
+        ++accepted;
+    }
+
+    /* Splice the whole run onto the end of the queue */
+    if (head) {
+        if (SDL_EventQ.tail) {
+            SDL_EventQ.tail->next = head;
+            head->prev = SDL_EventQ.tail;
+        } else {
+            SDL_assert(!SDL_EventQ.head);
+            SDL_EventQ.head = head;
+        }
+        SDL_EventQ.tail = tail;
+
+        for (entry = head; entry; entry = entry->next) {
+            SDL_LinkEventCategory(entry);
+        }
+
+        count = SDL_AtomicAdd(&SDL_EventQ.count, used) + used;
+        if (count > SDL_EventQ.max_events_seen) {
+            SDL_EventQ.max_events_seen = count;
+        }
+
+        for (entry = head; ; entry = entry->next) {
+            SDL_GestureProcessEvent(&entry->event);
+            if (entry == tail) {
+                break;
+            }
+        }
+    }
+
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+
+    /* Report the events that made it in, so they aren't pushed again */
+    if (i < numevents && accepted == 0) {
+        return (-1);
+    }
+    return (accepted);
+}
+
 void
 SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 {
@@ -784,10 +1459,12 @@ SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
 {
     if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) == 0) {
         SDL_EventEntry *entry, *next;
+        Uint64 now = SDL_GetPerformanceCounter();
+        SDL_DrainEventRing(SDL_FALSE);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
-                SDL_CutEvent(entry);
+                SDL_CutEvent(entry, now);
             }
         }
         SDL_UnlockMutex(SDL_EventQ.lock);
@@ -849,6 +1526,87 @@ SDL_RegisterEvents(int numevents)
     return event_base;
 }
 
+int
+SDL_GetEventQueueStats(SDL_EventQueueStats * stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    if (!SDL_AtomicGet(&SDL_EventQ.active)) {
+        return SDL_SetError("The event system has been shut down");
+    }
+
+    if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) < 0) {
+        return SDL_SetError("Couldn't lock event queue");
+    }
+
+    /* Staged events count as queued */
+    SDL_DrainEventRing(SDL_FALSE);
+
+    stats->depth = SDL_AtomicGet(&SDL_EventQ.count);
+    stats->peak_depth = SDL_EventQ.max_events_seen;
+    stats->pushed = SDL_EventStats.pushed;
+    stats->coalesced = SDL_EventStats.coalesced;
+    stats->dropped = SDL_EventStats.dropped;
+    SDL_memcpy(stats->latency, SDL_EventStats.latency, sizeof(stats->latency));
+
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    return 0;
+}
+
+Uint32
+SDL_GetEventPushCount(Uint32 type)
+{
+    Uint8 hi = ((type >> 8) & 0xff);
+    Uint8 lo = (type & 0xff);
+    Uint32 count = 0;
+
+    if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) < 0) {
+        return 0;
+    }
+
+    SDL_DrainEventRing(SDL_FALSE);
+
+    if (SDL_EventStats.pushed_by_type[hi]) {
+        count = SDL_EventStats.pushed_by_type[hi]->counts[lo];
+    }
+
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    return count;
+}
+
+void
+SDL_ResetEventQueueStats(void)
+{
+    int i;
+
+    if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) < 0) {
+        return;
+    }
+
+    SDL_DrainEventRing(SDL_FALSE);
+
+    SDL_EventStats.pushed = 0;
+    SDL_EventStats.coalesced = 0;
+    SDL_EventStats.dropped = 0;
+    SDL_zero(SDL_EventStats.latency);
+    for (i = 0; i < SDL_arraysize(SDL_EventStats.pushed_by_type); ++i) {
+        if (SDL_EventStats.pushed_by_type[i]) {
+            SDL_zerop(SDL_EventStats.pushed_by_type[i]);
+        }
+    }
+    SDL_EventQ.max_events_seen = SDL_AtomicGet(&SDL_EventQ.count);
+
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+}
+
 int
 SDL_SendAppEvent(SDL_EventType eventType)
 {
@@ -549,6 +549,18 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
     return status;
 }
 
+static int
+GetScaleQuality(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+
+    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
+        return 0;
+    } else {
+        return 1;
+    }
+}
+
 static int
 SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
               const SDL_Rect * srcrect, const SDL_FRect * dstrect)
@@ -578,19 +590,8 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
          * to avoid potentially frequent RLE encoding/decoding.
          */
         SDL_SetSurfaceRLE(surface, 0);
-        return SDL_BlitScaled(src, srcrect, surface, &final_rect);
-    }
-}
-
-static int
-GetScaleQuality(void)
-{
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
-
-    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
-        return 0;
-    } else {
-        return 1;
+        return SDL_PrivateUpperBlitScaled(src, srcrect, surface, &final_rect,
+                                          GetScaleQuality() ? SDL_BLITSCALE_LINEAR : SDL_BLITSCALE_NEAREST);
     }
 }
 
@@ -700,7 +701,8 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
             retval = -1;
         } else {
             SDL_SetSurfaceBlendMode(src_clone, SDL_BLENDMODE_NONE);
-            retval = SDL_BlitScaled(src_clone, srcrect, src_scaled, &scale_rect);
+            retval = SDL_PrivateUpperBlitScaled(src_clone, srcrect, src_scaled, &scale_rect,
+                                                GetScaleQuality() ? SDL_BLITSCALE_LINEAR : SDL_BLITSCALE_NEAREST);
             SDL_FreeSurface(src_clone);
             src_clone = src_scaled;
             src_scaled = NULL;
@@ -24,19 +24,56 @@
 #include "SDL_timer_c.h"
 #include "SDL_atomic.h"
 #include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
 #include "../thread/SDL_systhread.h"
 
 /* #define DEBUG_TIMERS */
 
+#define NS_PER_SECOND   1000000000
+
+/* Wait on the semaphore while the next timer is at least this many
+   milliseconds away, so new timers are picked up, and sleep precisely
+   for the rest. */
+#define PRECISE_DELAY_THRESHOLD 2
+
+/* Limits for the number of callback worker threads */
+#define MIN_TIMER_WORKERS   2
+#define MAX_TIMER_WORKERS   8
+
 typedef struct _SDL_Timer
 {
     int timerID;
     SDL_TimerCallback callback;
+    SDL_NSTimerCallback callback_ns;
     void *param;
     Uint32 interval;
-    Uint32 scheduled;
+    Uint64 interval_ns;
+    Uint64 period;      /* interval_ns in performance counter units */
+    Uint64 scheduled;   /* performance counter value of the next deadline */
     SDL_atomic_t canceled;
+
+    /* Statistics, in performance counter units, guarded by the timer data lock */
+    Uint32 fired;
+    Uint32 missed;
+    Uint64 min_lateness;
+    Uint64 max_lateness;
+    Uint64 total_lateness;
+    Uint64 max_duration;
+    Uint64 total_duration;
+
     struct _SDL_Timer *next;
+    struct _SDL_Timer *next_canceled;
+
+    /* Set by a worker thread when the callback wants the timer to run again */
+    SDL_bool reschedule;
+
+    /* State and pairing heap links - these are only touched by the timer thread */
+    SDL_bool queued;
+    SDL_bool dispatched;    /* handed to a worker thread, which owns it until it's done */
+    SDL_bool cancel_seen;   /* on the canceled list while dispatched, free it when it's done */
+    struct _SDL_Timer *child;
+    struct _SDL_Timer *sibling;
+    struct _SDL_Timer *prev;    /* parent if this is the first child, else left sibling */
 } SDL_Timer;
 
 typedef struct _SDL_TimerMap
@@ -46,12 +83,17 @@ typedef struct _SDL_TimerMap
     struct _SDL_TimerMap *next;
 } SDL_TimerMap;
 
-/* The timers are kept in a sorted list */
+#define SDL_TIMERMAP_MIN_BUCKETS    64
+
+/* The timers are kept in a pairing heap, ordered by scheduling time */
 typedef struct {
     /* Data used by the main thread */
     SDL_Thread *thread;
     SDL_atomic_t nextID;
-    SDL_TimerMap *timermap;
+    Uint64 frequency;
+    SDL_TimerMap **timermap;    /* hash table of timer IDs, timermap_size buckets */
+    int timermap_size;
+    int timermap_count;
     SDL_mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -61,54 +103,333 @@ typedef struct {
     SDL_SpinLock lock;
     SDL_sem *sem;
     SDL_Timer *pending;
+    SDL_Timer *canceled;
+    SDL_Timer *done;
     SDL_Timer *freelist;
     SDL_atomic_t active;
 
-    /* List of timers - this is only touched by the timer thread */
+    /* Heap of timers - this is only touched by the timer thread */
     SDL_Timer *timers;
+
+    /* Worker threads that run the callbacks, if SDL_HINT_TIMER_THREAD_POOL is set */
+    int num_workers;
+    SDL_Thread *workers[MAX_TIMER_WORKERS];
+    SDL_mutex *work_lock;
+    SDL_cond *work_cond;
+    SDL_Timer *work_head;
+    SDL_Timer *work_tail;
+    SDL_bool work_quit;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
 
 /* The idea here is that any thread might add a timer, but a single
- * thread manages the active timer queue, sorted by scheduling time.
+ * thread manages the active timer queue, ordered by scheduling time.
+ *
+ * Timers are removed by setting a canceled flag, and whoever sets the
+ * flag first owns the timer structure: the timer thread if the timer
+ * expired, or SDL_RemoveTimer(), which hands it to the timer thread on
+ * the canceled list so it can be taken out of the heap and reused right
+ * away instead of waiting for its scheduled time.
  *
- * Timers are removed by simply setting a canceled flag
+ * With a thread pool, expired timers are handed to the worker threads,
+ * which send them back to the timer thread on the done list once the
+ * callback has returned. A timer that is canceled while a worker has it
+ * is freed when it comes back.
  */
 
+static void
+SDL_AppendTimer(SDL_Timer **head, SDL_Timer **tail, SDL_Timer *timer)
+{
+    if (!*head) {
+        *head = timer;
+    }
+    if (*tail) {
+        (*tail)->next = timer;
+    }
+    *tail = timer;
+    timer->next = NULL;
+}
+
+static SDL_Timer *
+SDL_MeldTimers(SDL_Timer *a, SDL_Timer *b)
+{
+    SDL_Timer *tmp;
+
+    if (b->scheduled < a->scheduled) {
+        tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* Combine a list of siblings into a single heap, pairing them up left to
+   right and then melding the pairs right to left. */
+static SDL_Timer *
+SDL_MergeTimerPairs(SDL_Timer *first)
+{
+    SDL_Timer *pairs = NULL;
+    SDL_Timer *a, *b, *next;
+
+    while (first) {
+        a = first;
+        b = a->sibling;
+        next = b ? b->sibling : NULL;
+
+        a->sibling = a->prev = NULL;
+        if (b) {
+            b->sibling = b->prev = NULL;
+            a = SDL_MeldTimers(a, b);
+        }
+        a->sibling = pairs;
+        pairs = a;
+        first = next;
+    }
+
+    first = NULL;
+    while (pairs) {
+        next = pairs->sibling;
+        pairs->sibling = NULL;
+        first = first ? SDL_MeldTimers(first, pairs) : pairs;
+        pairs = next;
+    }
+    return first;
+}
+
 static void
 SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    timer->queued = SDL_TRUE;
+    timer->child = timer->sibling = timer->prev = NULL;
+    data->timers = data->timers ? SDL_MeldTimers(data->timers, timer) : timer;
+}
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if ((Sint32)(timer->scheduled-curr->scheduled) < 0) {
-            break;
+static void
+SDL_RemoveTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_Timer *children;
+
+    timer->queued = SDL_FALSE;
+    children = SDL_MergeTimerPairs(timer->child);
+    timer->child = NULL;
+
+    if (timer == data->timers) {
+        data->timers = children;
+        return;
+    }
+
+    /* Cut the timer out of its parent's list of children */
+    if (timer->prev->child == timer) {
+        timer->prev->child = timer->sibling;
+    } else {
+        timer->prev->sibling = timer->sibling;
+    }
+    if (timer->sibling) {
+        timer->sibling->prev = timer->prev;
+    }
+    timer->sibling = timer->prev = NULL;
+
+    if (children) {
+        data->timers = SDL_MeldTimers(data->timers, children);
+    }
+}
+
+static void
+SDL_FreeTimers(SDL_Timer *timer)
+{
+    SDL_Timer *last, *next;
+
+    /* Walk the heap as a list, splicing children in after their parent */
+    while (timer) {
+        if (timer->child) {
+            for (last = timer->child; last->sibling; last = last->sibling) {
+                continue;
+            }
+            last->sibling = timer->sibling;
+            timer->sibling = timer->child;
+        }
+        next = timer->sibling;
+        SDL_free(timer);
+        timer = next;
+    }
+}
+
+static SDL_INLINE Uint32
+SDL_HashTimerID(const SDL_TimerData *data, int timerID)
+{
+    /* Timer IDs are handed out sequentially, so they spread out evenly */
+    return (Uint32)timerID & (data->timermap_size - 1);
+}
+
+/* Grow the timer ID hash table -- called with the timermap locked */
+static int
+SDL_GrowTimerMap(SDL_TimerData *data)
+{
+    const int size = data->timermap_size ? data->timermap_size * 2 : SDL_TIMERMAP_MIN_BUCKETS;
+    SDL_TimerMap **timermap;
+    SDL_TimerMap *entry, *next;
+    int i;
+
+    timermap = (SDL_TimerMap **)SDL_calloc(size, sizeof(*timermap));
+    if (!timermap) {
+        return SDL_OutOfMemory();
+    }
+
+    for (i = 0; i < data->timermap_size; ++i) {
+        for (entry = data->timermap[i]; entry; entry = next) {
+            next = entry->next;
+            entry->next = timermap[(Uint32)entry->timerID & (size - 1)];
+            timermap[(Uint32)entry->timerID & (size - 1)] = entry;
         }
     }
+    SDL_free(data->timermap);
+    data->timermap = timermap;
+    data->timermap_size = size;
+    return 0;
+}
+
+static Uint64
+SDL_NSToCounter(const SDL_TimerData *data, Uint64 ns)
+{
+    return (ns / NS_PER_SECOND) * data->frequency +
+           ((ns % NS_PER_SECOND) * data->frequency) / NS_PER_SECOND;
+}
+
+static Uint64
+SDL_CounterToNS(const SDL_TimerData *data, Uint64 counter)
+{
+    return (counter / data->frequency) * NS_PER_SECOND +
+           ((counter % data->frequency) * NS_PER_SECOND) / data->frequency;
+}
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
+/* Call the timer callback and work out when it's due next.
+   Returns SDL_TRUE if the timer should be rescheduled. */
+static SDL_bool
+SDL_RunTimerCallback(SDL_TimerData *data, SDL_Timer *timer)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const Uint64 lateness = (start > timer->scheduled) ? (start - timer->scheduled) : 0;
+    Uint64 duration, interval_ns;
+    Uint32 interval;
+    SDL_bool reschedule;
+
+    if (timer->callback_ns) {
+        interval_ns = timer->callback_ns(timer->interval_ns, timer->param);
+        if (interval_ns != timer->interval_ns) {
+            timer->interval_ns = interval_ns;
+            timer->period = SDL_NSToCounter(data, interval_ns);
+        }
+        reschedule = (interval_ns > 0);
+
+        /* Schedule against the previous deadline so the timer doesn't
+           drift, skipping any deadlines we're already too late for. */
+        timer->scheduled += timer->period;
+        if (timer->scheduled <= start) {
+            const Uint64 missed = timer->period ? (start - timer->scheduled) / timer->period + 1 : 0;
+            timer->scheduled += missed * timer->period;
+            timer->missed += (Uint32)missed;
+        }
     } else {
-        data->timers = timer;
+        interval = timer->callback(timer->interval, timer->param);
+        reschedule = (interval > 0);
+        timer->scheduled = start + (interval * data->frequency) / 1000;
+    }
+    duration = SDL_GetPerformanceCounter() - start;
+
+    SDL_AtomicLock(&data->lock);
+    if (!timer->fired || lateness < timer->min_lateness) {
+        timer->min_lateness = lateness;
+    }
+    if (lateness > timer->max_lateness) {
+        timer->max_lateness = lateness;
     }
-    timer->next = curr;
+    if (duration > timer->max_duration) {
+        timer->max_duration = duration;
+    }
+    timer->total_lateness += lateness;
+    timer->total_duration += duration;
+    ++timer->fired;
+    SDL_AtomicUnlock(&data->lock);
+
+    return reschedule;
 }
 
+static int
+SDL_TimerWorkerThread(void *_data)
+{
+    SDL_TimerData *data = (SDL_TimerData *)_data;
+    SDL_Timer *timer;
+
+    for ( ; ; ) {
+        SDL_LockMutex(data->work_lock);
+        while (!data->work_head && !data->work_quit) {
+            SDL_CondWait(data->work_cond, data->work_lock);
+        }
+        if (data->work_quit) {
+            SDL_UnlockMutex(data->work_lock);
+            break;
+        }
+        timer = data->work_head;
+        data->work_head = timer->next;
+        if (!data->work_head) {
+            data->work_tail = NULL;
+        }
+        SDL_UnlockMutex(data->work_lock);
+
+        if (SDL_AtomicGet(&timer->canceled)) {
+            timer->reschedule = SDL_FALSE;
+        } else {
+            timer->reschedule = SDL_RunTimerCallback(data, timer);
+        }
+
+        /* Hand the timer back to the timer thread */
+        SDL_AtomicLock(&data->lock);
+        timer->next = data->done;
+        data->done = timer;
+        SDL_AtomicUnlock(&data->lock);
+        SDL_SemPost(data->sem);
+    }
+    return 0;
+}
+
+#if !SDL_TIMER_UNIX
+void
+SDL_DelayUntil(Uint64 deadline)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 now;
+
+    /* Sleep for whole milliseconds, then yield until the deadline */
+    while ((now = SDL_GetPerformanceCounter()) < deadline) {
+        SDL_Delay((Uint32)(((deadline - now) * 1000) / frequency));
+    }
+}
+#endif
+
 static int
 SDL_TimerThread(void *_data)
 {
     SDL_TimerData *data = (SDL_TimerData *)_data;
     SDL_Timer *pending;
+    SDL_Timer *canceled;
+    SDL_Timer *done;
     SDL_Timer *current;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
-    Uint32 tick, now, interval, delay;
+    SDL_Timer *work_head, *work_tail;
+    Uint64 tick, now, delay;
 
     /* Threaded timer loop:
-     *  1. Queue timers added by other threads
+     *  1. Queue timers added by other threads, drop canceled timers
      *  2. Handle any timers that should dispatch this cycle
      *  3. Wait until next dispatch time or new timer arrives
      */
@@ -120,6 +441,14 @@ SDL_TimerThread(void *_data)
             pending = data->pending;
             data->pending = NULL;
 
+            /* Get any timers that were canceled */
+            canceled = data->canceled;
+            data->canceled = NULL;
+
+            /* Get any timers the worker threads are done with */
+            done = data->done;
+            data->done = NULL;
+
             /* Make any unused timer structures available */
             if (freelist_head) {
                 freelist_tail->next = data->freelist;
@@ -128,7 +457,7 @@ SDL_TimerThread(void *_data)
         }
         SDL_AtomicUnlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        /* Sort the pending timers into our heap */
         while (pending) {
             current = pending;
             pending = pending->next;
@@ -137,59 +466,97 @@ SDL_TimerThread(void *_data)
         freelist_head = NULL;
         freelist_tail = NULL;
 
+        /* Take canceled timers out of the heap, they can be reused now */
+        while (canceled) {
+            current = canceled;
+            canceled = canceled->next_canceled;
+            if (current->dispatched) {
+                current->cancel_seen = SDL_TRUE;
+                continue;
+            }
+            if (current->queued) {
+                SDL_RemoveTimerInternal(data, current);
+            }
+            SDL_AppendTimer(&freelist_head, &freelist_tail, current);
+        }
+
+        /* Requeue the timers the worker threads are done with */
+        while (done) {
+            current = done;
+            done = done->next;
+            current->dispatched = SDL_FALSE;
+
+            if (current->reschedule && !SDL_AtomicGet(&current->canceled)) {
+                SDL_AddTimerInternal(data, current);
+            } else if (SDL_AtomicCAS(&current->canceled, 0, 1) || current->cancel_seen) {
+                SDL_AppendTimer(&freelist_head, &freelist_tail, current);
+            }
+            /* Otherwise it's on the canceled list and will be freed from there */
+        }
+
         /* Check to see if we're still running, after maintenance */
         if (!SDL_AtomicGet(&data->active)) {
+            /* Leave the timers we just reclaimed where SDL_TimerQuit() frees them */
+            if (freelist_head) {
+                SDL_AtomicLock(&data->lock);
+                freelist_tail->next = data->freelist;
+                data->freelist = freelist_head;
+                SDL_AtomicUnlock(&data->lock);
+            }
             break;
         }
 
-        /* Initial delay if there are no timers */
-        delay = SDL_MUTEX_MAXWAIT;
-
-        tick = SDL_GetTicks();
+        tick = SDL_GetPerformanceCounter();
+        work_head = work_tail = NULL;
 
         /* Process all the pending timers for this tick */
         while (data->timers) {
             current = data->timers;
 
-            if ((Sint32)(tick-current->scheduled) < 0) {
+            if (tick < current->scheduled) {
                 /* Scheduled for the future, wait a bit */
-                delay = (current->scheduled - tick);
                 break;
             }
 
             /* We're going to do something with this timer */
-            data->timers = current->next;
+            SDL_RemoveTimerInternal(data, current);
 
             if (SDL_AtomicGet(&current->canceled)) {
-                interval = 0;
-            } else {
-                interval = current->callback(current->interval, current->param);
+                /* It's on the canceled list and will be freed from there */
+                continue;
             }
 
-            if (interval > 0) {
+            if (data->num_workers > 0) {
+                current->dispatched = SDL_TRUE;
+                current->cancel_seen = SDL_FALSE;
+                SDL_AppendTimer(&work_head, &work_tail, current);
+                continue;
+            }
+
+            if (SDL_RunTimerCallback(data, current) && !SDL_AtomicGet(&current->canceled)) {
                 /* Reschedule this timer */
-                current->scheduled = tick + interval;
                 SDL_AddTimerInternal(data, current);
-            } else {
-                if (!freelist_head) {
-                    freelist_head = current;
-                }
-                if (freelist_tail) {
-                    freelist_tail->next = current;
-                }
-                freelist_tail = current;
-
-                SDL_AtomicSet(&current->canceled, 1);
+            } else if (SDL_AtomicCAS(&current->canceled, 0, 1)) {
+                SDL_AppendTimer(&freelist_head, &freelist_tail, current);
             }
         }
 
-        /* Adjust the delay based on processing time */
-        now = SDL_GetTicks();
-        interval = (now - tick);
-        if (interval > delay) {
-            delay = 0;
-        } else {
-            delay -= interval;
+        /* Hand the expired timers to the worker threads */
+        if (work_head) {
+            SDL_LockMutex(data->work_lock);
+            if (data->work_tail) {
+                data->work_tail->next = work_head;
+            } else {
+                data->work_head = work_head;
+            }
+            data->work_tail = work_tail;
+            SDL_UnlockMutex(data->work_lock);
+
+            if (work_head == work_tail) {
+                SDL_CondSignal(data->work_cond);
+            } else {
+                SDL_CondBroadcast(data->work_cond);
+            }
         }
 
         /* Note that each time a timer is added, this will return
@@ -197,11 +564,99 @@ SDL_TimerThread(void *_data)
            That's okay, it just means we run through the loop a few
            extra times.
          */
-        SDL_SemWaitTimeout(data->sem, delay);
+        if (!data->timers) {
+            SDL_SemWait(data->sem);
+            continue;
+        }
+
+        now = SDL_GetPerformanceCounter();
+        if (now >= data->timers->scheduled) {
+            continue;
+        }
+        delay = ((data->timers->scheduled - now) * 1000) / data->frequency;
+        if (delay >= PRECISE_DELAY_THRESHOLD) {
+            /* Wake up a little early and sleep precisely from there */
+            SDL_SemWaitTimeout(data->sem, (Uint32)SDL_min(delay - 1, SDL_MUTEX_MAXWAIT - 1));
+        } else {
+            SDL_DelayUntil(data->timers->scheduled);
+        }
     }
     return 0;
 }
 
+static int
+SDL_StartTimerWorkers(SDL_TimerData *data)
+{
+    int i;
+
+    if (!SDL_GetHintBoolean(SDL_HINT_TIMER_THREAD_POOL, SDL_FALSE)) {
+        return 0;
+    }
+
+    data->work_lock = SDL_CreateMutex();
+    if (!data->work_lock) {
+        return -1;
+    }
+    data->work_cond = SDL_CreateCond();
+    if (!data->work_cond) {
+        return -1;
+    }
+    data->work_quit = SDL_FALSE;
+
+    /* Callbacks may block, so use a couple of threads even on one CPU */
+    data->num_workers = SDL_max(SDL_min(SDL_GetCPUCount(), MAX_TIMER_WORKERS), MIN_TIMER_WORKERS);
+    for (i = 0; i < data->num_workers; ++i) {
+        char name[64];
+        SDL_snprintf(name, sizeof (name), "SDLTimerWorker%d", i);
+        /* Timer threads use a callback into the app, so we can't set a limited stack size here. */
+        data->workers[i] = SDL_CreateThreadInternal(SDL_TimerWorkerThread, name, 0, data);
+        if (!data->workers[i]) {
+            data->num_workers = i;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void
+SDL_StopTimerWorkers(SDL_TimerData *data)
+{
+    SDL_Timer *timer;
+    int i;
+
+    if (data->work_lock) {
+        SDL_LockMutex(data->work_lock);
+        data->work_quit = SDL_TRUE;
+        SDL_UnlockMutex(data->work_lock);
+    }
+    if (data->work_cond) {
+        SDL_CondBroadcast(data->work_cond);
+    }
+    for (i = 0; i < data->num_workers; ++i) {
+        SDL_WaitThread(data->workers[i], NULL);
+        data->workers[i] = NULL;
+    }
+    data->num_workers = 0;
+
+    /* Free the timers that were still waiting for or coming back from a worker */
+    while (data->work_head) {
+        timer = data->work_head;
+        data->work_head = timer->next;
+        SDL_free(timer);
+    }
+    data->work_tail = NULL;
+    while (data->done) {
+        timer = data->done;
+        data->done = timer->next;
+        SDL_free(timer);
+    }
+
+    SDL_DestroyCond(data->work_cond);
+    data->work_cond = NULL;
+    SDL_DestroyMutex(data->work_lock);
+    data->work_lock = NULL;
+}
+
 int
 SDL_TimerInit(void)
 {
@@ -220,8 +675,14 @@ SDL_TimerInit(void)
             return -1;
         }
 
+        data->frequency = SDL_GetPerformanceFrequency();
         SDL_AtomicSet(&data->active, 1);
 
+        if (SDL_StartTimerWorkers(data) < 0) {
+            SDL_TimerQuit();
+            return -1;
+        }
+
         /* Timer threads use a callback into the app, so we can't set a limited stack size here. */
         data->thread = SDL_CreateThreadInternal(SDL_TimerThread, name, 0, data);
         if (!data->thread) {
@@ -240,6 +701,7 @@ SDL_TimerQuit(void)
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
     SDL_TimerMap *entry;
+    int i;
 
     if (SDL_AtomicCAS(&data->active, 1, 0)) {  /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -249,37 +711,65 @@ SDL_TimerQuit(void)
             data->thread = NULL;
         }
 
+        /* Timers added after the thread's last pass are only on the pending
+           list, unless they were canceled too, then they're freed below. */
+        while (data->pending) {
+            timer = data->pending;
+            data->pending = timer->next;
+            if (!SDL_AtomicGet(&timer->canceled)) {
+                SDL_free(timer);
+            }
+        }
+
+        /* Canceled timers can also be in the heap or with the workers, so
+           unlink them before either of those is freed. Anything still here
+           that isn't queued or dispatched isn't anywhere else. */
+        while (data->canceled) {
+            timer = data->canceled;
+            data->canceled = timer->next_canceled;
+            if (!timer->queued && !timer->dispatched) {
+                SDL_free(timer);
+            }
+        }
+
+        SDL_StopTimerWorkers(data);
+
         SDL_DestroySemaphore(data->sem);
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
-            SDL_free(timer);
-        }
+        SDL_FreeTimers(data->timers);
+        data->timers = NULL;
         while (data->freelist) {
             timer = data->freelist;
             data->freelist = timer->next;
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
+        for (i = 0; i < data->timermap_size; ++i) {
+            while (data->timermap[i]) {
+                entry = data->timermap[i];
+                data->timermap[i] = entry->next;
+                SDL_free(entry);
+            }
         }
+        SDL_free(data->timermap);
+        data->timermap = NULL;
+        data->timermap_size = 0;
+        data->timermap_count = 0;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
     }
 }
 
-SDL_TimerID
-SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID
+SDL_CreateTimer(Uint32 interval, SDL_TimerCallback callback,
+                Uint64 interval_ns, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
     SDL_TimerMap *entry;
+    Uint32 bucket;
 
     SDL_AtomicLock(&data->lock);
     if (!SDL_AtomicGet(&data->active)) {
@@ -306,9 +796,27 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     }
     timer->timerID = SDL_AtomicIncRef(&data->nextID);
     timer->callback = callback;
+    timer->callback_ns = callback_ns;
     timer->param = param;
     timer->interval = interval;
-    timer->scheduled = SDL_GetTicks() + interval;
+    timer->interval_ns = interval_ns;
+    if (callback_ns) {
+        timer->period = SDL_NSToCounter(data, interval_ns);
+    } else {
+        timer->period = (interval * data->frequency) / 1000;
+    }
+    timer->scheduled = SDL_GetPerformanceCounter() + timer->period;
+    timer->fired = 0;
+    timer->missed = 0;
+    timer->min_lateness = 0;
+    timer->max_lateness = 0;
+    timer->total_lateness = 0;
+    timer->max_duration = 0;
+    timer->total_duration = 0;
+    timer->reschedule = SDL_FALSE;
+    timer->queued = SDL_FALSE;
+    timer->dispatched = SDL_FALSE;
+    timer->cancel_seen = SDL_FALSE;
     SDL_AtomicSet(&timer->canceled, 0);
 
     entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
@@ -321,8 +829,19 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     entry->timerID = timer->timerID;
 
     SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
+    if (data->timermap_count >= data->timermap_size) {
+        /* A full table still works, it's only fatal if there is none */
+        if (SDL_GrowTimerMap(data) < 0 && !data->timermap) {
+            SDL_UnlockMutex(data->timermap_lock);
+            SDL_free(entry);
+            SDL_free(timer);
+            return 0;
+        }
+    }
+    bucket = SDL_HashTimerID(data, entry->timerID);
+    entry->next = data->timermap[bucket];
+    data->timermap[bucket] = entry;
+    ++data->timermap_count;
     SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
@@ -337,31 +856,100 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     return entry->timerID;
 }
 
+SDL_TimerID
+SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    if (!callback) {
+        SDL_InvalidParamError("callback");
+        return 0;
+    }
+    return SDL_CreateTimer(interval, callback, 0, NULL, param);
+}
+
+SDL_TimerID
+SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *param)
+{
+    if (!callback) {
+        SDL_InvalidParamError("callback");
+        return 0;
+    }
+    return SDL_CreateTimer(0, NULL, interval, callback, param);
+}
+
+int
+SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+    SDL_TimerMap *entry = NULL;
+    SDL_Timer *timer;
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(data->timermap_lock);
+    if (data->timermap) {
+        for (entry = data->timermap[SDL_HashTimerID(data, id)]; entry; entry = entry->next) {
+            if (entry->timerID == id) {
+                break;
+            }
+        }
+    }
+    if (!entry) {
+        SDL_UnlockMutex(data->timermap_lock);
+        return SDL_SetError("Unknown timer ID %d", id);
+    }
+
+    timer = entry->timer;
+    SDL_AtomicLock(&data->lock);
+    stats->fired = timer->fired;
+    stats->missed = timer->missed;
+    stats->min_lateness = SDL_CounterToNS(data, timer->min_lateness);
+    stats->max_lateness = SDL_CounterToNS(data, timer->max_lateness);
+    stats->avg_lateness = timer->fired ? SDL_CounterToNS(data, timer->total_lateness / timer->fired) : 0;
+    stats->max_duration = SDL_CounterToNS(data, timer->max_duration);
+    stats->avg_duration = timer->fired ? SDL_CounterToNS(data, timer->total_duration / timer->fired) : 0;
+    SDL_AtomicUnlock(&data->lock);
+    SDL_UnlockMutex(data->timermap_lock);
+
+    return 0;
+}
+
 SDL_bool
 SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_TimerMap *prev, *entry = NULL;
+    SDL_Timer *timer;
     SDL_bool canceled = SDL_FALSE;
 
     /* Find the timer */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
+    if (data->timermap) {
+        const Uint32 bucket = SDL_HashTimerID(data, id);
+        prev = NULL;
+        for (entry = data->timermap[bucket]; entry; prev = entry, entry = entry->next) {
+            if (entry->timerID == id) {
+                if (prev) {
+                    prev->next = entry->next;
+                } else {
+                    data->timermap[bucket] = entry->next;
+                }
+                --data->timermap_count;
+                break;
             }
-            break;
         }
     }
     SDL_UnlockMutex(data->timermap_lock);
 
     if (entry) {
-        if (!SDL_AtomicGet(&entry->timer->canceled)) {
-            SDL_AtomicSet(&entry->timer->canceled, 1);
+        timer = entry->timer;
+        if (SDL_AtomicCAS(&timer->canceled, 0, 1)) {
+            /* Hand the timer back to the timer thread for reclamation */
+            SDL_AtomicLock(&data->lock);
+            timer->next_canceled = data->canceled;
+            data->canceled = timer;
+            SDL_AtomicUnlock(&data->lock);
             canceled = SDL_TRUE;
         }
         SDL_free(entry);
@@ -31,4 +31,7 @@ extern void SDL_TicksQuit(void);
 extern int SDL_TimerInit(void);
 extern void SDL_TimerQuit(void);
 
+/* Sleep until the performance counter reaches the deadline, as precisely as the platform allows */
+extern void SDL_DelayUntil(Uint64 deadline);
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -227,6 +227,44 @@ SDL_Delay(Uint32 ms)
     } while (was_error && (errno == EINTR));
 }
 
+void
+SDL_DelayUntil(Uint64 deadline)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    if (now >= deadline) {
+        return;
+    }
+
+#if HAVE_CLOCK_GETTIME && defined(TIMER_ABSTIME)
+    if (has_monotonic_time) {
+        /* The performance counter is in nanoseconds of SDL_MONOTONIC_CLOCK,
+           which clock_nanosleep() doesn't necessarily accept, so sleep on
+           CLOCK_MONOTONIC until the same amount of time has passed.
+         */
+        const Uint64 remaining = deadline - now;
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts.tv_sec += (time_t)(remaining / 1000000000);
+        ts.tv_nsec += (long)(remaining % 1000000000);
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_nsec -= 1000000000;
+            ++ts.tv_sec;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+            continue;
+        }
+        return;
+    }
+#endif
+
+    /* Sleep for whole milliseconds, then yield until the deadline */
+    do {
+        SDL_Delay((Uint32)(((deadline - now) * 1000) / SDL_GetPerformanceFrequency()));
+    } while ((now = SDL_GetPerformanceCounter()) < deadline);
+}
+
 #endif /* SDL_TIMER_UNIX */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -153,6 +153,12 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
             if (SDL_HasSSE2()) {
                 features |= SDL_CPU_SSE2;
             }
+            if (SDL_HasAVX2()) {
+                features |= SDL_CPU_AVX2;
+            }
+            if (SDL_HasNEON()) {
+                features |= SDL_CPU_NEON;
+            }
             if (SDL_HasAltiVec()) {
                 if (SDL_UseAltivecPrefetch()) {
                     features |= SDL_CPU_ALTIVEC_PREFETCH;
@@ -51,6 +51,8 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_CPU_SSE2                0x00000008
 #define SDL_CPU_ALTIVEC_PREFETCH    0x00000010
 #define SDL_CPU_ALTIVEC_NOPREFETCH  0x00000020
+#define SDL_CPU_AVX2                0x00000040
+#define SDL_CPU_NEON                0x00000080
 
 typedef struct
 {
@@ -105,6 +107,17 @@ extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface * surface);
 
+/* Filtering for scaled blits */
+typedef enum
+{
+    SDL_BLITSCALE_NEAREST,
+    SDL_BLITSCALE_LINEAR
+} SDL_BlitScaleMode;
+
+/* SDL_UpperBlitScaled() and SDL_LowerBlitScaled() with a choice of filtering */
+extern int SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect, SDL_Surface * dst, SDL_Rect * dstrect, SDL_BlitScaleMode scaleMode);
+extern int SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect, SDL_Surface * dst, SDL_Rect * dstrect, SDL_BlitScaleMode scaleMode);
+
 /*
  * Useful macros for blitting routines
  */
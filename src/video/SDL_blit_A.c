@@ -22,6 +22,7 @@
 
 #include "SDL_video.h"
 #include "SDL_blit.h"
+#include "../cpuinfo/SDL_simd.h"
 
 /* Functions to perform alpha blended blitting */
 
@@ -1142,6 +1143,487 @@ BlitARGBto555PixelAlpha(SDL_BlitInfo * info)
     }
 }
 
+/* The SIMD blitters below give exactly the same results as the scalar ones
+   above: each 32-bit lane does the same arithmetic on one pixel. They only
+   do whole vectors, and leave the last few pixels of each row to the
+   scalar blitter. */
+
+#if HAVE_SSE41_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+/* Blit the pixels of each row from (done) on with a scalar blitter */
+static void
+BlitRemainder(SDL_BlitInfo * info, int done, int bpp, SDL_BlitFunc blit)
+{
+    if (done < info->dst_w) {
+        SDL_BlitInfo rest = *info;
+        rest.src += done * bpp;
+        rest.src_skip += done * bpp;
+        rest.dst += done * bpp;
+        rest.dst_skip += done * bpp;
+        rest.dst_w -= done;
+        blit(&rest);
+    }
+}
+#endif
+
+#if HAVE_SSE41_INTRINSICS
+/* d + ((s - d) * alpha >> 8), on the channels in (mask) */
+SDL_TARGETING("sse4.1") static SDL_INLINE __m128i
+BlendChannelsSSE41(__m128i s, __m128i d, const __m128i alpha, const __m128i mask)
+{
+    s = _mm_and_si128(s, mask);
+    d = _mm_and_si128(d, mask);
+    d = _mm_add_epi32(d, _mm_srli_epi32(_mm_mullo_epi32(_mm_sub_epi32(s, d), alpha), 8));
+    return _mm_and_si128(d, mask);
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha */
+SDL_TARGETING("sse4.1") static void
+BlitRGBtoRGBPixelAlphaSSE41(SDL_BlitInfo * info)
+{
+    const int width = info->dst_w & ~3;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const __m128i rbmask = _mm_set1_epi32(0x00ff00ff);
+    const __m128i gmask = _mm_set1_epi32(0x0000ff00);
+    const __m128i opaque = _mm_set1_epi32(SDL_ALPHA_OPAQUE);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) (src + n * 4));
+            const __m128i alpha = _mm_srli_epi32(s, 24);
+            const __m128i transparent = _mm_cmpeq_epi32(alpha, zero);
+            const __m128i solid = _mm_cmpeq_epi32(alpha, opaque);
+            __m128i d, dalpha, pixels;
+
+            if (_mm_movemask_epi8(transparent) == 0xffff) {
+                continue;
+            }
+            if (_mm_movemask_epi8(solid) == 0xffff) {
+                _mm_storeu_si128((__m128i *) (dst + n * 4), s);
+                continue;
+            }
+            d = _mm_loadu_si128((const __m128i *) (dst + n * 4));
+            dalpha = _mm_srli_epi32(d, 24);
+            dalpha = _mm_add_epi32(alpha, _mm_srli_epi32(_mm_mullo_epi16(dalpha, _mm_xor_si128(alpha, opaque)), 8));
+            pixels = _mm_or_si128(BlendChannelsSSE41(s, d, alpha, rbmask),
+                                  BlendChannelsSSE41(s, d, alpha, gmask));
+            pixels = _mm_or_si128(pixels, _mm_slli_epi32(dalpha, 24));
+            pixels = _mm_blendv_epi8(pixels, s, solid);
+            pixels = _mm_blendv_epi8(pixels, d, transparent);
+            _mm_storeu_si128((__m128i *) (dst + n * 4), pixels);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+    BlitRemainder(info, width, 4, BlitRGBtoRGBPixelAlpha);
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha */
+SDL_TARGETING("sse4.1") static void
+BlitRGBtoRGBSurfaceAlphaSSE41(SDL_BlitInfo * info)
+{
+    const unsigned alpha = info->a;
+    const int width = info->dst_w & ~3;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const __m128i valpha = _mm_set1_epi32(alpha);
+    const __m128i rbmask = _mm_set1_epi32(0x00ff00ff);
+    const __m128i gmask = _mm_set1_epi32(0x0000ff00);
+    const __m128i hmask = _mm_set1_epi32(0x00fefefe);
+    const __m128i lmask = _mm_set1_epi32(0x00010101);
+    const __m128i amask = _mm_set1_epi32(0xff000000);
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) (src + n * 4));
+            const __m128i d = _mm_loadu_si128((const __m128i *) (dst + n * 4));
+            __m128i pixels;
+
+            if (alpha == 128) {
+                pixels = _mm_add_epi32(_mm_and_si128(s, hmask), _mm_and_si128(d, hmask));
+                pixels = _mm_add_epi32(_mm_srli_epi32(pixels, 1), _mm_and_si128(_mm_and_si128(s, d), lmask));
+            } else {
+                pixels = _mm_or_si128(BlendChannelsSSE41(s, d, valpha, rbmask),
+                                      BlendChannelsSSE41(s, d, valpha, gmask));
+            }
+            _mm_storeu_si128((__m128i *) (dst + n * 4), _mm_or_si128(pixels, amask));
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+    BlitRemainder(info, width, 4, BlitRGBtoRGBSurfaceAlpha);
+}
+
+/* Blend 4 16-bit pixels, zero extended to 32 bits, like Blit565to565SurfaceAlpha() */
+SDL_TARGETING("sse4.1") static SDL_INLINE __m128i
+Blend16to16SSE41(__m128i s, __m128i d, const __m128i alpha, const __m128i mask)
+{
+    s = _mm_and_si128(_mm_or_si128(s, _mm_slli_epi32(s, 16)), mask);
+    d = _mm_and_si128(_mm_or_si128(d, _mm_slli_epi32(d, 16)), mask);
+    d = _mm_add_epi32(d, _mm_srli_epi32(_mm_mullo_epi32(_mm_sub_epi32(s, d), alpha), 5));
+    d = _mm_and_si128(d, mask);
+    return _mm_and_si128(_mm_or_si128(d, _mm_srli_epi32(d, 16)), _mm_set1_epi32(0xffff));
+}
+
+/* 16bpp blending with surface alpha, (mask128) is the 50% blend mask and
+   (mask) spreads the channels out in 32 bits */
+SDL_TARGETING("sse4.1") static void
+Blit16to16SurfaceAlphaSSE41(SDL_BlitInfo * info, Uint16 mask128, Uint32 mask)
+{
+    const unsigned alpha = info->a;
+    const int width = info->dst_w & ~7;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const __m128i valpha = _mm_set1_epi32(alpha >> 3);    /* downscale alpha to 5 bits */
+    const __m128i vmask = _mm_set1_epi32(mask);
+    const __m128i hmask = _mm_set1_epi16(mask128);
+    const __m128i lmask = _mm_set1_epi16(~mask128);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 8) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) (src + n * 2));
+            const __m128i d = _mm_loadu_si128((const __m128i *) (dst + n * 2));
+            __m128i pixels;
+
+            if (alpha == 128) {
+                pixels = _mm_add_epi16(_mm_srli_epi16(_mm_and_si128(s, hmask), 1),
+                                       _mm_srli_epi16(_mm_and_si128(d, hmask), 1));
+                pixels = _mm_add_epi16(pixels, _mm_and_si128(_mm_and_si128(s, d), lmask));
+            } else {
+                pixels = _mm_packus_epi32(
+                    Blend16to16SSE41(_mm_unpacklo_epi16(s, zero), _mm_unpacklo_epi16(d, zero), valpha, vmask),
+                    Blend16to16SSE41(_mm_unpackhi_epi16(s, zero), _mm_unpackhi_epi16(d, zero), valpha, vmask));
+            }
+            _mm_storeu_si128((__m128i *) (dst + n * 2), pixels);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+static void
+Blit565to565SurfaceAlphaSSE41(SDL_BlitInfo * info)
+{
+    Blit16to16SurfaceAlphaSSE41(info, 0xf7de, 0x07e0f81f);
+    BlitRemainder(info, info->dst_w & ~7, 2, Blit565to565SurfaceAlpha);
+}
+
+static void
+Blit555to555SurfaceAlphaSSE41(SDL_BlitInfo * info)
+{
+    Blit16to16SurfaceAlphaSSE41(info, 0xfbde, 0x03e07c1f);
+    BlitRemainder(info, info->dst_w & ~7, 2, Blit555to555SurfaceAlpha);
+}
+#endif /* HAVE_SSE41_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+BlendChannelsAVX2(__m256i s, __m256i d, const __m256i alpha, const __m256i mask)
+{
+    s = _mm256_and_si256(s, mask);
+    d = _mm256_and_si256(d, mask);
+    d = _mm256_add_epi32(d, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s, d), alpha), 8));
+    return _mm256_and_si256(d, mask);
+}
+
+SDL_TARGETING("avx2") static void
+BlitRGBtoRGBPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    const int width = info->dst_w & ~7;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const __m256i rbmask = _mm256_set1_epi32(0x00ff00ff);
+    const __m256i gmask = _mm256_set1_epi32(0x0000ff00);
+    const __m256i opaque = _mm256_set1_epi32(SDL_ALPHA_OPAQUE);
+    const __m256i zero = _mm256_setzero_si256();
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 8) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *) (src + n * 4));
+            const __m256i alpha = _mm256_srli_epi32(s, 24);
+            const __m256i transparent = _mm256_cmpeq_epi32(alpha, zero);
+            const __m256i solid = _mm256_cmpeq_epi32(alpha, opaque);
+            __m256i d, dalpha, pixels;
+
+            if (_mm256_movemask_epi8(transparent) == -1) {
+                continue;
+            }
+            if (_mm256_movemask_epi8(solid) == -1) {
+                _mm256_storeu_si256((__m256i *) (dst + n * 4), s);
+                continue;
+            }
+            d = _mm256_loadu_si256((const __m256i *) (dst + n * 4));
+            dalpha = _mm256_srli_epi32(d, 24);
+            dalpha = _mm256_add_epi32(alpha, _mm256_srli_epi32(_mm256_mullo_epi16(dalpha, _mm256_xor_si256(alpha, opaque)), 8));
+            pixels = _mm256_or_si256(BlendChannelsAVX2(s, d, alpha, rbmask),
+                                     BlendChannelsAVX2(s, d, alpha, gmask));
+            pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(dalpha, 24));
+            pixels = _mm256_blendv_epi8(pixels, s, solid);
+            pixels = _mm256_blendv_epi8(pixels, d, transparent);
+            _mm256_storeu_si256((__m256i *) (dst + n * 4), pixels);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+    BlitRemainder(info, width, 4, BlitRGBtoRGBPixelAlpha);
+}
+
+SDL_TARGETING("avx2") static void
+BlitRGBtoRGBSurfaceAlphaAVX2(SDL_BlitInfo * info)
+{
+    const unsigned alpha = info->a;
+    const int width = info->dst_w & ~7;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const __m256i valpha = _mm256_set1_epi32(alpha);
+    const __m256i rbmask = _mm256_set1_epi32(0x00ff00ff);
+    const __m256i gmask = _mm256_set1_epi32(0x0000ff00);
+    const __m256i hmask = _mm256_set1_epi32(0x00fefefe);
+    const __m256i lmask = _mm256_set1_epi32(0x00010101);
+    const __m256i amask = _mm256_set1_epi32(0xff000000);
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 8) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *) (src + n * 4));
+            const __m256i d = _mm256_loadu_si256((const __m256i *) (dst + n * 4));
+            __m256i pixels;
+
+            if (alpha == 128) {
+                pixels = _mm256_add_epi32(_mm256_and_si256(s, hmask), _mm256_and_si256(d, hmask));
+                pixels = _mm256_add_epi32(_mm256_srli_epi32(pixels, 1), _mm256_and_si256(_mm256_and_si256(s, d), lmask));
+            } else {
+                pixels = _mm256_or_si256(BlendChannelsAVX2(s, d, valpha, rbmask),
+                                         BlendChannelsAVX2(s, d, valpha, gmask));
+            }
+            _mm256_storeu_si256((__m256i *) (dst + n * 4), _mm256_or_si256(pixels, amask));
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+    BlitRemainder(info, width, 4, BlitRGBtoRGBSurfaceAlpha);
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+Blend16to16AVX2(__m256i s, __m256i d, const __m256i alpha, const __m256i mask)
+{
+    s = _mm256_and_si256(_mm256_or_si256(s, _mm256_slli_epi32(s, 16)), mask);
+    d = _mm256_and_si256(_mm256_or_si256(d, _mm256_slli_epi32(d, 16)), mask);
+    d = _mm256_add_epi32(d, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s, d), alpha), 5));
+    d = _mm256_and_si256(d, mask);
+    return _mm256_and_si256(_mm256_or_si256(d, _mm256_srli_epi32(d, 16)), _mm256_set1_epi32(0xffff));
+}
+
+SDL_TARGETING("avx2") static void
+Blit16to16SurfaceAlphaAVX2(SDL_BlitInfo * info, Uint16 mask128, Uint32 mask)
+{
+    const unsigned alpha = info->a;
+    const int width = info->dst_w & ~15;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const __m256i valpha = _mm256_set1_epi32(alpha >> 3);
+    const __m256i vmask = _mm256_set1_epi32(mask);
+    const __m256i hmask = _mm256_set1_epi16(mask128);
+    const __m256i lmask = _mm256_set1_epi16(~mask128);
+    const __m256i zero = _mm256_setzero_si256();
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 16) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *) (src + n * 2));
+            const __m256i d = _mm256_loadu_si256((const __m256i *) (dst + n * 2));
+            __m256i pixels;
+
+            if (alpha == 128) {
+                pixels = _mm256_add_epi16(_mm256_srli_epi16(_mm256_and_si256(s, hmask), 1),
+                                          _mm256_srli_epi16(_mm256_and_si256(d, hmask), 1));
+                pixels = _mm256_add_epi16(pixels, _mm256_and_si256(_mm256_and_si256(s, d), lmask));
+            } else {
+                /* the unpacks and the pack all work within 128-bit lanes,
+                   so the pixels come back out in order */
+                pixels = _mm256_packus_epi32(
+                    Blend16to16AVX2(_mm256_unpacklo_epi16(s, zero), _mm256_unpacklo_epi16(d, zero), valpha, vmask),
+                    Blend16to16AVX2(_mm256_unpackhi_epi16(s, zero), _mm256_unpackhi_epi16(d, zero), valpha, vmask));
+            }
+            _mm256_storeu_si256((__m256i *) (dst + n * 2), pixels);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+static void
+Blit565to565SurfaceAlphaAVX2(SDL_BlitInfo * info)
+{
+    Blit16to16SurfaceAlphaAVX2(info, 0xf7de, 0x07e0f81f);
+    BlitRemainder(info, info->dst_w & ~15, 2, Blit565to565SurfaceAlpha);
+}
+
+static void
+Blit555to555SurfaceAlphaAVX2(SDL_BlitInfo * info)
+{
+    Blit16to16SurfaceAlphaAVX2(info, 0xfbde, 0x03e07c1f);
+    BlitRemainder(info, info->dst_w & ~15, 2, Blit555to555SurfaceAlpha);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static SDL_INLINE uint32x4_t
+BlendChannelsNEON(uint32x4_t s, uint32x4_t d, const uint32x4_t alpha, const uint32x4_t mask)
+{
+    s = vandq_u32(s, mask);
+    d = vandq_u32(d, mask);
+    d = vaddq_u32(d, vshrq_n_u32(vmulq_u32(vsubq_u32(s, d), alpha), 8));
+    return vandq_u32(d, mask);
+}
+
+static void
+BlitRGBtoRGBPixelAlphaNEON(SDL_BlitInfo * info)
+{
+    const int width = info->dst_w & ~3;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const uint32x4_t rbmask = vdupq_n_u32(0x00ff00ff);
+    const uint32x4_t gmask = vdupq_n_u32(0x0000ff00);
+    const uint32x4_t opaque = vdupq_n_u32(SDL_ALPHA_OPAQUE);
+    const uint32x4_t zero = vdupq_n_u32(0);
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 4) {
+            const uint32x4_t s = vld1q_u32((const uint32_t *) (src + n * 4));
+            const uint32x4_t d = vld1q_u32((const uint32_t *) (dst + n * 4));
+            const uint32x4_t alpha = vshrq_n_u32(s, 24);
+            uint32x4_t dalpha, pixels;
+
+            dalpha = vmulq_u32(vshrq_n_u32(d, 24), veorq_u32(alpha, opaque));
+            dalpha = vaddq_u32(alpha, vshrq_n_u32(dalpha, 8));
+            pixels = vorrq_u32(BlendChannelsNEON(s, d, alpha, rbmask),
+                               BlendChannelsNEON(s, d, alpha, gmask));
+            pixels = vorrq_u32(pixels, vshlq_n_u32(dalpha, 24));
+            pixels = vbslq_u32(vceqq_u32(alpha, opaque), s, pixels);
+            pixels = vbslq_u32(vceqq_u32(alpha, zero), d, pixels);
+            vst1q_u32((uint32_t *) (dst + n * 4), pixels);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+    BlitRemainder(info, width, 4, BlitRGBtoRGBPixelAlpha);
+}
+
+static void
+BlitRGBtoRGBSurfaceAlphaNEON(SDL_BlitInfo * info)
+{
+    const unsigned alpha = info->a;
+    const int width = info->dst_w & ~3;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const uint32x4_t valpha = vdupq_n_u32(alpha);
+    const uint32x4_t rbmask = vdupq_n_u32(0x00ff00ff);
+    const uint32x4_t gmask = vdupq_n_u32(0x0000ff00);
+    const uint32x4_t hmask = vdupq_n_u32(0x00fefefe);
+    const uint32x4_t lmask = vdupq_n_u32(0x00010101);
+    const uint32x4_t amask = vdupq_n_u32(0xff000000);
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 4) {
+            const uint32x4_t s = vld1q_u32((const uint32_t *) (src + n * 4));
+            const uint32x4_t d = vld1q_u32((const uint32_t *) (dst + n * 4));
+            uint32x4_t pixels;
+
+            if (alpha == 128) {
+                pixels = vaddq_u32(vandq_u32(s, hmask), vandq_u32(d, hmask));
+                pixels = vaddq_u32(vshrq_n_u32(pixels, 1), vandq_u32(vandq_u32(s, d), lmask));
+            } else {
+                pixels = vorrq_u32(BlendChannelsNEON(s, d, valpha, rbmask),
+                                   BlendChannelsNEON(s, d, valpha, gmask));
+            }
+            vst1q_u32((uint32_t *) (dst + n * 4), vorrq_u32(pixels, amask));
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+    BlitRemainder(info, width, 4, BlitRGBtoRGBSurfaceAlpha);
+}
+
+static SDL_INLINE uint16x4_t
+Blend16to16NEON(const uint16x4_t s16, const uint16x4_t d16, const uint32x4_t alpha, const uint32x4_t mask)
+{
+    uint32x4_t s = vmovl_u16(s16);
+    uint32x4_t d = vmovl_u16(d16);
+    s = vandq_u32(vorrq_u32(s, vshlq_n_u32(s, 16)), mask);
+    d = vandq_u32(vorrq_u32(d, vshlq_n_u32(d, 16)), mask);
+    d = vaddq_u32(d, vshrq_n_u32(vmulq_u32(vsubq_u32(s, d), alpha), 5));
+    d = vandq_u32(d, mask);
+    return vmovn_u32(vorrq_u32(d, vshrq_n_u32(d, 16)));
+}
+
+static void
+Blit16to16SurfaceAlphaNEON(SDL_BlitInfo * info, Uint16 mask128, Uint32 mask)
+{
+    const unsigned alpha = info->a;
+    const int width = info->dst_w & ~7;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const uint32x4_t valpha = vdupq_n_u32(alpha >> 3);
+    const uint32x4_t vmask = vdupq_n_u32(mask);
+    const uint16x8_t hmask = vdupq_n_u16(mask128);
+    const uint16x8_t lmask = vdupq_n_u16((Uint16) ~mask128);
+
+    while (height--) {
+        int n;
+        for (n = 0; n < width; n += 8) {
+            const uint16x8_t s = vld1q_u16((const uint16_t *) (src + n * 2));
+            const uint16x8_t d = vld1q_u16((const uint16_t *) (dst + n * 2));
+            uint16x8_t pixels;
+
+            if (alpha == 128) {
+                pixels = vaddq_u16(vshrq_n_u16(vandq_u16(s, hmask), 1),
+                                   vshrq_n_u16(vandq_u16(d, hmask), 1));
+                pixels = vaddq_u16(pixels, vandq_u16(vandq_u16(s, d), lmask));
+            } else {
+                pixels = vcombine_u16(
+                    Blend16to16NEON(vget_low_u16(s), vget_low_u16(d), valpha, vmask),
+                    Blend16to16NEON(vget_high_u16(s), vget_high_u16(d), valpha, vmask));
+            }
+            vst1q_u16((uint16_t *) (dst + n * 2), pixels);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+static void
+Blit565to565SurfaceAlphaNEON(SDL_BlitInfo * info)
+{
+    Blit16to16SurfaceAlphaNEON(info, 0xf7de, 0x07e0f81f);
+    BlitRemainder(info, info->dst_w & ~7, 2, Blit565to565SurfaceAlpha);
+}
+
+static void
+Blit555to555SurfaceAlphaNEON(SDL_BlitInfo * info)
+{
+    Blit16to16SurfaceAlphaNEON(info, 0xfbde, 0x03e07c1f);
+    BlitRemainder(info, info->dst_w & ~7, 2, Blit555to555SurfaceAlpha);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
 /* General (slow) N->N blending with per-surface alpha */
 static void
 BlitNtoNSurfaceAlpha(SDL_BlitInfo * info)
@@ -1294,6 +1776,20 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             if (sf->Rmask == df->Rmask
                 && sf->Gmask == df->Gmask
                 && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+                if (sf->Amask == 0xff000000) {
+#if HAVE_AVX2_INTRINSICS
+                    if (SDL_HasAVX2())
+                        return BlitRGBtoRGBPixelAlphaAVX2;
+#endif
+#if HAVE_SSE41_INTRINSICS
+                    if (SDL_HasSSE41())
+                        return BlitRGBtoRGBPixelAlphaSSE41;
+#endif
+#if HAVE_NEON_INTRINSICS
+                    if (SDL_HasNEON())
+                        return BlitRGBtoRGBPixelAlphaNEON;
+#endif
+                }
 #if defined(__MMX__) || defined(__3dNOW__)
                 if (sf->Rshift % 8 == 0
                     && sf->Gshift % 8 == 0
@@ -1331,6 +1827,18 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             case 2:
                 if (surface->map->identity) {
                     if (df->Gmask == 0x7e0) {
+#if HAVE_AVX2_INTRINSICS
+                        if (SDL_HasAVX2())
+                            return Blit565to565SurfaceAlphaAVX2;
+#endif
+#if HAVE_SSE41_INTRINSICS
+                        if (SDL_HasSSE41())
+                            return Blit565to565SurfaceAlphaSSE41;
+#endif
+#if HAVE_NEON_INTRINSICS
+                        if (SDL_HasNEON())
+                            return Blit565to565SurfaceAlphaNEON;
+#endif
 #ifdef __MMX__
                         if (SDL_HasMMX())
                             return Blit565to565SurfaceAlphaMMX;
@@ -1338,6 +1846,18 @@ SDL_CalculateBlitA(SDL_Surface * surface)
 #endif
                             return Blit565to565SurfaceAlpha;
                     } else if (df->Gmask == 0x3e0) {
+#if HAVE_AVX2_INTRINSICS
+                        if (SDL_HasAVX2())
+                            return Blit555to555SurfaceAlphaAVX2;
+#endif
+#if HAVE_SSE41_INTRINSICS
+                        if (SDL_HasSSE41())
+                            return Blit555to555SurfaceAlphaSSE41;
+#endif
+#if HAVE_NEON_INTRINSICS
+                        if (SDL_HasNEON())
+                            return Blit555to555SurfaceAlphaNEON;
+#endif
 #ifdef __MMX__
                         if (SDL_HasMMX())
                             return Blit555to555SurfaceAlphaMMX;
@@ -1352,6 +1872,20 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                 if (sf->Rmask == df->Rmask
                     && sf->Gmask == df->Gmask
                     && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+                    if ((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
+#if HAVE_AVX2_INTRINSICS
+                        if (SDL_HasAVX2())
+                            return BlitRGBtoRGBSurfaceAlphaAVX2;
+#endif
+#if HAVE_SSE41_INTRINSICS
+                        if (SDL_HasSSE41())
+                            return BlitRGBtoRGBSurfaceAlphaSSE41;
+#endif
+#if HAVE_NEON_INTRINSICS
+                        if (SDL_HasNEON())
+                            return BlitRGBtoRGBSurfaceAlphaNEON;
+#endif
+                    }
 #ifdef __MMX__
                     if (sf->Rshift % 8 == 0
                         && sf->Gshift % 8 == 0
@@ -24,6 +24,7 @@
 #include "SDL_endian.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_blit.h"
+#include "../cpuinfo/SDL_simd.h"
 
 #include "SDL_assert.h"
 
@@ -874,8 +875,26 @@ GetBlitFeatures(void)
 #pragma altivec_model off
 #endif
 #else
-/* Feature 1 is has-MMX */
-#define GetBlitFeatures() ((Uint32)(SDL_HasMMX() ? 1 : 0))
+/* Feature 1 is has-MMX, feature 8 is has-SSSE3 (checked with
+   SDL_HasSSE41(), every CPU with SSE4.1 also has SSSE3), feature 16 is
+   has-NEON */
+static Uint32
+GetBlitFeatures(void)
+{
+    /* Provide an override for testing .. It isn't cached, so a test can
+       switch between the SIMD and the C blitters; empty means no override. */
+    const char *override = SDL_getenv("SDL_BLIT_N_FEATURES");
+    Uint32 features = 0;
+
+    if (override && *override) {
+        SDL_sscanf(override, "%u", &features);
+    } else {
+        features = ((SDL_HasMMX() ? 1 : 0) |
+                    (SDL_HasSSE41() ? 8 : 0) |
+                    (SDL_HasNEON() ? 16 : 0));
+    }
+    return features;
+}
 #endif
 
 /* This is now endian dependent */
@@ -2462,6 +2481,386 @@ BlitNto2101010(SDL_BlitInfo * info)
     }
 }
 
+#if HAVE_SSSE3_INTRINSICS || HAVE_NEON_INTRINSICS
+/* SIMD conversions between 32-bit formats with byte aligned 8-bit channels,
+   and between those and 16-bit 5-6-5 / 5-5-5. They give exactly the same
+   results as the C blitters they replace: a swizzle does what BlitNtoN()
+   and BlitNtoNCopyAlpha() do, packing truncates like ASSEMBLE_RGB, and
+   expanding 5-6-5 computes what the Blit_RGB565_32() tables hold, with the
+   spare byte set to 0xFF. Pixels left over at the end of a row are
+   converted one at a time. */
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define SHIFT_TO_BYTE(shift) ((shift) / 8)
+#else
+#define SHIFT_TO_BYTE(shift) (3 - (shift) / 8)
+#endif
+
+/* Fill in the byte shuffle for four pixels: shuffle[i] is the source byte
+   that ends up in destination byte i, or 0x80 if the byte is set to fill[i]
+   instead. */
+static void
+GetSwizzle32(const SDL_BlitInfo * info, Uint8 shuffle[16], Uint8 fill[16])
+{
+    const SDL_PixelFormat *srcfmt = info->src_fmt;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        shuffle[i] = 0x80;
+        fill[i] = 0;
+    }
+    shuffle[SHIFT_TO_BYTE(dstfmt->Rshift)] = SHIFT_TO_BYTE(srcfmt->Rshift);
+    shuffle[SHIFT_TO_BYTE(dstfmt->Gshift)] = SHIFT_TO_BYTE(srcfmt->Gshift);
+    shuffle[SHIFT_TO_BYTE(dstfmt->Bshift)] = SHIFT_TO_BYTE(srcfmt->Bshift);
+    if (dstfmt->Amask) {
+        if (srcfmt->Amask) {
+            shuffle[SHIFT_TO_BYTE(dstfmt->Ashift)] = SHIFT_TO_BYTE(srcfmt->Ashift);
+        } else {
+            fill[SHIFT_TO_BYTE(dstfmt->Ashift)] = info->a;
+        }
+    }
+    for (i = 4; i < 16; ++i) {
+        shuffle[i] = (shuffle[i - 4] & 0x80) ? 0x80 : (shuffle[i - 4] + 4);
+        fill[i] = fill[i - 4];
+    }
+}
+
+static SDL_INLINE void
+Swizzle32(const Uint8 * src, Uint8 * dst, const Uint8 shuffle[16],
+          const Uint8 fill[16], int width)
+{
+    int i;
+
+    while (width--) {
+        for (i = 0; i < 4; ++i) {
+            dst[i] = (shuffle[i] & 0x80) ? fill[i] : src[shuffle[i]];
+        }
+        src += 4;
+        dst += 4;
+    }
+}
+
+/* The tables scale red and blue by 255/31, rounding down, and add up green
+   from the two halves of the pixel, rounding each down separately */
+static SDL_INLINE Uint32
+ExpandRGB565(Uint32 pixel, const SDL_PixelFormat * dstfmt)
+{
+    const Uint32 r = (((pixel >> 11) & 0x1F) * 1053) >> 7;
+    const Uint32 g = (((pixel >> 5) & 0x07) << 2) + ((((pixel >> 8) & 0x07) * 259) >> 3);
+    const Uint32 b = ((pixel & 0x1F) * 1053) >> 7;
+
+    return (r << dstfmt->Rshift) | (g << dstfmt->Gshift) |
+        (b << dstfmt->Bshift) |
+        ~(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask);
+}
+
+static SDL_INLINE Uint16
+Pack8888to16(Uint32 pixel, const SDL_PixelFormat * srcfmt,
+             const SDL_PixelFormat * dstfmt)
+{
+    return (Uint16)
+        ((((pixel >> (srcfmt->Rshift + dstfmt->Rloss)) << dstfmt->Rshift) & dstfmt->Rmask) |
+         (((pixel >> (srcfmt->Gshift + dstfmt->Gloss)) << dstfmt->Gshift) & dstfmt->Gmask) |
+         (((pixel >> (srcfmt->Bshift + dstfmt->Bloss)) << dstfmt->Bshift) & dstfmt->Bmask));
+}
+#endif /* HAVE_SSSE3_INTRINSICS || HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSSE3_INTRINSICS
+SDL_TARGETING("ssse3") static void
+Blit4to4SwizzleSSSE3(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    Uint8 shuffle[16], fill[16];
+    __m128i mask, alpha;
+
+    GetSwizzle32(info, shuffle, fill);
+    mask = _mm_loadu_si128((const __m128i *) shuffle);
+    alpha = _mm_loadu_si128((const __m128i *) fill);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            __m128i lo = _mm_loadu_si128((const __m128i *) s);
+            __m128i hi = _mm_loadu_si128((const __m128i *) (s + 16));
+            lo = _mm_or_si128(_mm_shuffle_epi8(lo, mask), alpha);
+            hi = _mm_or_si128(_mm_shuffle_epi8(hi, mask), alpha);
+            _mm_storeu_si128((__m128i *) d, lo);
+            _mm_storeu_si128((__m128i *) (d + 16), hi);
+            s += 32;
+            d += 32;
+        }
+        Swizzle32(s, d, shuffle, fill, n);
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_TARGETING("ssse3") static SDL_INLINE __m128i
+Expand565ChannelsSSSE3(__m128i r, __m128i g, __m128i b, __m128i rshift,
+                       __m128i gshift, __m128i bshift, __m128i alpha)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_sll_epi32(r, rshift),
+                                     _mm_sll_epi32(g, gshift)),
+                        _mm_or_si128(_mm_sll_epi32(b, bshift), alpha));
+}
+
+SDL_TARGETING("ssse3") static void
+Blit_RGB565_32SSSE3(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const __m128i rshift = _mm_cvtsi32_si128(dstfmt->Rshift);
+    const __m128i gshift = _mm_cvtsi32_si128(dstfmt->Gshift);
+    const __m128i bshift = _mm_cvtsi32_si128(dstfmt->Bshift);
+    const __m128i alpha = _mm_set1_epi32((int)
+        ~(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask));
+    const __m128i mask1F = _mm_set1_epi16(0x1F);
+    const __m128i mask07 = _mm_set1_epi16(0x07);
+    const __m128i mul1053 = _mm_set1_epi16(1053);
+    const __m128i mul259 = _mm_set1_epi16(259);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (height--) {
+        const Uint16 *s = (const Uint16 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m128i p = _mm_loadu_si128((const __m128i *) s);
+            const __m128i r = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(p, 11), mul1053), 7);
+            const __m128i g = _mm_add_epi16(
+                _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(p, 5), mask07), 2),
+                _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 8), mask07), mul259), 3));
+            const __m128i b = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(p, mask1F), mul1053), 7);
+            _mm_storeu_si128((__m128i *) d,
+                Expand565ChannelsSSSE3(_mm_unpacklo_epi16(r, zero),
+                                       _mm_unpacklo_epi16(g, zero),
+                                       _mm_unpacklo_epi16(b, zero),
+                                       rshift, gshift, bshift, alpha));
+            _mm_storeu_si128((__m128i *) (d + 4),
+                Expand565ChannelsSSSE3(_mm_unpackhi_epi16(r, zero),
+                                       _mm_unpackhi_epi16(g, zero),
+                                       _mm_unpackhi_epi16(b, zero),
+                                       rshift, gshift, bshift, alpha));
+            s += 8;
+            d += 8;
+        }
+        while (n--) {
+            *d++ = ExpandRGB565(*s++, dstfmt);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_TARGETING("ssse3") static SDL_INLINE __m128i
+Pack8888to16SSSE3(__m128i p, const __m128i in[3], const __m128i out[3],
+                  const __m128i mask[3], __m128i lowhalves)
+{
+    __m128i r = _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p, in[0]), out[0]), mask[0]);
+    __m128i g = _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p, in[1]), out[1]), mask[1]);
+    __m128i b = _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p, in[2]), out[2]), mask[2]);
+    return _mm_shuffle_epi8(_mm_or_si128(_mm_or_si128(r, g), b), lowhalves);
+}
+
+SDL_TARGETING("ssse3") static void
+Blit_8888_16SSSE3(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const SDL_PixelFormat *srcfmt = info->src_fmt;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const __m128i lowhalves = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13,
+                                            -1, -1, -1, -1, -1, -1, -1, -1);
+    __m128i in[3], out[3], mask[3];
+
+    in[0] = _mm_cvtsi32_si128(srcfmt->Rshift + dstfmt->Rloss);
+    in[1] = _mm_cvtsi32_si128(srcfmt->Gshift + dstfmt->Gloss);
+    in[2] = _mm_cvtsi32_si128(srcfmt->Bshift + dstfmt->Bloss);
+    out[0] = _mm_cvtsi32_si128(dstfmt->Rshift);
+    out[1] = _mm_cvtsi32_si128(dstfmt->Gshift);
+    out[2] = _mm_cvtsi32_si128(dstfmt->Bshift);
+    mask[0] = _mm_set1_epi32(dstfmt->Rmask);
+    mask[1] = _mm_set1_epi32(dstfmt->Gmask);
+    mask[2] = _mm_set1_epi32(dstfmt->Bmask);
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint16 *d = (Uint16 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m128i lo = Pack8888to16SSSE3(_mm_loadu_si128((const __m128i *) s),
+                                                 in, out, mask, lowhalves);
+            const __m128i hi = Pack8888to16SSSE3(_mm_loadu_si128((const __m128i *) (s + 4)),
+                                                 in, out, mask, lowhalves);
+            _mm_storeu_si128((__m128i *) d, _mm_unpacklo_epi64(lo, hi));
+            s += 8;
+            d += 8;
+        }
+        while (n--) {
+            *d++ = Pack8888to16(*s++, srcfmt, dstfmt);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_SSSE3_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static void
+Blit4to4SwizzleNEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    Uint8 shuffle[16], fill[16];
+    uint8x8_t mask;
+    uint8x16_t alpha;
+
+    /* vtbl1_u8() gives zero for indices past the end of the table, which
+       takes care of the 0x80 entries */
+    GetSwizzle32(info, shuffle, fill);
+    mask = vld1_u8(shuffle);
+    alpha = vld1q_u8(fill);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const uint8x16_t p = vld1q_u8(s);
+            const uint8x16_t q = vcombine_u8(vtbl1_u8(vget_low_u8(p), mask),
+                                             vtbl1_u8(vget_high_u8(p), mask));
+            vst1q_u8(d, vorrq_u8(q, alpha));
+            s += 16;
+            d += 16;
+        }
+        Swizzle32(s, d, shuffle, fill, n);
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+static SDL_INLINE uint32x4_t
+Expand565PixelsNEON(uint32x4_t p, int32x4_t rshift, int32x4_t gshift,
+                    int32x4_t bshift, uint32x4_t alpha)
+{
+    const uint32x4_t mask07 = vdupq_n_u32(0x07);
+    const uint32x4_t mul1053 = vdupq_n_u32(1053);
+    const uint32x4_t r8 = vshrq_n_u32(vmulq_u32(vshrq_n_u32(p, 11), mul1053), 7);
+    const uint32x4_t g8 = vaddq_u32(
+        vshlq_n_u32(vandq_u32(vshrq_n_u32(p, 5), mask07), 2),
+        vshrq_n_u32(vmulq_u32(vandq_u32(vshrq_n_u32(p, 8), mask07), vdupq_n_u32(259)), 3));
+    const uint32x4_t b8 = vshrq_n_u32(vmulq_u32(vandq_u32(p, vdupq_n_u32(0x1F)), mul1053), 7);
+    return vorrq_u32(vorrq_u32(vshlq_u32(r8, rshift), vshlq_u32(g8, gshift)),
+                     vorrq_u32(vshlq_u32(b8, bshift), alpha));
+}
+
+static void
+Blit_RGB565_32NEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const int32x4_t rshift = vdupq_n_s32(dstfmt->Rshift);
+    const int32x4_t gshift = vdupq_n_s32(dstfmt->Gshift);
+    const int32x4_t bshift = vdupq_n_s32(dstfmt->Bshift);
+    const uint32x4_t alpha =
+        vdupq_n_u32(~(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask));
+
+    while (height--) {
+        const Uint16 *s = (const Uint16 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const uint16x8_t p = vld1q_u16(s);
+            vst1q_u32(d, Expand565PixelsNEON(vmovl_u16(vget_low_u16(p)),
+                                             rshift, gshift, bshift, alpha));
+            vst1q_u32(d + 4, Expand565PixelsNEON(vmovl_u16(vget_high_u16(p)),
+                                                 rshift, gshift, bshift, alpha));
+            s += 8;
+            d += 8;
+        }
+        while (n--) {
+            *d++ = ExpandRGB565(*s++, dstfmt);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+static SDL_INLINE uint16x4_t
+Pack8888to16NEON(uint32x4_t p, const int32x4_t in[3], const int32x4_t out[3],
+                 const uint32x4_t mask[3])
+{
+    /* vshlq_u32() shifts right for negative counts */
+    const uint32x4_t r = vandq_u32(vshlq_u32(vshlq_u32(p, in[0]), out[0]), mask[0]);
+    const uint32x4_t g = vandq_u32(vshlq_u32(vshlq_u32(p, in[1]), out[1]), mask[1]);
+    const uint32x4_t b = vandq_u32(vshlq_u32(vshlq_u32(p, in[2]), out[2]), mask[2]);
+    return vmovn_u32(vorrq_u32(vorrq_u32(r, g), b));
+}
+
+static void
+Blit_8888_16NEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const SDL_PixelFormat *srcfmt = info->src_fmt;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    int32x4_t in[3], out[3];
+    uint32x4_t mask[3];
+
+    in[0] = vdupq_n_s32(-(srcfmt->Rshift + dstfmt->Rloss));
+    in[1] = vdupq_n_s32(-(srcfmt->Gshift + dstfmt->Gloss));
+    in[2] = vdupq_n_s32(-(srcfmt->Bshift + dstfmt->Bloss));
+    out[0] = vdupq_n_s32(dstfmt->Rshift);
+    out[1] = vdupq_n_s32(dstfmt->Gshift);
+    out[2] = vdupq_n_s32(dstfmt->Bshift);
+    mask[0] = vdupq_n_u32(dstfmt->Rmask);
+    mask[1] = vdupq_n_u32(dstfmt->Gmask);
+    mask[2] = vdupq_n_u32(dstfmt->Bmask);
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint16 *d = (Uint16 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const uint16x4_t lo = Pack8888to16NEON(vld1q_u32(s), in, out, mask);
+            const uint16x4_t hi = Pack8888to16NEON(vld1q_u32(s + 4), in, out, mask);
+            vst1q_u16(d, vcombine_u16(lo, hi));
+            s += 8;
+            d += 8;
+        }
+        while (n--) {
+            *d++ = Pack8888to16(*s++, srcfmt, dstfmt);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
 /* Normal N to N optimized blitters */
 #define NO_ALPHA   1
 #define SET_ALPHA  2
@@ -2475,6 +2874,43 @@ struct blit_table
     SDL_BlitFunc blitfunc;
     Uint32 alpha;  /* bitwise NO_ALPHA, SET_ALPHA, COPY_ALPHA */
 };
+
+#if HAVE_SSSE3_INTRINSICS || HAVE_NEON_INTRINSICS
+/* R, G and B masks of the byte aligned 32-bit layouts */
+#define MASKS_XRGB 0x00FF0000, 0x0000FF00, 0x000000FF
+#define MASKS_XBGR 0x000000FF, 0x0000FF00, 0x00FF0000
+#define MASKS_RGBX 0xFF000000, 0x00FF0000, 0x0000FF00
+#define MASKS_BGRX 0x0000FF00, 0x00FF0000, 0xFF000000
+#define MASKS_565  0x0000F800, 0x000007E0, 0x0000001F
+#define MASKS_555  0x00007C00, 0x000003E0, 0x0000001F
+
+#define SIMD_BLIT_2(features, expand) \
+    {MASKS_565, 4, MASKS_XRGB, features, expand, NO_ALPHA | COPY_ALPHA | SET_ALPHA}, \
+    {MASKS_565, 4, MASKS_XBGR, features, expand, NO_ALPHA | COPY_ALPHA | SET_ALPHA}, \
+    {MASKS_565, 4, MASKS_RGBX, features, expand, NO_ALPHA | COPY_ALPHA | SET_ALPHA}, \
+    {MASKS_565, 4, MASKS_BGRX, features, expand, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+
+/* Formats with the same RGB layout are left to Blit4to4CopyAlpha() and
+   Blit4to4MaskAlpha() */
+#define SIMD_SWIZZLE_FROM(srcmasks, dst1, dst2, dst3, features, swizzle) \
+    {srcmasks, 4, dst1, features, swizzle, NO_ALPHA | COPY_ALPHA | SET_ALPHA}, \
+    {srcmasks, 4, dst2, features, swizzle, NO_ALPHA | COPY_ALPHA | SET_ALPHA}, \
+    {srcmasks, 4, dst3, features, swizzle, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+
+#define SIMD_PACK_FROM(srcmasks, features, pack) \
+    {srcmasks, 2, MASKS_565, features, pack, NO_ALPHA}, \
+    {srcmasks, 2, MASKS_555, features, pack, NO_ALPHA},
+
+#define SIMD_BLIT_4(features, swizzle, pack) \
+    SIMD_SWIZZLE_FROM(MASKS_XRGB, MASKS_XBGR, MASKS_RGBX, MASKS_BGRX, features, swizzle) \
+    SIMD_SWIZZLE_FROM(MASKS_XBGR, MASKS_XRGB, MASKS_RGBX, MASKS_BGRX, features, swizzle) \
+    SIMD_SWIZZLE_FROM(MASKS_RGBX, MASKS_XRGB, MASKS_XBGR, MASKS_BGRX, features, swizzle) \
+    SIMD_SWIZZLE_FROM(MASKS_BGRX, MASKS_XRGB, MASKS_XBGR, MASKS_RGBX, features, swizzle) \
+    SIMD_PACK_FROM(MASKS_XRGB, features, pack) \
+    SIMD_PACK_FROM(MASKS_XBGR, features, pack) \
+    SIMD_PACK_FROM(MASKS_RGBX, features, pack) \
+    SIMD_PACK_FROM(MASKS_BGRX, features, pack)
+#endif
 static const struct blit_table normal_blit_1[] = {
     /* Default for 8-bit RGB source, never optimized */
     {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0}
@@ -2487,6 +2923,14 @@ static const struct blit_table normal_blit_2[] = {
      2, Blit_RGB565_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     {0x00007C00, 0x000003E0, 0x0000001F, 4, 0x00000000, 0x00000000, 0x00000000,
      2, Blit_RGB555_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+#endif
+#if HAVE_SSSE3_INTRINSICS
+    /* has-SSSE3 */
+    SIMD_BLIT_2(8, Blit_RGB565_32SSSE3)
+#endif
+#if HAVE_NEON_INTRINSICS
+    /* has-NEON */
+    SIMD_BLIT_2(16, Blit_RGB565_32NEON)
 #endif
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
      0, Blit_RGB565_ARGB8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
@@ -2517,6 +2961,14 @@ static const struct blit_table normal_blit_4[] = {
     /* has-altivec */
     {0x00000000, 0x00000000, 0x00000000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
      2, Blit_RGB888_RGB565Altivec, NO_ALPHA},
+#endif
+#if HAVE_SSSE3_INTRINSICS
+    /* has-SSSE3 */
+    SIMD_BLIT_4(8, Blit4to4SwizzleSSSE3, Blit_8888_16SSSE3)
+#endif
+#if HAVE_NEON_INTRINSICS
+    /* has-NEON */
+    SIMD_BLIT_4(16, Blit4to4SwizzleNEON, Blit_8888_16NEON)
 #endif
     {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
      0, Blit_RGB888_RGB565, NO_ALPHA},
@@ -2570,6 +3022,7 @@ SDL_CalculateBlitN(SDL_Surface * surface)
             }
         } else {
             /* Now the meat, choose the blitter we want */
+            const Uint32 features = GetBlitFeatures();
             int a_need = NO_ALPHA;
             if (dstfmt->Amask)
                 a_need = srcfmt->Amask ? COPY_ALPHA : SET_ALPHA;
@@ -2583,7 +3036,7 @@ SDL_CalculateBlitN(SDL_Surface * surface)
                     MASKOK(dstfmt->Bmask, table[which].dstB) &&
                     dstfmt->BytesPerPixel == table[which].dstbpp &&
                     (a_need & table[which].alpha) == a_need &&
-                    ((table[which].blit_features & GetBlitFeatures()) ==
+                    ((table[which].blit_features & features) ==
                      table[which].blit_features))
                     break;
             }
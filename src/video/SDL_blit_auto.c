@@ -26,6 +26,15 @@
 #include "SDL_video.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
+#include "../cpuinfo/SDL_simd.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#undef HAVE_NEON_INTRINSICS  /* the NEON blitters find channels by byte offset */
+#endif
 
 static void SDL_Blit_RGB888_RGB888_Scale(SDL_BlitInfo *info)
 {
@@ -7284,7 +7293,2869 @@ static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+/* The SIMD blitters below do exactly what the scalar ones above do, several
+   pixels at a time: (x + 1 + (x >> 8)) >> 8 is exactly x / 255 for every
+   product of two channels, and scaled pixel n comes from source pixel
+   (n * incx) >> 16, the same one the scalar loop steps to. Each one takes
+   the pixel layouts as arguments, so the SDL_Blit_*_<ISA> entry points for
+   an instruction set share a single loop. */
+
+#if HAVE_AVX2_INTRINSICS
+
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+SDL_Blit8888_Div255_AVX2(const __m256i x)
+{
+    return _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(_mm256_srli_epi32(x, 8), _mm256_set1_epi32(1))), 8);
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+SDL_Blit8888_Mul255_AVX2(const __m256i a, const __m256i b)
+{
+    return SDL_Blit8888_Div255_AVX2(_mm256_mullo_epi16(a, b));
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+SDL_Blit8888_Channel_AVX2(const __m256i pixels, const int shift)
+{
+    return _mm256_and_si256(_mm256_srli_epi32(pixels, shift), _mm256_set1_epi32(0xFF));
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+SDL_Blit8888_Pixels_AVX2(const __m256i src, const __m256i dst, const int flags,
+                         const int srshift, const int sgshift, const int sbshift, const int sashift,
+                         const int drshift, const int dgshift, const int dbshift, const int dashift,
+                         const int modulate, const int blend, const __m256i *mod)
+{
+    const __m256i full = _mm256_set1_epi32(0xFF);
+    __m256i R = SDL_Blit8888_Channel_AVX2(src, srshift);
+    __m256i G = SDL_Blit8888_Channel_AVX2(src, sgshift);
+    __m256i B = SDL_Blit8888_Channel_AVX2(src, sbshift);
+    __m256i A = (sashift < 0) ? full : SDL_Blit8888_Channel_AVX2(src, sashift);
+    __m256i pixels;
+
+    if (modulate) {
+        if (flags & SDL_COPY_MODULATE_COLOR) {
+            R = SDL_Blit8888_Mul255_AVX2(R, mod[0]);
+            G = SDL_Blit8888_Mul255_AVX2(G, mod[1]);
+            B = SDL_Blit8888_Mul255_AVX2(B, mod[2]);
+        }
+        if (flags & SDL_COPY_MODULATE_ALPHA) {
+            A = SDL_Blit8888_Mul255_AVX2(A, mod[3]);
+        }
+    }
+    if (blend) {
+        __m256i dR = SDL_Blit8888_Channel_AVX2(dst, drshift);
+        __m256i dG = SDL_Blit8888_Channel_AVX2(dst, dgshift);
+        __m256i dB = SDL_Blit8888_Channel_AVX2(dst, dbshift);
+        __m256i dA = (dashift < 0) ? _mm256_setzero_si256() : SDL_Blit8888_Channel_AVX2(dst, dashift);
+        __m256i inv;
+
+        if (flags & (SDL_COPY_BLEND|SDL_COPY_ADD)) {
+            R = SDL_Blit8888_Mul255_AVX2(R, A);
+            G = SDL_Blit8888_Mul255_AVX2(G, A);
+            B = SDL_Blit8888_Mul255_AVX2(B, A);
+        }
+        switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD)) {
+        case SDL_COPY_BLEND:
+            inv = _mm256_sub_epi32(full, A);
+            dR = _mm256_add_epi32(R, SDL_Blit8888_Mul255_AVX2(inv, dR));
+            dG = _mm256_add_epi32(G, SDL_Blit8888_Mul255_AVX2(inv, dG));
+            dB = _mm256_add_epi32(B, SDL_Blit8888_Mul255_AVX2(inv, dB));
+            dA = _mm256_add_epi32(A, SDL_Blit8888_Mul255_AVX2(inv, dA));
+            break;
+        case SDL_COPY_ADD:
+            dR = _mm256_min_epi16(_mm256_add_epi32(R, dR), full);
+            dG = _mm256_min_epi16(_mm256_add_epi32(G, dG), full);
+            dB = _mm256_min_epi16(_mm256_add_epi32(B, dB), full);
+            break;
+        case SDL_COPY_MOD:
+            dR = SDL_Blit8888_Mul255_AVX2(R, dR);
+            dG = SDL_Blit8888_Mul255_AVX2(G, dG);
+            dB = SDL_Blit8888_Mul255_AVX2(B, dB);
+            break;
+        }
+        R = dR;
+        G = dG;
+        B = dB;
+        A = dA;
+    }
+
+    pixels = _mm256_or_si256(_mm256_slli_epi32(R, drshift), _mm256_slli_epi32(G, dgshift));
+    pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(B, dbshift));
+    if (dashift >= 0) {
+        pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(A, dashift));
+    }
+    return pixels;
+}
+
+SDL_TARGETING("avx2") static void
+SDL_Blit8888_AVX2(SDL_BlitInfo *info,
+                  const int srshift, const int sgshift, const int sbshift, const int sashift,
+                  const int drshift, const int dgshift, const int dbshift, const int dashift,
+                  const int modulate, const int blend, const int scale)
+{
+    const int flags = info->flags;
+    const SDL_bool copy = !modulate && !blend &&
+                          srshift == drshift && sgshift == dgshift &&
+                          sbshift == dbshift && sashift == dashift;
+    Uint32 swizzle = 0x80808080, fill = 0;
+    __m256i mod[4], shuffle, alpha, steps;
+    Uint32 srcbuf[8], dstbuf[8];
+    int srcy = 0, posy = 0;
+    int incy = 0, incx = 0;
+
+    /* A plain format conversion is a byte shuffle, with zero (0x80) for the
+       bytes that aren't used and opaque alpha if the source doesn't have any */
+    swizzle &= ~(0xFFu << drshift);
+    swizzle |= (Uint32)(srshift >> 3) << drshift;
+    swizzle &= ~(0xFFu << dgshift);
+    swizzle |= (Uint32)(sgshift >> 3) << dgshift;
+    swizzle &= ~(0xFFu << dbshift);
+    swizzle |= (Uint32)(sbshift >> 3) << dbshift;
+    if (dashift >= 0) {
+        if (sashift >= 0) {
+            swizzle &= ~(0xFFu << dashift);
+            swizzle |= (Uint32)(sashift >> 3) << dashift;
+        } else {
+            fill = 0xFFu << dashift;
+        }
+    }
+    shuffle = _mm256_add_epi32(_mm256_set1_epi32(swizzle),
+                               _mm256_setr_epi32(0x00000000, 0x04040404, 0x08080808, 0x0C0C0C0C,
+                                                 0x00000000, 0x04040404, 0x08080808, 0x0C0C0C0C));
+    alpha = _mm256_set1_epi32(fill);
+
+    mod[0] = _mm256_set1_epi32(info->r);
+    mod[1] = _mm256_set1_epi32(info->g);
+    mod[2] = _mm256_set1_epi32(info->b);
+    mod[3] = _mm256_set1_epi32(info->a);
+    SDL_zero(srcbuf);
+    SDL_zero(dstbuf);
+    if (scale) {
+        incy = (info->src_h << 16) / info->dst_h;
+        incx = (info->src_w << 16) / info->dst_w;
+    }
+    steps = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(incx));
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+
+        if (scale) {
+            while (posy >= 0x10000) {
+                ++srcy;
+                posy -= 0x10000;
+            }
+            src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        }
+        while (n > 0) {
+            const int count = (n < 8) ? n : 8;
+            const Uint32 *s = src;
+            Uint32 *d = (count < 8) ? dstbuf : dst;
+            __m256i pixels;
+            int i;
+
+            if (scale && count == 8) {
+                pixels = _mm256_i32gather_epi32((const int *)src,
+                                                _mm256_srli_epi32(_mm256_add_epi32(_mm256_set1_epi32(posx), steps), 16), 4);
+                posx += 8 * incx;
+            } else {
+                if (scale) {
+                    for (i = 0; i < count; ++i) {
+                        srcbuf[i] = src[posx >> 16];
+                        posx += incx;
+                    }
+                    s = srcbuf;
+                } else if (count < 8) {
+                    SDL_memcpy(srcbuf, src, count * sizeof (Uint32));
+                    s = srcbuf;
+                }
+                pixels = _mm256_loadu_si256((const __m256i *)s);
+            }
+            if (blend && count < 8) {
+                SDL_memcpy(dstbuf, dst, count * sizeof (Uint32));
+            }
+
+            if (copy) {
+                /* nothing to do */
+            } else if (!modulate && !blend) {
+                pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha);
+            } else {
+                pixels = SDL_Blit8888_Pixels_AVX2(pixels, blend ? _mm256_loadu_si256((const __m256i *)d) : pixels, flags,
+                                                  srshift, sgshift, sbshift, sashift,
+                                                  drshift, dgshift, dbshift, dashift,
+                                                  modulate, blend, mod);
+            }
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (count < 8) {
+                SDL_memcpy(dst, dstbuf, count * sizeof (Uint32));
+            }
+            if (!scale) {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 1, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 0, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 0, 1);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 1, 0);
+}
+
+SDL_TARGETING("avx2") static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_AVX2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 1, 1);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+
+static SDL_INLINE __m128i
+SDL_Blit8888_Div255_SSE2(const __m128i x)
+{
+    return _mm_srli_epi32(_mm_add_epi32(x, _mm_add_epi32(_mm_srli_epi32(x, 8), _mm_set1_epi32(1))), 8);
+}
+
+static SDL_INLINE __m128i
+SDL_Blit8888_Mul255_SSE2(const __m128i a, const __m128i b)
+{
+    /* both are at most 255, so the product fits in the low half of each lane */
+    return SDL_Blit8888_Div255_SSE2(_mm_mullo_epi16(a, b));
+}
+
+static SDL_INLINE __m128i
+SDL_Blit8888_Channel_SSE2(const __m128i pixels, const int shift)
+{
+    return _mm_and_si128(_mm_srli_epi32(pixels, shift), _mm_set1_epi32(0xFF));
+}
+
+static SDL_INLINE __m128i
+SDL_Blit8888_Pixels_SSE2(const __m128i src, const __m128i dst, const int flags,
+                         const int srshift, const int sgshift, const int sbshift, const int sashift,
+                         const int drshift, const int dgshift, const int dbshift, const int dashift,
+                         const int modulate, const int blend, const __m128i *mod)
+{
+    const __m128i full = _mm_set1_epi32(0xFF);
+    __m128i R = SDL_Blit8888_Channel_SSE2(src, srshift);
+    __m128i G = SDL_Blit8888_Channel_SSE2(src, sgshift);
+    __m128i B = SDL_Blit8888_Channel_SSE2(src, sbshift);
+    __m128i A = (sashift < 0) ? full : SDL_Blit8888_Channel_SSE2(src, sashift);
+    __m128i pixels;
+
+    if (modulate) {
+        if (flags & SDL_COPY_MODULATE_COLOR) {
+            R = SDL_Blit8888_Mul255_SSE2(R, mod[0]);
+            G = SDL_Blit8888_Mul255_SSE2(G, mod[1]);
+            B = SDL_Blit8888_Mul255_SSE2(B, mod[2]);
+        }
+        if (flags & SDL_COPY_MODULATE_ALPHA) {
+            A = SDL_Blit8888_Mul255_SSE2(A, mod[3]);
+        }
+    }
+    if (blend) {
+        __m128i dR = SDL_Blit8888_Channel_SSE2(dst, drshift);
+        __m128i dG = SDL_Blit8888_Channel_SSE2(dst, dgshift);
+        __m128i dB = SDL_Blit8888_Channel_SSE2(dst, dbshift);
+        __m128i dA = (dashift < 0) ? _mm_setzero_si128() : SDL_Blit8888_Channel_SSE2(dst, dashift);
+        __m128i inv;
+
+        if (flags & (SDL_COPY_BLEND|SDL_COPY_ADD)) {
+            R = SDL_Blit8888_Mul255_SSE2(R, A);
+            G = SDL_Blit8888_Mul255_SSE2(G, A);
+            B = SDL_Blit8888_Mul255_SSE2(B, A);
+        }
+        switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD)) {
+        case SDL_COPY_BLEND:
+            inv = _mm_sub_epi32(full, A);
+            dR = _mm_add_epi32(R, SDL_Blit8888_Mul255_SSE2(inv, dR));
+            dG = _mm_add_epi32(G, SDL_Blit8888_Mul255_SSE2(inv, dG));
+            dB = _mm_add_epi32(B, SDL_Blit8888_Mul255_SSE2(inv, dB));
+            dA = _mm_add_epi32(A, SDL_Blit8888_Mul255_SSE2(inv, dA));
+            break;
+        case SDL_COPY_ADD:
+            dR = _mm_min_epi16(_mm_add_epi32(R, dR), full);
+            dG = _mm_min_epi16(_mm_add_epi32(G, dG), full);
+            dB = _mm_min_epi16(_mm_add_epi32(B, dB), full);
+            break;
+        case SDL_COPY_MOD:
+            dR = SDL_Blit8888_Mul255_SSE2(R, dR);
+            dG = SDL_Blit8888_Mul255_SSE2(G, dG);
+            dB = SDL_Blit8888_Mul255_SSE2(B, dB);
+            break;
+        }
+        R = dR;
+        G = dG;
+        B = dB;
+        A = dA;
+    }
+
+    pixels = _mm_or_si128(_mm_slli_epi32(R, drshift), _mm_slli_epi32(G, dgshift));
+    pixels = _mm_or_si128(pixels, _mm_slli_epi32(B, dbshift));
+    if (dashift >= 0) {
+        pixels = _mm_or_si128(pixels, _mm_slli_epi32(A, dashift));
+    }
+    return pixels;
+}
+
+static void
+SDL_Blit8888_SSE2(SDL_BlitInfo *info,
+                  const int srshift, const int sgshift, const int sbshift, const int sashift,
+                  const int drshift, const int dgshift, const int dbshift, const int dashift,
+                  const int modulate, const int blend, const int scale)
+{
+    const int flags = info->flags;
+    const SDL_bool copy = !modulate && !blend &&
+                          srshift == drshift && sgshift == dgshift &&
+                          sbshift == dbshift && sashift == dashift;
+    __m128i mod[4];
+    Uint32 srcbuf[4], dstbuf[4];
+    int srcy = 0, posy = 0;
+    int incy = 0, incx = 0;
+
+    mod[0] = _mm_set1_epi32(info->r);
+    mod[1] = _mm_set1_epi32(info->g);
+    mod[2] = _mm_set1_epi32(info->b);
+    mod[3] = _mm_set1_epi32(info->a);
+    SDL_zero(srcbuf);
+    SDL_zero(dstbuf);
+    if (scale) {
+        incy = (info->src_h << 16) / info->dst_h;
+        incx = (info->src_w << 16) / info->dst_w;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+
+        if (scale) {
+            while (posy >= 0x10000) {
+                ++srcy;
+                posy -= 0x10000;
+            }
+            src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        }
+        while (n > 0) {
+            const int count = (n < 4) ? n : 4;
+            const Uint32 *s = src;
+            Uint32 *d = (count < 4) ? dstbuf : dst;
+            __m128i pixels;
+            int i;
+
+            if (scale && count == 4) {
+                pixels = _mm_setr_epi32(src[posx >> 16], src[(posx + incx) >> 16],
+                                        src[(posx + 2 * incx) >> 16], src[(posx + 3 * incx) >> 16]);
+                posx += 4 * incx;
+            } else {
+                if (scale) {
+                    for (i = 0; i < count; ++i) {
+                        srcbuf[i] = src[posx >> 16];
+                        posx += incx;
+                    }
+                    s = srcbuf;
+                } else if (count < 4) {
+                    SDL_memcpy(srcbuf, src, count * sizeof (Uint32));
+                    s = srcbuf;
+                }
+                pixels = _mm_loadu_si128((const __m128i *)s);
+            }
+            if (blend && count < 4) {
+                SDL_memcpy(dstbuf, dst, count * sizeof (Uint32));
+            }
+
+            if (!copy) {
+                pixels = SDL_Blit8888_Pixels_SSE2(pixels, blend ? _mm_loadu_si128((const __m128i *)d) : pixels, flags,
+                                                  srshift, sgshift, sbshift, sashift,
+                                                  drshift, dgshift, dbshift, dashift,
+                                                  modulate, blend, mod);
+            }
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (count < 4) {
+                SDL_memcpy(dst, dstbuf, count * sizeof (Uint32));
+            }
+            if (!scale) {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGB888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGB888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGB888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGR888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGR888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_SSE2(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 1, 1);
+}
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+
+/* NEON loads eight pixels as four planes, one per byte of the pixel, so
+   converting between formats only means picking a different plane. */
+
+static SDL_INLINE uint8x8_t
+SDL_Blit8888_Mul255_NEON(const uint8x8_t a, const uint8x8_t b)
+{
+    const uint16x8_t x = vmull_u8(a, b);
+    return vshrn_n_u16(vaddq_u16(x, vaddq_u16(vshrq_n_u16(x, 8), vdupq_n_u16(1))), 8);
+}
+
+static SDL_INLINE uint8x8_t
+SDL_Blit8888_Channel_NEON(const uint8x8x4_t pixels, const int shift)
+{
+    switch (shift) {
+    case 0:
+        return pixels.val[0];
+    case 8:
+        return pixels.val[1];
+    case 16:
+        return pixels.val[2];
+    default:
+        return pixels.val[3];
+    }
+}
+
+static SDL_INLINE uint8x8x4_t
+SDL_Blit8888_Pixels_NEON(const uint8x8x4_t src, const uint8x8x4_t dst, const int flags,
+                         const int srshift, const int sgshift, const int sbshift, const int sashift,
+                         const int drshift, const int dgshift, const int dbshift, const int dashift,
+                         const int modulate, const int blend, const uint8x8_t *mod)
+{
+    const uint8x8_t full = vdup_n_u8(0xFF);
+    uint8x8_t R = SDL_Blit8888_Channel_NEON(src, srshift);
+    uint8x8_t G = SDL_Blit8888_Channel_NEON(src, sgshift);
+    uint8x8_t B = SDL_Blit8888_Channel_NEON(src, sbshift);
+    uint8x8_t A = (sashift < 0) ? full : SDL_Blit8888_Channel_NEON(src, sashift);
+    uint8x8x4_t pixels;
+
+    if (modulate) {
+        if (flags & SDL_COPY_MODULATE_COLOR) {
+            R = SDL_Blit8888_Mul255_NEON(R, mod[0]);
+            G = SDL_Blit8888_Mul255_NEON(G, mod[1]);
+            B = SDL_Blit8888_Mul255_NEON(B, mod[2]);
+        }
+        if (flags & SDL_COPY_MODULATE_ALPHA) {
+            A = SDL_Blit8888_Mul255_NEON(A, mod[3]);
+        }
+    }
+    if (blend) {
+        uint8x8_t dR = SDL_Blit8888_Channel_NEON(dst, drshift);
+        uint8x8_t dG = SDL_Blit8888_Channel_NEON(dst, dgshift);
+        uint8x8_t dB = SDL_Blit8888_Channel_NEON(dst, dbshift);
+        uint8x8_t dA = (dashift < 0) ? vdup_n_u8(0) : SDL_Blit8888_Channel_NEON(dst, dashift);
+        uint8x8_t inv;
+
+        if (flags & (SDL_COPY_BLEND|SDL_COPY_ADD)) {
+            R = SDL_Blit8888_Mul255_NEON(R, A);
+            G = SDL_Blit8888_Mul255_NEON(G, A);
+            B = SDL_Blit8888_Mul255_NEON(B, A);
+        }
+        switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD)) {
+        case SDL_COPY_BLEND:
+            /* the premultiplied color is at most A, so these can't overflow */
+            inv = vsub_u8(full, A);
+            dR = vadd_u8(R, SDL_Blit8888_Mul255_NEON(inv, dR));
+            dG = vadd_u8(G, SDL_Blit8888_Mul255_NEON(inv, dG));
+            dB = vadd_u8(B, SDL_Blit8888_Mul255_NEON(inv, dB));
+            dA = vadd_u8(A, SDL_Blit8888_Mul255_NEON(inv, dA));
+            break;
+        case SDL_COPY_ADD:
+            dR = vqadd_u8(R, dR);
+            dG = vqadd_u8(G, dG);
+            dB = vqadd_u8(B, dB);
+            break;
+        case SDL_COPY_MOD:
+            dR = SDL_Blit8888_Mul255_NEON(R, dR);
+            dG = SDL_Blit8888_Mul255_NEON(G, dG);
+            dB = SDL_Blit8888_Mul255_NEON(B, dB);
+            break;
+        }
+        R = dR;
+        G = dG;
+        B = dB;
+        A = dA;
+    }
+
+    pixels.val[0] = pixels.val[1] = pixels.val[2] = pixels.val[3] = vdup_n_u8(0);
+    pixels.val[drshift >> 3] = R;
+    pixels.val[dgshift >> 3] = G;
+    pixels.val[dbshift >> 3] = B;
+    if (dashift >= 0) {
+        pixels.val[dashift >> 3] = A;
+    }
+    return pixels;
+}
+
+static void
+SDL_Blit8888_NEON(SDL_BlitInfo *info,
+                  const int srshift, const int sgshift, const int sbshift, const int sashift,
+                  const int drshift, const int dgshift, const int dbshift, const int dashift,
+                  const int modulate, const int blend, const int scale)
+{
+    const int flags = info->flags;
+    const SDL_bool copy = !modulate && !blend &&
+                          srshift == drshift && sgshift == dgshift &&
+                          sbshift == dbshift && sashift == dashift;
+    uint8x8_t mod[4];
+    Uint32 srcbuf[8], dstbuf[8];
+    int srcy = 0, posy = 0;
+    int incy = 0, incx = 0;
+
+    mod[0] = vdup_n_u8(info->r);
+    mod[1] = vdup_n_u8(info->g);
+    mod[2] = vdup_n_u8(info->b);
+    mod[3] = vdup_n_u8(info->a);
+    SDL_zero(srcbuf);
+    SDL_zero(dstbuf);
+    if (scale) {
+        incy = (info->src_h << 16) / info->dst_h;
+        incx = (info->src_w << 16) / info->dst_w;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+
+        if (scale) {
+            while (posy >= 0x10000) {
+                ++srcy;
+                posy -= 0x10000;
+            }
+            src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        }
+        while (n > 0) {
+            const int count = (n < 8) ? n : 8;
+            const Uint32 *s = src;
+            Uint32 *d = (count < 8) ? dstbuf : dst;
+            uint8x8x4_t pixels;
+            int i;
+
+            if (scale) {
+                for (i = 0; i < count; ++i) {
+                    srcbuf[i] = src[posx >> 16];
+                    posx += incx;
+                }
+                s = srcbuf;
+            } else if (count < 8) {
+                SDL_memcpy(srcbuf, src, count * sizeof (Uint32));
+                s = srcbuf;
+            }
+            if (blend && count < 8) {
+                SDL_memcpy(dstbuf, dst, count * sizeof (Uint32));
+            }
+
+            pixels = vld4_u8((const uint8_t *)s);
+            if (!copy) {
+                pixels = SDL_Blit8888_Pixels_NEON(pixels, blend ? vld4_u8((const uint8_t *)d) : pixels, flags,
+                                                  srshift, sgshift, sbshift, sashift,
+                                                  drshift, dgshift, dbshift, dashift,
+                                                  modulate, blend, mod);
+            }
+            vst4_u8((uint8_t *)d, pixels);
+
+            if (count < 8) {
+                SDL_memcpy(dst, dstbuf, count * sizeof (Uint32));
+            }
+            if (!scale) {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGB888_RGB888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGB888_RGB888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGB888_BGR888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, -1, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGR888_RGB888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGR888_BGR888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, -1, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 16, 8, 0, 24, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 24, 16, 8, 0, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 0, 8, 16, 24, 16, 8, 0, 24, 1, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 0, 8, 16, -1, 0, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 0, 0);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 0, 8, 16, -1, 1, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, 24, 0, 1, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 0, 0);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 0, 1);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 1, 0);
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_NEON(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_NEON(info, 8, 16, 24, 0, 16, 8, 0, 24, 1, 1, 1);
+}
+
+#endif /* HAVE_NEON_INTRINSICS */
+
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
+#if HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+#endif
+#if HAVE_SSE2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+#endif
+#if HAVE_NEON_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_RGB888_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGB888_RGB888_Blend_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_RGB888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_RGB888_RGB888_Modulate_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_RGB888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGB888_RGB888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_BGR888_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGB888_BGR888_Blend_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_BGR888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_RGB888_BGR888_Modulate_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_BGR888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGB888_BGR888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_ARGB8888_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGB888_ARGB8888_Blend_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_ARGB8888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_RGB888_ARGB8888_Modulate_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_ARGB8888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_RGB888_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGR888_RGB888_Blend_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_RGB888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_BGR888_RGB888_Modulate_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_RGB888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGR888_RGB888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_BGR888_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGR888_BGR888_Blend_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_BGR888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_BGR888_BGR888_Modulate_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_BGR888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGR888_BGR888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_ARGB8888_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGR888_ARGB8888_Blend_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_ARGB8888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_BGR888_ARGB8888_Modulate_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_ARGB8888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_RGB888_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ARGB8888_RGB888_Blend_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_RGB888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_ARGB8888_RGB888_Modulate_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_RGB888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_BGR888_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ARGB8888_BGR888_Blend_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_BGR888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_ARGB8888_BGR888_Modulate_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_BGR888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Blend_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Modulate_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_RGB888_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGBA8888_RGB888_Blend_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_RGB888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_RGBA8888_RGB888_Modulate_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_RGB888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_BGR888_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGBA8888_BGR888_Blend_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_BGR888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_RGBA8888_BGR888_Modulate_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_BGR888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Blend_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Modulate_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_RGB888_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ABGR8888_RGB888_Blend_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_RGB888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_ABGR8888_RGB888_Modulate_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_RGB888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_BGR888_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ABGR8888_BGR888_Blend_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_BGR888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_ABGR8888_BGR888_Modulate_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_BGR888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Blend_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Modulate_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_RGB888_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGRA8888_RGB888_Blend_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_RGB888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_BGRA8888_RGB888_Modulate_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_RGB888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_BGR888_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGRA8888_BGR888_Blend_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_BGR888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_BGRA8888_BGR888_Modulate_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_BGR888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Blend_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Modulate_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_NEON },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_NEON },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Scale },
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend },
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend_Scale },
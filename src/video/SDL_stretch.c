@@ -28,142 +28,31 @@
 
 #include "SDL_video.h"
 #include "SDL_blit.h"
+#include "../cpuinfo/SDL_simd.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
 
 /* This isn't ready for general consumption yet - it should be folded
    into the general blitting mechanism.
 */
 
-#if ((defined(_MFC_VER) && defined(_M_IX86)) || \
-     defined(__WATCOMC__) || \
-     (defined(__GNUC__) && defined(__i386__))) && SDL_ASSEMBLY_ROUTINES
-/* There's a bug with gcc 4.4.1 and -O2 where srcp doesn't get the correct
- * value after the first scanline.  FIXME? */
-/* #define USE_ASM_STRETCH */
-#endif
-
-#ifdef USE_ASM_STRETCH
-
-#ifdef HAVE_MPROTECT
-#include <sys/types.h>
-#include <sys/mman.h>
-#endif
-#ifdef __GNUC__
-#define PAGE_ALIGNED __attribute__((__aligned__(4096)))
-#else
-#define PAGE_ALIGNED
-#endif
-
-#if defined(_M_IX86) || defined(i386)
-#define PREFIX16    0x66
-#define STORE_BYTE  0xAA
-#define STORE_WORD  0xAB
-#define LOAD_BYTE   0xAC
-#define LOAD_WORD   0xAD
-#define RETURN      0xC3
-#else
-#error Need assembly opcodes for this architecture
-#endif
-
-static unsigned char copy_row[4096] PAGE_ALIGNED;
-
-static int
-generate_rowbytes(int src_w, int dst_w, int bpp)
-{
-    static struct
-    {
-        int bpp;
-        int src_w;
-        int dst_w;
-        int status;
-    } last;
-
-    int i;
-    int pos, inc;
-    unsigned char *eip, *fence;
-    unsigned char load, store;
-
-    /* See if we need to regenerate the copy buffer */
-    if ((src_w == last.src_w) && (dst_w == last.dst_w) && (bpp == last.bpp)) {
-        return (last.status);
-    }
-    last.bpp = bpp;
-    last.src_w = src_w;
-    last.dst_w = dst_w;
-    last.status = -1;
-
-    switch (bpp) {
-    case 1:
-        load = LOAD_BYTE;
-        store = STORE_BYTE;
-        break;
-    case 2:
-    case 4:
-        load = LOAD_WORD;
-        store = STORE_WORD;
-        break;
-    default:
-        return SDL_SetError("ASM stretch of %d bytes isn't supported", bpp);
-    }
-#ifdef HAVE_MPROTECT
-    /* Make the code writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_WRITE) < 0) {
-        return SDL_SetError("Couldn't make copy buffer writeable");
-    }
-#endif
-    pos = 0x10000;
-    inc = (src_w << 16) / dst_w;
-    eip = copy_row;
-    fence = copy_row + sizeof(copy_row)-2;
-    for (i = 0; i < dst_w; ++i) {
-        while (pos >= 0x10000L) {
-            if (eip == fence) {
-                return -1;
-            }
-            if (bpp == 2) {
-                *eip++ = PREFIX16;
-            }
-            *eip++ = load;
-            pos -= 0x10000L;
-        }
-        if (eip == fence) {
-            return -1;
-        }
-        if (bpp == 2) {
-            *eip++ = PREFIX16;
-        }
-        *eip++ = store;
-        pos += inc;
-    }
-    *eip++ = RETURN;
-
-#ifdef HAVE_MPROTECT
-    /* Make the code executable but not writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_EXEC) < 0) {
-        return SDL_SetError("Couldn't make copy buffer executable");
-    }
-#endif
-    last.status = 0;
-    return (0);
-}
-
-#endif /* USE_ASM_STRETCH */
-
+/* Nearest neighbour stretching works out which source column each
+   destination column comes from once per call, then copies rows through
+   that table. A destination row that comes from the same source row as
+   the one above it is copied from there instead. All of the state lives
+   on the stack or in a per-call allocation, so stretches can run on any
+   number of threads at once.
+*/
 #define DEFINE_COPY_ROW(name, type)         \
-static void name(type *src, int src_w, type *dst, int dst_w)    \
+static void name(const Uint8 *src, const int *offsets, Uint8 *dst, int dst_w) \
 {                                           \
+    type *dstp = (type *) dst;              \
     int i;                                  \
-    int pos, inc;                           \
-    type pixel = 0;                         \
                                             \
-    pos = 0x10000;                          \
-    inc = (src_w << 16) / dst_w;            \
-    for ( i=dst_w; i>0; --i ) {             \
-        while ( pos >= 0x10000L ) {         \
-            pixel = *src++;                 \
-            pos -= 0x10000L;                \
-        }                                   \
-        *dst++ = pixel;                     \
-        pos += inc;                         \
+    for (i = 0; i < dst_w; ++i) {           \
+        dstp[i] = *(const type *) (src + offsets[i]); \
     }                                       \
 }
 /* *INDENT-OFF* */
@@ -172,58 +61,80 @@ DEFINE_COPY_ROW(copy_row2, Uint16)
 DEFINE_COPY_ROW(copy_row4, Uint32)
 /* *INDENT-ON* */
 
-/* The ASM code doesn't handle 24-bpp stretch blits */
 static void
-copy_row3(Uint8 * src, int src_w, Uint8 * dst, int dst_w)
+copy_row3(const Uint8 * src, const int *offsets, Uint8 * dst, int dst_w)
 {
     int i;
-    int pos, inc;
-    Uint8 pixel[3] = { 0, 0, 0 };
-
-    pos = 0x10000;
-    inc = (src_w << 16) / dst_w;
-    for (i = dst_w; i > 0; --i) {
-        while (pos >= 0x10000L) {
-            pixel[0] = *src++;
-            pixel[1] = *src++;
-            pixel[2] = *src++;
-            pos -= 0x10000L;
-        }
-        *dst++ = pixel[0];
-        *dst++ = pixel[1];
-        *dst++ = pixel[2];
-        pos += inc;
+
+    for (i = 0; i < dst_w; ++i) {
+        const Uint8 *pixel = src + offsets[i];
+        dst[0] = pixel[0];
+        dst[1] = pixel[1];
+        dst[2] = pixel[2];
+        dst += 3;
     }
 }
 
-/* Perform a stretch blit between two surfaces of the same format.
-   NOTE:  This function is not safe to call from multiple threads!
-*/
+#if HAVE_AVX2_INTRINSICS
+/* The offsets are in bytes, so the gather scale is 1 */
+SDL_TARGETING("avx2") static void
+copy_row4AVX2(const Uint8 * src, const int *offsets, Uint8 * dst, int dst_w)
+{
+    Uint32 *dstp = (Uint32 *) dst;
+    int i;
+
+    for (i = 0; i + 8 <= dst_w; i += 8) {
+        const __m256i offset = _mm256_loadu_si256((const __m256i *) (offsets + i));
+        _mm256_storeu_si256((__m256i *) (dstp + i),
+                            _mm256_i32gather_epi32((const int *) src, offset, 1));
+    }
+    for (; i < dst_w; ++i) {
+        dstp[i] = *(const Uint32 *) (src + offsets[i]);
+    }
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+static int SDL_UpperSoftStretch(SDL_Surface * src, const SDL_Rect * srcrect, SDL_Surface * dst, const SDL_Rect * dstrect, SDL_BlitScaleMode scaleMode);
+static int SDL_LowerSoftStretchNearest(SDL_Surface * src, const SDL_Rect * srcrect, SDL_Surface * dst, const SDL_Rect * dstrect);
+static int SDL_LowerSoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect, SDL_Surface * dst, const SDL_Rect * dstrect);
+
+/* Perform a stretch blit between two surfaces of the same format. */
 int
 SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
                 SDL_Surface * dst, const SDL_Rect * dstrect)
 {
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_BLITSCALE_NEAREST);
+}
+
+int
+SDL_SoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                      SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_BLITSCALE_LINEAR);
+}
+
+static int
+SDL_UpperSoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                     SDL_Surface * dst, const SDL_Rect * dstrect,
+                     SDL_BlitScaleMode scaleMode)
+{
+    int ret;
     int src_locked;
     int dst_locked;
-    int pos, inc;
-    int dst_maxrow;
-    int src_row, dst_row;
-    Uint8 *srcp = NULL;
-    Uint8 *dstp;
     SDL_Rect full_src;
     SDL_Rect full_dst;
-#ifdef USE_ASM_STRETCH
-    SDL_bool use_asm = SDL_TRUE;
-#ifdef __GNUC__
-    int u1, u2;
-#endif
-#endif /* USE_ASM_STRETCH */
-    const int bpp = dst->format->BytesPerPixel;
 
     if (src->format->format != dst->format->format) {
         return SDL_SetError("Only works with same format surfaces");
     }
 
+    if (scaleMode == SDL_BLITSCALE_LINEAR) {
+        if (src->format->BytesPerPixel != 4 ||
+            SDL_PIXELLAYOUT(src->format->format) != SDL_PACKEDLAYOUT_8888) {
+            return SDL_SetError("Linear stretching only works with 8888 formats");
+        }
+    }
+
     /* Verify the blit rectangles */
     if (srcrect) {
         if ((srcrect->x < 0) || (srcrect->y < 0) ||
@@ -252,6 +163,11 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         dstrect = &full_dst;
     }
 
+    if (dstrect->w <= 0 || dstrect->h <= 0 ||
+        srcrect->w <= 0 || srcrect->h <= 0) {
+        return 0;
+    }
+
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
@@ -272,82 +188,340 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         src_locked = 1;
     }
 
-    /* Set up the data... */
-    pos = 0x10000;
-    inc = (srcrect->h << 16) / dstrect->h;
-    src_row = srcrect->y;
-    dst_row = dstrect->y;
+    if (scaleMode == SDL_BLITSCALE_LINEAR) {
+        ret = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
+    } else {
+        ret = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
+    }
 
-#ifdef USE_ASM_STRETCH
-    /* Write the opcodes for this stretch */
-    if ((bpp == 3) || (generate_rowbytes(srcrect->w, dstrect->w, bpp) < 0)) {
-        use_asm = SDL_FALSE;
+    /* We need to unlock the surfaces if they're locked */
+    if (dst_locked) {
+        SDL_UnlockSurface(dst);
     }
+    if (src_locked) {
+        SDL_UnlockSurface(src);
+    }
+    return ret;
+}
+
+static int
+SDL_LowerSoftStretchNearest(SDL_Surface * src, const SDL_Rect * srcrect,
+                            SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    const int bpp = dst->format->BytesPerPixel;
+    const int row_bytes = dstrect->w * bpp;
+    const int inc_x = (srcrect->w << 16) / dstrect->w;
+    const int inc_y = (srcrect->h << 16) / dstrect->h;
+    void (*copy_row)(const Uint8 *, const int *, Uint8 *, int);
+    int *offsets = NULL;
+    int i, src_row, last_row = -1;
+    const Uint8 *srcp;
+    Uint8 *dstp, *lastp = NULL;
+
+    switch (bpp) {
+    case 1:
+        copy_row = copy_row1;
+        break;
+    case 2:
+        copy_row = copy_row2;
+        break;
+    case 3:
+        copy_row = copy_row3;
+        break;
+    default:
+        copy_row = copy_row4;
+#if HAVE_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            copy_row = copy_row4AVX2;
+        }
 #endif
+        break;
+    }
+
+    /* Byte offsets of each destination column's pixel in a source row.
+       Column i takes source pixel (i * inc_x) >> 16, the one a 16.16 step
+       across the row reaches. A same width stretch just copies rows. */
+    if (srcrect->w != dstrect->w) {
+        offsets = (int *) SDL_malloc(dstrect->w * sizeof(*offsets));
+        if (!offsets) {
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < dstrect->w; ++i) {
+            offsets[i] = ((i * inc_x) >> 16) * bpp;
+        }
+    }
 
     /* Perform the stretch blit */
-    for (dst_maxrow = dst_row + dstrect->h; dst_row < dst_maxrow; ++dst_row) {
-        dstp = (Uint8 *) dst->pixels + (dst_row * dst->pitch)
+    for (i = 0; i < dstrect->h; ++i) {
+        src_row = srcrect->y + ((i * inc_y) >> 16);
+        dstp = (Uint8 *) dst->pixels + ((dstrect->y + i) * dst->pitch)
             + (dstrect->x * bpp);
-        while (pos >= 0x10000L) {
-            srcp = (Uint8 *) src->pixels + (src_row * src->pitch)
+        if (src_row == last_row) {
+            SDL_memcpy(dstp, lastp, row_bytes);
+        } else {
+            srcp = (const Uint8 *) src->pixels + (src_row * src->pitch)
                 + (srcrect->x * bpp);
-            ++src_row;
-            pos -= 0x10000L;
-        }
-#ifdef USE_ASM_STRETCH
-        if (use_asm) {
-#ifdef __GNUC__
-            __asm__ __volatile__("call *%4":"=&D"(u1), "=&S"(u2)
-                                 :"0"(dstp), "1"(srcp), "r"(copy_row)
-                                 :"memory");
-#elif defined(_MSC_VER) || defined(__WATCOMC__)
-            /* *INDENT-OFF* */
-            {
-                void *code = copy_row;
-                __asm {
-                    push edi
-                    push esi
-                    mov edi, dstp
-                    mov esi, srcp
-                    call dword ptr code
-                    pop esi
-                    pop edi
-                }
+            if (!offsets) {
+                SDL_memcpy(dstp, srcp, row_bytes);
+            } else {
+                copy_row(srcp, offsets, dstp, dstrect->w);
             }
-            /* *INDENT-ON* */
-#else
-#error Need inline assembly for this compiler
+            last_row = src_row;
+        }
+        lastp = dstp;
+    }
+
+    SDL_free(offsets);
+    return 0;
+}
+
+/* Linear filtering is done in fixed point, one destination row at a time:
+   the two source rows around it are blended into a row of 16-bit channels,
+   then neighbouring pixels of that are blended across. Weights have 7 bits
+   of fraction, so a blended row never goes past 255 * 128 and a finished
+   channel past 255 * 128 * 128. That lets the SIMD versions get by with
+   16-bit multiplies and a 32-bit multiply-add, and every version produces
+   exactly the same pixels. */
+#define LINEAR_BITS 7
+#define LINEAR_ONE  (1 << LINEAR_BITS)
+#define LINEAR_ROUND (1 << (2 * LINEAR_BITS - 1))
+
+/* Find the pixel to the left of (or above) a 16.16 source position, and
+   the weight of the one after it. Pixel centers line up with the middle
+   of the destination pixels. Past the last pixel, this returns the one
+   before it with all the weight on the last one, so reading the pair never
+   goes outside the source unless it's a single pixel wide. */
+static SDL_INLINE void
+GetLinearPosition(int pos, int size, int *index, int *frac)
+{
+    if (pos <= 0) {
+        *index = 0;
+        *frac = 0;
+    } else {
+        *index = pos >> 16;
+        *frac = (pos >> (16 - LINEAR_BITS)) & (LINEAR_ONE - 1);
+    }
+    if (*index >= size - 1) {
+        if (size > 1) {
+            *index = size - 2;
+            *frac = LINEAR_ONE;
+        } else {
+            *index = 0;
+            *frac = 0;
+        }
+    }
+}
+
+/* Each destination column reads channels offset[i] to offset[i] + 7 of the
+   blended row, and weight[i] holds (fraction << 16) | (LINEAR_ONE - fraction) */
+typedef struct
+{
+    int *offset;
+    Uint32 *weight;
+} SDL_StretchColumns;
+
+static void
+StretchLinearVertical(const Uint8 * src0, const Uint8 * src1, int fy,
+                      Uint16 * row, int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        row[i] = (Uint16) (src0[i] * (LINEAR_ONE - fy) + src1[i] * fy);
+    }
+}
+
+static void
+StretchLinearHorizontal(const Uint16 * row, const SDL_StretchColumns * columns,
+                        Uint8 * dst, int dst_w)
+{
+    int i, c;
+
+    for (i = 0; i < dst_w; ++i) {
+        const Uint16 *p = row + columns->offset[i];
+        const Uint32 w0 = columns->weight[i] & 0xFFFF;
+        const Uint32 w1 = columns->weight[i] >> 16;
+        for (c = 0; c < 4; ++c) {
+            *dst++ = (Uint8) ((p[c] * w0 + p[c + 4] * w1 + LINEAR_ROUND) >>
+                              (2 * LINEAR_BITS));
+        }
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+StretchLinearVerticalSSE2(const Uint8 * src0, const Uint8 * src1, int fy,
+                          Uint16 * row, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wy0 = _mm_set1_epi16(LINEAR_ONE - fy);
+    const __m128i wy1 = _mm_set1_epi16(fy);
+    int i;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128((const __m128i *) (src0 + i));
+        const __m128i b = _mm_loadu_si128((const __m128i *) (src1 + i));
+        _mm_storeu_si128((__m128i *) (row + i),
+            _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), wy0),
+                          _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), wy1)));
+        _mm_storeu_si128((__m128i *) (row + i + 8),
+            _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), wy0),
+                          _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), wy1)));
+    }
+    StretchLinearVertical(src0 + i, src1 + i, fy, row + i, count - i);
+}
+
+static SDL_INLINE __m128i
+StretchLinearPixelSSE2(const Uint16 * p, Uint32 weight)
+{
+    /* Each channel next to the same channel of the pixel after it, for the
+       multiply-add */
+    const __m128i v = _mm_loadu_si128((const __m128i *) p);
+    const __m128i pairs = _mm_unpacklo_epi16(v, _mm_srli_si128(v, 8));
+    return _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(pairs, _mm_set1_epi32(weight)),
+                                        _mm_set1_epi32(LINEAR_ROUND)),
+                          2 * LINEAR_BITS);
+}
+
+static void
+StretchLinearHorizontalSSE2(const Uint16 * row, const SDL_StretchColumns * columns,
+                            Uint8 * dst, int dst_w)
+{
+    int i;
+
+    for (i = 0; i + 2 <= dst_w; i += 2) {
+        const __m128i p0 = StretchLinearPixelSSE2(row + columns->offset[i], columns->weight[i]);
+        const __m128i p1 = StretchLinearPixelSSE2(row + columns->offset[i + 1], columns->weight[i + 1]);
+        const __m128i p = _mm_packs_epi32(p0, p1);
+        _mm_storel_epi64((__m128i *) dst, _mm_packus_epi16(p, p));
+        dst += 8;
+    }
+    if (i < dst_w) {
+        SDL_StretchColumns last;
+        last.offset = columns->offset + i;
+        last.weight = columns->weight + i;
+        StretchLinearHorizontal(row, &last, dst, 1);
+    }
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static void
+StretchLinearVerticalNEON(const Uint8 * src0, const Uint8 * src1, int fy,
+                          Uint16 * row, int count)
+{
+    const uint8x8_t wy0 = vdup_n_u8((Uint8) (LINEAR_ONE - fy));
+    const uint8x8_t wy1 = vdup_n_u8((Uint8) fy);
+    int i;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        const uint8x16_t a = vld1q_u8(src0 + i);
+        const uint8x16_t b = vld1q_u8(src1 + i);
+        vst1q_u16(row + i, vmlal_u8(vmull_u8(vget_low_u8(a), wy0), vget_low_u8(b), wy1));
+        vst1q_u16(row + i + 8, vmlal_u8(vmull_u8(vget_high_u8(a), wy0), vget_high_u8(b), wy1));
+    }
+    StretchLinearVertical(src0 + i, src1 + i, fy, row + i, count - i);
+}
+
+static SDL_INLINE uint16x4_t
+StretchLinearPixelNEON(const Uint16 * p, Uint32 weight)
+{
+    const uint16x8_t v = vld1q_u16(p);
+    return vrshrn_n_u32(vmlal_n_u16(vmull_n_u16(vget_low_u16(v), (Uint16) (weight & 0xFFFF)),
+                                    vget_high_u16(v), (Uint16) (weight >> 16)),
+                        2 * LINEAR_BITS);
+}
+
+static void
+StretchLinearHorizontalNEON(const Uint16 * row, const SDL_StretchColumns * columns,
+                            Uint8 * dst, int dst_w)
+{
+    int i;
+
+    for (i = 0; i + 2 <= dst_w; i += 2) {
+        const uint16x4_t p0 = StretchLinearPixelNEON(row + columns->offset[i], columns->weight[i]);
+        const uint16x4_t p1 = StretchLinearPixelNEON(row + columns->offset[i + 1], columns->weight[i + 1]);
+        vst1_u8(dst, vmovn_u16(vcombine_u16(p0, p1)));
+        dst += 8;
+    }
+    if (i < dst_w) {
+        SDL_StretchColumns last;
+        last.offset = columns->offset + i;
+        last.weight = columns->weight + i;
+        StretchLinearHorizontal(row, &last, dst, 1);
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+static int
+SDL_LowerSoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                           SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    void (*vertical)(const Uint8 *, const Uint8 *, int, Uint16 *, int) = StretchLinearVertical;
+    void (*horizontal)(const Uint16 *, const SDL_StretchColumns *, Uint8 *, int) = StretchLinearHorizontal;
+    const int count = srcrect->w * 4;
+    const int next = (srcrect->h > 1) ? src->pitch : 0;
+    SDL_StretchColumns columns;
+    Uint16 *row;
+    int inc, pos;
+    int i, index, frac;
+    int last_index = -1, last_frac = -1;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        vertical = StretchLinearVerticalSSE2;
+        horizontal = StretchLinearHorizontalSSE2;
+    }
 #endif
-        } else
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        vertical = StretchLinearVerticalNEON;
+        horizontal = StretchLinearHorizontalNEON;
+    }
 #endif
-            switch (bpp) {
-            case 1:
-                copy_row1(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 2:
-                copy_row2((Uint16 *) srcp, srcrect->w,
-                          (Uint16 *) dstp, dstrect->w);
-                break;
-            case 3:
-                copy_row3(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 4:
-                copy_row4((Uint32 *) srcp, srcrect->w,
-                          (Uint32 *) dstp, dstrect->w);
-                break;
-            }
-        pos += inc;
+
+    /* The blended row has room for one more pixel, which stays zero, for a
+       source a single pixel wide */
+    row = (Uint16 *) SDL_calloc(count + 4, sizeof(Uint16));
+    columns.offset = (int *) SDL_malloc(dstrect->w * sizeof(int));
+    columns.weight = (Uint32 *) SDL_malloc(dstrect->w * sizeof(Uint32));
+    if (!row || !columns.offset || !columns.weight) {
+        SDL_free(row);
+        SDL_free(columns.offset);
+        SDL_free(columns.weight);
+        return SDL_OutOfMemory();
     }
 
-    /* We need to unlock the surfaces if they're locked */
-    if (dst_locked) {
-        SDL_UnlockSurface(dst);
+    inc = (srcrect->w << 16) / dstrect->w;
+    pos = inc / 2 - 0x8000;
+    for (i = 0; i < dstrect->w; ++i) {
+        GetLinearPosition(pos, srcrect->w, &index, &frac);
+        columns.offset[i] = index * 4;
+        columns.weight[i] = ((Uint32) frac << 16) | (LINEAR_ONE - frac);
+        pos += inc;
     }
-    if (src_locked) {
-        SDL_UnlockSurface(src);
+
+    inc = (srcrect->h << 16) / dstrect->h;
+    pos = inc / 2 - 0x8000;
+    for (i = 0; i < dstrect->h; ++i) {
+        GetLinearPosition(pos, srcrect->h, &index, &frac);
+        if (index != last_index || frac != last_frac) {
+            const Uint8 *srcp = (const Uint8 *) src->pixels +
+                (srcrect->y + index) * src->pitch + srcrect->x * 4;
+            vertical(srcp, srcp + next, frac, row, count);
+            last_index = index;
+            last_frac = frac;
+        }
+        horizontal(row, &columns,
+                   (Uint8 *) dst->pixels + (dstrect->y + i) * dst->pitch + dstrect->x * 4,
+                   dstrect->w);
+        pos += inc;
     }
-    return (0);
+
+    SDL_free(row);
+    SDL_free(columns.offset);
+    SDL_free(columns.weight);
+    return 0;
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
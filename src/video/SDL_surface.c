@@ -656,6 +656,14 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateUpperBlitScaled(src, srcrect, dst, dstrect, SDL_BLITSCALE_NEAREST);
+}
+
+int
+SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect,
+                           SDL_BlitScaleMode scaleMode)
 {
     double src_x0, src_y0, src_x1, src_y1;
     double dst_x0, dst_y0, dst_x1, dst_y1;
@@ -800,7 +808,7 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
         return 0;
     }
 
-    return SDL_LowerBlitScaled(src, &final_src, dst, &final_dst);
+    return SDL_PrivateLowerBlitScaled(src, &final_src, dst, &final_dst, scaleMode);
 }
 
 /**
@@ -810,6 +818,59 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
                 SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateLowerBlitScaled(src, srcrect, dst, dstrect, SDL_BLITSCALE_NEAREST);
+}
+
+/* Linear filtering needs a source with 8-bit channels, and isn't used for
+   color keyed blits, where it would blend the key into the pixels around
+   it. Anything SDL_SoftStretchLinear() can't do itself, like converting or
+   blending, is done by stretching into a temporary surface and blitting
+   that. */
+static int
+SDL_LowerBlitScaledLinear(SDL_Surface * src, SDL_Rect * srcrect,
+                          SDL_Surface * dst, SDL_Rect * dstrect,
+                          Uint32 complex_copy_flags)
+{
+    SDL_Surface *tmp;
+    SDL_Rect tmprect;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    int ret;
+
+    if (!(src->map->info.flags & complex_copy_flags) &&
+        src->format->format == dst->format->format) {
+        return SDL_SoftStretchLinear(src, srcrect, dst, dstrect);
+    }
+
+    tmp = SDL_CreateRGBSurfaceWithFormat(0, dstrect->w, dstrect->h, 0,
+                                         src->format->format);
+    if (!tmp) {
+        return -1;
+    }
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_SetSurfaceBlendMode(tmp, blendMode);
+    SDL_SetSurfaceColorMod(tmp, r, g, b);
+    SDL_SetSurfaceAlphaMod(tmp, a);
+
+    tmprect.x = 0;
+    tmprect.y = 0;
+    tmprect.w = dstrect->w;
+    tmprect.h = dstrect->h;
+    ret = SDL_SoftStretchLinear(src, srcrect, tmp, &tmprect);
+    if (ret == 0) {
+        ret = SDL_LowerBlit(tmp, &tmprect, dst, dstrect);
+    }
+    SDL_FreeSurface(tmp);
+    return ret;
+}
+
+int
+SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect,
+                           SDL_BlitScaleMode scaleMode)
 {
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
@@ -817,6 +878,14 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
         SDL_COPY_COLORKEY
     );
 
+    if (scaleMode == SDL_BLITSCALE_LINEAR &&
+        src->format->BytesPerPixel == 4 &&
+        SDL_PIXELLAYOUT(src->format->format) == SDL_PACKEDLAYOUT_8888 &&
+        !(src->map->info.flags & SDL_COPY_COLORKEY)) {
+        return SDL_LowerBlitScaledLinear(src, srcrect, dst, dstrect,
+                                         complex_copy_flags);
+    }
+
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
         src->map->info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(src->map);
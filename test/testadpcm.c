@@ -0,0 +1,355 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* ADPCM decoding benchmark: encode a WAVE file (sample.wav by default) as
+   mono and stereo MS ADPCM and IMA ADPCM in memory, then time how fast
+   SDL_LoadWAV_RW() decodes each of them. A checksum of the decoded audio
+   is printed too, so changes to the decoders can be checked against it.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define MS_ADPCM_CODE   0x0002
+#define IMA_ADPCM_CODE  0x0011
+
+static const Sint16 ms_coeffs[7][2] = {
+    { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 }, { 240, 0 }, { 460, -208 }, { 392, -232 }
+};
+
+static const Sint32 ms_adaptive[16] = {
+    230, 230, 230, 230, 307, 409, 512, 614,
+    768, 614, 512, 409, 307, 230, 230, 230
+};
+
+static const int ima_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const Sint32 ima_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+    143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
+    1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+    22385, 24623, 27086, 29794, 32767
+};
+
+static Uint8 *
+PutLE(Uint8 *dst, Uint32 value, int bytes)
+{
+    int i;
+    for (i = 0; i < bytes; ++i) {
+        *dst++ = (Uint8) (value >> (8 * i));
+    }
+    return dst;
+}
+
+static Sint32
+Clamp16(Sint32 sample)
+{
+    return (sample < -32768) ? -32768 : (sample > 32767) ? 32767 : sample;
+}
+
+/* Encode one channel sample into an MS ADPCM nibble, using predictor 0 */
+static Uint8
+EncodeMSNibble(Sint16 sample, Sint32 *samp1, Sint32 *samp2, Sint32 *delta)
+{
+    const Sint32 predicted = ((*samp1 * ms_coeffs[0][0]) + (*samp2 * ms_coeffs[0][1])) / 256;
+    Sint32 error = sample - predicted;
+    Sint32 nibble = (error >= 0) ? ((error + *delta / 2) / *delta) : -((-error + *delta / 2) / *delta);
+
+    nibble = (nibble < -8) ? -8 : (nibble > 7) ? 7 : nibble;
+    *samp2 = *samp1;
+    *samp1 = Clamp16(predicted + *delta * nibble);
+    *delta = (*delta * ms_adaptive[nibble & 0x0F]) / 256;
+    if (*delta < 16) {
+        *delta = 16;
+    }
+    return (Uint8) (nibble & 0x0F);
+}
+
+static void
+EncodeMSBlock(const Sint16 *samples, int channels, int frames, Uint8 *block)
+{
+    Sint32 samp1[2], samp2[2], delta[2];
+    int c, i, n = 0;
+
+    for (c = 0; c < channels; ++c) {
+        *block++ = 0;
+    }
+    for (c = 0; c < channels; ++c) {
+        delta[c] = 16;
+        block = PutLE(block, (Uint32) delta[c], 2);
+    }
+    for (c = 0; c < channels; ++c) {
+        samp1[c] = samples[channels + c];
+        block = PutLE(block, (Uint16) samp1[c], 2);
+    }
+    for (c = 0; c < channels; ++c) {
+        samp2[c] = samples[c];
+        block = PutLE(block, (Uint16) samp2[c], 2);
+    }
+    for (i = 2 * channels; i < frames * channels; ++i) {
+        c = i % channels;
+        if ((n++ & 1) == 0) {
+            *block = EncodeMSNibble(samples[i], &samp1[c], &samp2[c], &delta[c]) << 4;
+        } else {
+            *block++ |= EncodeMSNibble(samples[i], &samp1[c], &samp2[c], &delta[c]);
+        }
+    }
+}
+
+/* Encode one channel sample into an IMA ADPCM nibble */
+static Uint8
+EncodeIMANibble(Sint16 sample, Sint32 *predicted, int *index)
+{
+    Sint32 step = ima_step_table[*index];
+    Sint32 diff = sample - *predicted;
+    Sint32 delta = step >> 3;
+    Uint8 nibble = 0;
+
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+    }
+    if (diff >= step) {
+        nibble |= 4;
+        diff -= step;
+        delta += step;
+    }
+    if (diff >= (step >> 1)) {
+        nibble |= 2;
+        diff -= (step >> 1);
+        delta += (step >> 1);
+    }
+    if (diff >= (step >> 2)) {
+        nibble |= 1;
+        delta += (step >> 2);
+    }
+    *predicted = Clamp16((nibble & 8) ? (*predicted - delta) : (*predicted + delta));
+    *index += ima_index_table[nibble];
+    *index = (*index < 0) ? 0 : (*index > 88) ? 88 : *index;
+    return nibble;
+}
+
+static void
+EncodeIMABlock(const Sint16 *samples, int channels, int frames, Uint8 *block)
+{
+    Sint32 predicted[2];
+    int index[2] = { 0, 0 };
+    int c, i, j;
+
+    for (c = 0; c < channels; ++c) {
+        predicted[c] = samples[c];
+        block = PutLE(block, (Uint16) predicted[c], 2);
+        *block++ = (Uint8) index[c];
+        *block++ = 0;
+    }
+    for (i = 1; i < frames; i += 8) {
+        for (c = 0; c < channels; ++c) {
+            for (j = 0; j < 8; ++j) {
+                const Uint8 nibble = EncodeIMANibble(samples[(i + j) * channels + c], &predicted[c], &index[c]);
+                if ((j & 1) == 0) {
+                    *block = nibble;
+                } else {
+                    *block++ |= nibble << 4;
+                }
+            }
+        }
+    }
+}
+
+/* Build an ADPCM WAVE file in memory from 16-bit samples */
+static Uint8 *
+EncodeWAV(Uint16 encoding, const Sint16 *samples, int channels, int freq, Uint32 frames, Uint32 *filelen)
+{
+    const int blockalign = 512 * channels;
+    const int framesperblock = (encoding == MS_ADPCM_CODE) ?
+        ((blockalign - 7 * channels) * 2 / channels + 2) :
+        ((blockalign - 4 * channels) * 2 / channels + 1);
+    const Uint32 blocks = frames / framesperblock;
+    const Uint32 fmtlen = (encoding == MS_ADPCM_CODE) ? 50 : 20;
+    const Uint32 datalen = blocks * blockalign;
+    Uint8 *file, *dst;
+    Uint32 i;
+
+    *filelen = 12 + (8 + fmtlen) + (8 + datalen);
+    file = (Uint8 *) SDL_malloc(*filelen);
+    if (file == NULL) {
+        return NULL;
+    }
+    dst = PutLE(file, 0x46464952, 4);  /* "RIFF" */
+    dst = PutLE(dst, *filelen - 8, 4);
+    dst = PutLE(dst, 0x45564157, 4);  /* "WAVE" */
+    dst = PutLE(dst, 0x20746D66, 4);  /* "fmt " */
+    dst = PutLE(dst, fmtlen, 4);
+    dst = PutLE(dst, encoding, 2);
+    dst = PutLE(dst, channels, 2);
+    dst = PutLE(dst, freq, 4);
+    dst = PutLE(dst, freq * blockalign / framesperblock, 4);
+    dst = PutLE(dst, blockalign, 2);
+    dst = PutLE(dst, 4, 2);
+    if (encoding == MS_ADPCM_CODE) {
+        dst = PutLE(dst, 32, 2);
+        dst = PutLE(dst, framesperblock, 2);
+        dst = PutLE(dst, 7, 2);
+        for (i = 0; i < 7; ++i) {
+            dst = PutLE(dst, (Uint16) ms_coeffs[i][0], 2);
+            dst = PutLE(dst, (Uint16) ms_coeffs[i][1], 2);
+        }
+    } else {
+        dst = PutLE(dst, 2, 2);
+        dst = PutLE(dst, framesperblock, 2);
+    }
+    dst = PutLE(dst, 0x61746164, 4);  /* "data" */
+    dst = PutLE(dst, datalen, 4);
+
+    for (i = 0; i < blocks; ++i) {
+        const Sint16 *block = samples + i * framesperblock * channels;
+        if (encoding == MS_ADPCM_CODE) {
+            EncodeMSBlock(block, channels, framesperblock, dst);
+        } else {
+            EncodeIMABlock(block, channels, framesperblock, dst);
+        }
+        dst += blockalign;
+    }
+    return file;
+}
+
+/* Decode the file over and over for about a second; returns MB of decoded
+   audio per second, or a negative value on error. */
+static double
+DecodeThroughput(const Uint8 *file, Uint32 filelen, Uint32 *checksum)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 start, elapsed = 0, total = 0;
+    SDL_AudioSpec spec;
+    Uint8 *audio;
+    Uint32 len, i;
+
+    while (elapsed < frequency) {
+        start = SDL_GetPerformanceCounter();
+        if (!SDL_LoadWAV_RW(SDL_RWFromConstMem(file, filelen), 1, &spec, &audio, &len)) {
+            return -1.0;
+        }
+        elapsed += SDL_GetPerformanceCounter() - start;
+        total += len;
+
+        *checksum = 0;
+        for (i = 0; i < len; ++i) {
+            *checksum = (*checksum * 31) + audio[i];
+        }
+        SDL_FreeWAV(audio);
+    }
+    return ((double) total / (1024.0 * 1024.0)) / ((double) elapsed / (double) frequency);
+}
+
+int
+main(int argc, char **argv)
+{
+    static const struct
+    {
+        Uint16 encoding;
+        const char *name;
+    } codecs[] = {
+        { MS_ADPCM_CODE, "MS ADPCM" },
+        { IMA_ADPCM_CODE, "IMA ADPCM" },
+    };
+    const char *filename = (argc > 1) ? argv[1] : "sample.wav";
+    SDL_AudioSpec spec;
+    SDL_AudioCVT cvt;
+    Uint8 *audio;
+    Uint32 len;
+    Sint16 *stereo;
+    int i, channels;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    /* Load the file and turn it into 16-bit mono */
+    if (SDL_LoadWAV(filename, &spec, &audio, &len) == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s\n", filename, SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_S16SYS, 1, spec.freq) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s: %s\n", filename, SDL_GetError());
+        SDL_FreeWAV(audio);
+        SDL_Quit();
+        return 1;
+    }
+    cvt.len = len;
+    cvt.buf = (Uint8 *) SDL_malloc(len * cvt.len_mult);
+    if (cvt.buf == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_FreeWAV(audio);
+        SDL_Quit();
+        return 1;
+    }
+    SDL_memcpy(cvt.buf, audio, len);
+    SDL_FreeWAV(audio);
+    SDL_ConvertAudio(&cvt);
+    len = cvt.len_cvt / sizeof (Sint16);
+
+    /* Stereo is the same audio, with the right channel inverted */
+    stereo = (Sint16 *) SDL_malloc(len * 2 * sizeof (Sint16));
+    if (stereo == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_free(cvt.buf);
+        SDL_Quit();
+        return 1;
+    }
+    for (i = 0; i < (int) len; ++i) {
+        const Sint16 sample = ((Sint16 *) cvt.buf)[i];
+        stereo[i * 2] = sample;
+        stereo[i * 2 + 1] = (sample == -32768) ? 32767 : -sample;
+    }
+
+    SDL_Log("Decoding %s (%u frames at %d Hz) through SDL_LoadWAV_RW()\n", filename, len, spec.freq);
+    for (i = 0; i < SDL_arraysize(codecs); ++i) {
+        for (channels = 1; channels <= 2; ++channels) {
+            const Sint16 *samples = (channels == 1) ? (const Sint16 *) cvt.buf : stereo;
+            Uint32 filelen, checksum = 0;
+            Uint8 *file = EncodeWAV(codecs[i].encoding, samples, channels, spec.freq, len, &filelen);
+            double mbps;
+
+            if (file == NULL) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+                break;
+            }
+            mbps = DecodeThroughput(file, filelen, &checksum);
+            if (mbps < 0.0) {
+                SDL_Log("%-9s %-6s: failed: %s\n", codecs[i].name, (channels == 1) ? "mono" : "stereo", SDL_GetError());
+            } else {
+                SDL_Log("%-9s %-6s: %8.1f MB/s (checksum %08x)\n", codecs[i].name, (channels == 1) ? "mono" : "stereo", mbps, checksum);
+            }
+            SDL_free(file);
+        }
+    }
+
+    SDL_free(stereo);
+    SDL_free(cvt.buf);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
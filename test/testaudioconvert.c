@@ -0,0 +1,169 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Audio conversion benchmark: run SDL_ConvertAudio() over a buffer of
+   noise for each sample format to and from float, and for each channel
+   conversion, and report the throughput. Which SIMD code is used depends
+   on the CPU, so this prints what the CPU has first.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define BUFFER_FRAMES (16 * 1024)
+
+static const struct
+{
+    SDL_AudioFormat format;
+    const char *name;
+} formats[] = {
+    { AUDIO_S8, "S8" },
+    { AUDIO_U8, "U8" },
+    { AUDIO_S16SYS, "S16" },
+    { AUDIO_U16SYS, "U16" },
+    { AUDIO_S32SYS, "S32" },
+};
+
+static const struct
+{
+    Uint8 src_channels;
+    Uint8 dst_channels;
+    const char *name;
+} layouts[] = {
+    { 1, 2, "mono to stereo" },
+    { 2, 1, "stereo to mono" },
+    { 2, 6, "stereo to 5.1" },
+    { 6, 2, "5.1 to stereo" },
+    { 2, 4, "stereo to quad" },
+    { 6, 4, "5.1 to quad" },
+};
+
+static Uint8 *source;
+static Uint8 *buffer;
+
+/* Returns megabytes of input converted per second, or a negative value on error. */
+static double
+ConvertThroughput(SDL_AudioFormat src_format, Uint8 src_channels,
+                  SDL_AudioFormat dst_format, Uint8 dst_channels, int iterations)
+{
+    const int src_len = BUFFER_FRAMES * src_channels * (SDL_AUDIO_BITSIZE(src_format) / 8);
+    SDL_AudioCVT cvt;
+    Uint64 start, elapsed = 0;
+    int i;
+
+    if (SDL_BuildAudioCVT(&cvt, src_format, src_channels, 48000, dst_format, dst_channels, 48000) < 0) {
+        return -1.0;
+    }
+
+    cvt.buf = buffer;
+    for (i = 0; i < iterations; ++i) {
+        /* The data is converted in place, so start from a fresh copy each
+           time, and only time the conversion. */
+        SDL_memcpy(buffer, source, src_len);
+        cvt.len = src_len;
+        start = SDL_GetPerformanceCounter();
+        if (SDL_ConvertAudio(&cvt) < 0) {
+            return -1.0;
+        }
+        elapsed += SDL_GetPerformanceCounter() - start;
+    }
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+
+    return ((double)src_len * iterations / (1024.0 * 1024.0)) /
+           ((double)elapsed / SDL_GetPerformanceFrequency());
+}
+
+static void
+FillBuffer(SDL_AudioFormat format)
+{
+    const int len = BUFFER_FRAMES * 8 * sizeof (float);
+    int i;
+
+    if (SDL_AUDIO_ISFLOAT(format)) {
+        float *samples = (float *)source;
+        for (i = 0; i < len / (int)sizeof (float); ++i) {
+            samples[i] = (float)(rand() - (RAND_MAX / 2)) / (float)RAND_MAX;
+        }
+    } else {
+        for (i = 0; i < len; ++i) {
+            source[i] = (Uint8)rand();
+        }
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    int iterations = 1000;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argv[1]) {
+        iterations = atoi(argv[1]);
+    }
+    if (iterations <= 0) {
+        SDL_Log("Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    /* The converters are picked when the audio subsystem starts. */
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    /* Big enough for the largest conversion: 8 channels of float. */
+    source = (Uint8 *)SDL_malloc(BUFFER_FRAMES * 8 * sizeof (float));
+    buffer = (Uint8 *)SDL_malloc(BUFFER_FRAMES * 8 * sizeof (float));
+    if (!source || !buffer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_free(source);
+        SDL_free(buffer);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("CPU: SSE %s, SSE2 %s, SSE3 %s, AVX2 %s, NEON %s\n",
+            SDL_HasSSE() ? "yes" : "no", SDL_HasSSE2() ? "yes" : "no", SDL_HasSSE3() ? "yes" : "no",
+            SDL_HasAVX2() ? "yes" : "no", SDL_HasNEON() ? "yes" : "no");
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        double to_float, from_float;
+
+        FillBuffer(formats[i].format);
+        to_float = ConvertThroughput(formats[i].format, 1, AUDIO_F32SYS, 1, iterations);
+        FillBuffer(AUDIO_F32SYS);
+        from_float = ConvertThroughput(AUDIO_F32SYS, 1, formats[i].format, 1, iterations);
+
+        SDL_Log("%-4s to F32 %8.1f MB/s, F32 to %-4s %8.1f MB/s\n",
+                formats[i].name, to_float, formats[i].name, from_float);
+    }
+
+    for (i = 0; i < SDL_arraysize(layouts); ++i) {
+        FillBuffer(AUDIO_F32SYS);
+        SDL_Log("%-15s %8.1f MB/s\n", layouts[i].name,
+                ConvertThroughput(AUDIO_F32SYS, layouts[i].src_channels,
+                                  AUDIO_F32SYS, layouts[i].dst_channels, iterations));
+    }
+
+    SDL_free(source);
+    SDL_free(buffer);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -37,6 +37,22 @@ _audioTearDown(void *arg)
     SDLTest_AssertPass("Cleanup of test files completed");
 }
 
+/* Some tests shut the audio driver down with SDL_AudioQuit(), which the
+   SDL_InitSubSystem() in the fixture doesn't notice; restart it before
+   opening devices. */
+int
+_audioEnsureDriver()
+{
+    int result = 0;
+
+    if (SDL_GetCurrentAudioDriver() == NULL) {
+        result = SDL_AudioInit(NULL);
+        SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+        SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+    }
+    return result;
+}
+
 
 /* Global counter for callback invocation */
 int _audio_testCallbackCounter;
@@ -968,6 +984,966 @@ int audio_openCloseAudioDeviceConnected()
 }
 
 
+/**
+ * \brief Queue audio on a paused device, with and without the lock-free queue.
+ *
+ * \sa https://wiki.libsdl.org/SDL_QueueAudio
+ * \sa https://wiki.libsdl.org/SDL_GetQueuedAudioSize
+ * \sa https://wiki.libsdl.org/SDL_ClearQueuedAudio
+ */
+int audio_queueAudio()
+{
+   static Uint8 data[20000];
+   const char *hints[] = { "0", "1" };
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   Uint32 queued;
+   int result;
+   int i;
+
+   if (_audioEnsureDriver() != 0) {
+     return TEST_ABORTED;
+   }
+
+   for (i = 0; i < SDL_arraysize(hints); i++) {
+     SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, hints[i]);
+     SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, \"%s\")", hints[i]);
+
+     /* Open a device without a callback, it stays paused */
+     SDL_zero(desired);
+     desired.freq = 22050;
+     desired.format = AUDIO_S16SYS;
+     desired.channels = 2;
+     desired.samples = 4096;
+     id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+     SDLTest_AssertPass("SDL_OpenAudioDevice(NULL, 0, ...)");
+     SDLTest_AssertCheck(id > 1, "Validate device ID; expected: >1, got: %i", id);
+     if (id <= 1) {
+       continue;
+     }
+
+     result = SDL_QueueAudio(id, data, sizeof (data));
+     SDLTest_AssertPass("Call to SDL_QueueAudio(%i bytes)", (int) sizeof (data));
+     SDLTest_AssertCheck(result == 0, "Verify return value; expected: 0, got: %i", result);
+     result = SDL_QueueAudio(id, data, sizeof (data) / 3);
+     SDLTest_AssertPass("Call to SDL_QueueAudio(%i bytes)", (int) sizeof (data) / 3);
+     SDLTest_AssertCheck(result == 0, "Verify return value; expected: 0, got: %i", result);
+
+     queued = SDL_GetQueuedAudioSize(id);
+     SDLTest_AssertPass("Call to SDL_GetQueuedAudioSize()");
+     SDLTest_AssertCheck(queued >= sizeof (data) + sizeof (data) / 3, "Verify queued size; expected: >=%i, got: %u", (int) (sizeof (data) + sizeof (data) / 3), queued);
+
+     SDL_ClearQueuedAudio(id);
+     SDLTest_AssertPass("Call to SDL_ClearQueuedAudio()");
+     queued = SDL_GetQueuedAudioSize(id);
+     SDLTest_AssertPass("Call to SDL_GetQueuedAudioSize()");
+     SDLTest_AssertCheck(queued == 0, "Verify queued size; expected: 0, got: %u", queued);
+
+     result = SDL_QueueAudio(id, data, sizeof (data));
+     SDLTest_AssertPass("Call to SDL_QueueAudio(%i bytes) after clearing", (int) sizeof (data));
+     SDLTest_AssertCheck(result == 0, "Verify return value; expected: 0, got: %i", result);
+
+     SDL_CloseAudioDevice(id);
+     SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+   }
+
+   SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, NULL);
+   return TEST_COMPLETED;
+}
+
+/**
+ * \brief Write audio straight into the queue with SDL_ReserveQueuedAudio()
+ *
+ * \sa https://wiki.libsdl.org/SDL_ReserveQueuedAudio
+ * \sa https://wiki.libsdl.org/SDL_CommitQueuedAudio
+ * \sa https://wiki.libsdl.org/SDL_PeekQueuedAudio
+ */
+int audio_reserveQueuedAudio()
+{
+   static Uint8 data[1000];
+   const char *hints[] = { "0", "1" };
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   Uint32 queued, len, total;
+   const void *peeked;
+   void *buffer;
+   int result;
+   int i;
+
+   if (_audioEnsureDriver() != 0) {
+     return TEST_ABORTED;
+   }
+
+   for (i = 0; i < SDL_arraysize(hints); i++) {
+     SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, hints[i]);
+     SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, \"%s\")", hints[i]);
+
+     SDL_zero(desired);
+     desired.freq = 22050;
+     desired.format = AUDIO_S16SYS;
+     desired.channels = 2;
+     desired.samples = 4096;
+     id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+     SDLTest_AssertPass("SDL_OpenAudioDevice(NULL, 0, ...)");
+     SDLTest_AssertCheck(id > 1, "Validate device ID; expected: >1, got: %i", id);
+     if (id <= 1) {
+       continue;
+     }
+
+     /* Queue more than fits in one piece, a bit at a time */
+     total = 0;
+     while (total < 100000) {
+       len = 100000 - total;
+       buffer = SDL_ReserveQueuedAudio(id, &len);
+       if (buffer == NULL || len == 0) {
+         break;
+       }
+       SDL_memset(buffer, 0x11, len);
+       result = SDL_CommitQueuedAudio(id, len);
+       if (result != 0) {
+         break;
+       }
+       total += len;
+     }
+     SDLTest_AssertPass("Call to SDL_ReserveQueuedAudio()/SDL_CommitQueuedAudio() until 100000 bytes are queued");
+     SDLTest_AssertCheck(total == 100000, "Verify bytes committed; expected: 100000, got: %u (%s)", total, SDL_GetError());
+
+     queued = SDL_GetQueuedAudioSize(id);
+     SDLTest_AssertPass("Call to SDL_GetQueuedAudioSize()");
+     SDLTest_AssertCheck(queued >= total, "Verify queued size; expected: >=%u, got: %u", total, queued);
+
+     /* A write fills the rest of the last (8k) packet before starting a new one */
+     len = 100000;
+     buffer = SDL_ReserveQueuedAudio(id, &len);
+     SDLTest_AssertPass("Call to SDL_ReserveQueuedAudio(100000 bytes)");
+     SDLTest_AssertCheck(buffer != NULL && len == 8192 - (100000 % 8192), "Verify reserved space; expected: %i bytes, got: %u", 8192 - (100000 % 8192), len);
+     result = SDL_CommitQueuedAudio(id, 0);
+     SDLTest_AssertCheck(result == 0, "Verify canceling the write; expected: 0, got: %i", result);
+
+     /* Only one write at a time, and no copying writes in between */
+     len = sizeof (data);
+     buffer = SDL_ReserveQueuedAudio(id, &len);
+     SDLTest_AssertPass("Call to SDL_ReserveQueuedAudio(%i bytes)", (int) sizeof (data));
+     SDLTest_AssertCheck(buffer != NULL && len == sizeof (data), "Verify reserved space; expected: %i bytes, got: %u", (int) sizeof (data), len);
+     len = sizeof (data);
+     SDLTest_AssertCheck(SDL_ReserveQueuedAudio(id, &len) == NULL, "Verify second SDL_ReserveQueuedAudio() fails");
+     result = SDL_QueueAudio(id, data, sizeof (data));
+     SDLTest_AssertCheck(result == -1, "Verify SDL_QueueAudio() during a write; expected: -1, got: %i", result);
+     result = SDL_CommitQueuedAudio(id, sizeof (data) + 1);
+     SDLTest_AssertCheck(result == -1, "Verify committing too much; expected: -1, got: %i", result);
+     result = SDL_CommitQueuedAudio(id, 0);
+     SDLTest_AssertCheck(result == 0, "Verify canceling the write; expected: 0, got: %i", result);
+     result = SDL_CommitQueuedAudio(id, 0);
+     SDLTest_AssertCheck(result == -1, "Verify committing without a write; expected: -1, got: %i", result);
+     result = SDL_QueueAudio(id, data, sizeof (data));
+     SDLTest_AssertCheck(result == 0, "Verify SDL_QueueAudio() after the write; expected: 0, got: %i", result);
+
+     /* Playback devices can't be read from */
+     len = 1;
+     peeked = SDL_PeekQueuedAudio(id, &len);
+     SDLTest_AssertCheck(peeked == NULL, "Verify SDL_PeekQueuedAudio() on a playback device fails");
+     result = SDL_ReleaseQueuedAudio(id, 0);
+     SDLTest_AssertCheck(result == -1, "Verify SDL_ReleaseQueuedAudio() on a playback device; expected: -1, got: %i", result);
+
+     SDL_CloseAudioDevice(id);
+     SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+   }
+
+   len = 1;
+   buffer = SDL_ReserveQueuedAudio(0, &len);
+   SDLTest_AssertCheck(buffer == NULL, "Verify SDL_ReserveQueuedAudio() on an invalid device fails");
+
+   SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, NULL);
+   return TEST_COMPLETED;
+}
+
+/**
+ * \brief Queue audio into the ring buffer of a device opened with SDL_OpenAudioDeviceRing()
+ *
+ * \sa https://wiki.libsdl.org/SDL_OpenAudioDeviceRing
+ * \sa https://wiki.libsdl.org/SDL_GetAudioRingStatus
+ */
+int audio_audioRing()
+{
+   static Uint8 data[10000];
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   SDL_AudioRingStatus status;
+   Uint32 len;
+   void *buffer;
+   int totalDelay;
+   int result;
+
+   if (_audioEnsureDriver() != 0) {
+     return TEST_ABORTED;
+   }
+
+   SDL_zero(desired);
+   desired.freq = 22050;
+   desired.format = AUDIO_S16SYS;
+   desired.channels = 2;
+   desired.samples = 1024;
+   desired.callback = _audio_testCallback;
+   id = SDL_OpenAudioDeviceRing(NULL, 0, &desired, &obtained, 0, sizeof (data));
+   SDLTest_AssertPass("SDL_OpenAudioDeviceRing(NULL, 0, ...) with a callback");
+   SDLTest_AssertCheck(id == 0, "Validate device ID; expected: 0, got: %i", id);
+
+   desired.callback = NULL;
+   id = SDL_OpenAudioDeviceRing(NULL, 0, &desired, &obtained, 0, sizeof (data));
+   SDLTest_AssertPass("SDL_OpenAudioDeviceRing(NULL, 0, ...)");
+   SDLTest_AssertCheck(id > 1, "Validate device ID; expected: >1, got: %i", id);
+   if (id <= 1) {
+     return TEST_ABORTED;
+   }
+
+   result = SDL_GetAudioRingStatus(id, &status);
+   SDLTest_AssertPass("Call to SDL_GetAudioRingStatus()");
+   SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0, got: %i", result);
+   SDLTest_AssertCheck(status.size == 16384, "Verify ring size; expected: 16384, got: %u", status.size);
+   SDLTest_AssertCheck(status.queued == 0, "Verify queued size; expected: 0, got: %u", status.queued);
+   SDLTest_AssertCheck(status.underruns == 0, "Verify underruns; expected: 0, got: %u", status.underruns);
+
+   /* The ring doesn't grow */
+   result = SDL_QueueAudio(id, data, sizeof (data));
+   SDLTest_AssertCheck(result == 0, "Verify SDL_QueueAudio(%i bytes); expected: 0, got: %i", (int) sizeof (data), result);
+   result = SDL_QueueAudio(id, data, sizeof (data));
+   SDLTest_AssertCheck(result == -1, "Verify SDL_QueueAudio() into a full ring; expected: -1, got: %i", result);
+   SDLTest_AssertCheck(SDL_GetQueuedAudioSize(id) == sizeof (data), "Verify queued size; expected: %i", (int) sizeof (data));
+
+   /* Writing in place stops at the end of the ring */
+   len = sizeof (data);
+   buffer = SDL_ReserveQueuedAudio(id, &len);
+   SDLTest_AssertPass("Call to SDL_ReserveQueuedAudio(%i bytes)", (int) sizeof (data));
+   SDLTest_AssertCheck(buffer != NULL && len == 16384 - sizeof (data), "Verify reserved space; expected: %i bytes, got: %u", 16384 - (int) sizeof (data), len);
+   result = SDL_CommitQueuedAudio(id, len + 1);
+   SDLTest_AssertCheck(result == -1, "Verify committing too much; expected: -1, got: %i", result);
+   result = SDL_CommitQueuedAudio(id, len);
+   SDLTest_AssertCheck(result == 0, "Verify SDL_CommitQueuedAudio(); expected: 0, got: %i", result);
+   SDLTest_AssertCheck(SDL_GetQueuedAudioSize(id) == 16384, "Verify queued size; expected: 16384");
+   len = 1;
+   SDLTest_AssertCheck(SDL_ReserveQueuedAudio(id, &len) == NULL, "Verify SDL_ReserveQueuedAudio() on a full ring fails");
+
+   SDL_ClearQueuedAudio(id);
+   SDLTest_AssertPass("Call to SDL_ClearQueuedAudio()");
+   SDLTest_AssertCheck(SDL_GetQueuedAudioSize(id) == 0, "Verify queued size; expected: 0");
+
+   /* Only what was reserved can be committed, even with room to spare */
+   len = 16;
+   buffer = SDL_ReserveQueuedAudio(id, &len);
+   SDLTest_AssertCheck(buffer != NULL && len == 16, "Verify reserved space; expected: 16 bytes, got: %u", len);
+   result = SDL_CommitQueuedAudio(id, 17);
+   SDLTest_AssertCheck(result == -1, "Verify committing more than was reserved; expected: -1, got: %i", result);
+   result = SDL_CommitQueuedAudio(id, 16);
+   SDLTest_AssertCheck(result == 0, "Verify SDL_CommitQueuedAudio(); expected: 0, got: %i", result);
+   result = SDL_CommitQueuedAudio(id, 16);
+   SDLTest_AssertCheck(result == -1, "Verify committing again without a reservation; expected: -1, got: %i", result);
+   SDLTest_AssertCheck(SDL_GetQueuedAudioSize(id) == 16, "Verify queued size; expected: 16");
+
+   SDL_ClearQueuedAudio(id);
+   SDLTest_AssertPass("Call to SDL_ClearQueuedAudio()");
+
+   /* Let the device play half a buffer, then run dry */
+   result = SDL_QueueAudio(id, data, obtained.size / 2);
+   SDLTest_AssertCheck(result == 0, "Verify SDL_QueueAudio(%i bytes); expected: 0, got: %i", (int) obtained.size / 2, result);
+   SDL_PauseAudioDevice(id, 0);
+   totalDelay = 0;
+   while (SDL_GetQueuedAudioSize(id) > 0 && totalDelay < 1000) {
+     SDL_Delay(10);
+     totalDelay += 10;
+   }
+   SDL_Delay((obtained.samples * 1000 / obtained.freq) * 2);
+   result = SDL_GetAudioRingStatus(id, &status);
+   SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0, got: %i", result);
+   SDLTest_AssertCheck(status.queued == 0, "Verify queued size; expected: 0, got: %u", status.queued);
+   SDLTest_AssertCheck(status.underruns == 1, "Verify underruns; expected: 1, got: %u", status.underruns);
+   SDLTest_AssertCheck(status.overruns == 0, "Verify overruns; expected: 0, got: %u", status.overruns);
+
+   SDL_CloseAudioDevice(id);
+   SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+   result = SDL_GetAudioRingStatus(id, &status);
+   SDLTest_AssertCheck(result == -1, "Verify SDL_GetAudioRingStatus() on a closed device; expected: -1, got: %i", result);
+
+   return TEST_COMPLETED;
+}
+
+/* Test callback function that takes longer than a buffer lasts */
+void SDLCALL _audio_slowCallback(void *userdata, Uint8 *stream, int len)
+{
+   SDL_memset(stream, 0, len);
+   SDL_Delay(30);
+}
+
+/**
+ * \brief Check the playback statistics of a device whose callback can't keep up
+ *
+ * \sa https://wiki.libsdl.org/SDL_GetAudioDeviceStats
+ * \sa https://wiki.libsdl.org/SDL_ResetAudioDeviceStats
+ */
+int audio_audioDeviceStats()
+{
+   const char *driver;
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   SDL_AudioDeviceStats stats;
+   int result;
+
+   if (_audioEnsureDriver() != 0) {
+     return TEST_ABORTED;
+   }
+
+   /* 512 samples at 44100Hz last about 11.6ms, less than the callback takes */
+   SDL_zero(desired);
+   desired.freq = 44100;
+   desired.format = AUDIO_S16SYS;
+   desired.channels = 2;
+   desired.samples = 512;
+   desired.callback = _audio_slowCallback;
+   id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+   SDLTest_AssertPass("SDL_OpenAudioDevice(NULL, 0, ...)");
+   SDLTest_AssertCheck(id > 1, "Validate device ID; expected: >1, got: %i", id);
+   if (id <= 1) {
+     return TEST_ABORTED;
+   }
+
+   result = SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertPass("Call to SDL_GetAudioDeviceStats()");
+   SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0, got: %i", result);
+   SDLTest_AssertCheck(stats.callbacks == 0, "Verify callbacks of a paused device; expected: 0, got: %u", stats.callbacks);
+   SDLTest_AssertCheck(stats.buffer_period == 11609977, "Verify buffer period; expected: 11609977, got: %u", (Uint32) stats.buffer_period);
+
+   SDL_PauseAudioDevice(id, 0);
+   SDL_Delay(300);
+   SDL_PauseAudioDevice(id, 1);
+   SDLTest_AssertPass("Play for 300ms");
+
+   result = SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0, got: %i", result);
+   SDLTest_AssertCheck(stats.callbacks >= 2, "Verify callbacks; expected: >=2, got: %u", stats.callbacks);
+   SDLTest_AssertCheck(stats.min_callback_duration >= 25000000, "Verify shortest callback; expected: >=25ms, got: %u ns", (Uint32) stats.min_callback_duration);
+   SDLTest_AssertCheck(stats.min_callback_duration <= stats.avg_callback_duration && stats.avg_callback_duration <= stats.max_callback_duration,
+                       "Verify min <= avg <= max callback duration");
+   SDLTest_AssertCheck(stats.silence_frames == 0, "Verify silence frames; expected: 0, got: %u", stats.silence_frames);
+
+   /* Only the drivers that simulate a device in real time are sure to notice */
+   driver = SDL_GetCurrentAudioDriver();
+   if (driver && (SDL_strcmp(driver, "dummy") == 0 || SDL_strcmp(driver, "disk") == 0)) {
+     SDLTest_AssertCheck(stats.underruns >= 1, "Verify underruns; expected: >=1, got: %u", stats.underruns);
+   }
+
+   SDL_ResetAudioDeviceStats(id);
+   SDLTest_AssertPass("Call to SDL_ResetAudioDeviceStats()");
+   result = SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0, got: %i", result);
+   SDLTest_AssertCheck(stats.callbacks == 0, "Verify callbacks after reset; expected: 0, got: %u", stats.callbacks);
+   SDLTest_AssertCheck(stats.underruns == 0, "Verify underruns after reset; expected: 0, got: %u", stats.underruns);
+
+   SDL_CloseAudioDevice(id);
+   SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+   result = SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertCheck(result == -1, "Verify SDL_GetAudioDeviceStats() on a closed device; expected: -1, got: %i", result);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * \brief Mix several voices with SDL_AudioMixerGet()
+ *
+ * \sa https://wiki.libsdl.org/SDL_NewAudioMixer
+ * \sa https://wiki.libsdl.org/SDL_AudioMixerGet
+ */
+int audio_audioMixer()
+{
+   float fdata[100];
+   Sint16 sdata[50];
+   Sint16 output[200 * 2];
+   SDL_AudioMixer *mixer;
+   int fvoice, svoice;
+   int result;
+   int i;
+
+   for (i = 0; i < SDL_arraysize(fdata); i++) {
+     fdata[i] = 0.25f;
+   }
+   for (i = 0; i < SDL_arraysize(sdata); i++) {
+     sdata[i] = 8192;
+   }
+
+   mixer = SDL_NewAudioMixer(AUDIO_S16SYS, 2, 22050);
+   SDLTest_AssertPass("Call to SDL_NewAudioMixer(AUDIO_S16SYS, 2, 22050)");
+   SDLTest_AssertCheck(mixer != NULL, "Validate mixer; expected: !NULL, got: %p (%s)", (void *) mixer, SDL_GetError());
+   if (mixer == NULL) {
+     return TEST_ABORTED;
+   }
+
+   fvoice = SDL_AudioMixerAddVoice(mixer, AUDIO_F32SYS, 1, 22050);
+   svoice = SDL_AudioMixerAddVoice(mixer, AUDIO_S16SYS, 1, 22050);
+   SDLTest_AssertPass("Call to SDL_AudioMixerAddVoice() for a float and an int16 voice");
+   SDLTest_AssertCheck(fvoice > 0 && svoice > 0 && fvoice != svoice, "Validate voice IDs; expected: two different IDs >0, got: %i, %i", fvoice, svoice);
+
+   /* The short voice stops halfway through the longer one, then it's all silence.
+      Allow for the float to int16 conversion scaling by 32767 or 32768. */
+   SDL_AudioMixerPutVoice(mixer, fvoice, fdata, sizeof (fdata));
+   SDL_AudioMixerPutVoice(mixer, svoice, sdata, sizeof (sdata));
+   result = SDL_AudioMixerVoiceAvailable(mixer, svoice);
+   SDLTest_AssertCheck(result == 50 * 2 * sizeof (Sint16), "Verify SDL_AudioMixerVoiceAvailable(); expected: %i, got: %i", (int) (50 * 2 * sizeof (Sint16)), result);
+   result = SDL_AudioMixerGet(mixer, output, sizeof (output));
+   SDLTest_AssertPass("Call to SDL_AudioMixerGet()");
+   SDLTest_AssertCheck(result == sizeof (output), "Verify mixed bytes; expected: %i, got: %i", (int) sizeof (output), result);
+   SDLTest_AssertCheck(SDL_abs(output[0] - 16384) <= 1 && SDL_abs(output[99] - 16384) <= 1, "Verify both voices mixed; expected: 16384 +/- 1, got: %i, %i", output[0], output[99]);
+   SDLTest_AssertCheck(SDL_abs(output[100] - 8192) <= 1 && SDL_abs(output[199] - 8192) <= 1, "Verify one voice mixed; expected: 8192 +/- 1, got: %i, %i", output[100], output[199]);
+   SDLTest_AssertCheck(output[200] == 0 && output[399] == 0, "Verify silence; expected: 0, got: %i, %i", output[200], output[399]);
+   result = SDL_AudioMixerVoiceAvailable(mixer, fvoice);
+   SDLTest_AssertCheck(result == 0, "Verify the voices ran out; expected: 0, got: %i", result);
+
+   /* Pan the int16 voice hard right, and turn the float one up until it clips */
+   result = SDL_AudioMixerSetVoiceGain(mixer, svoice, 1.0f, 1.0f);
+   SDLTest_AssertCheck(result == 0, "Verify SDL_AudioMixerSetVoiceGain(); expected: 0, got: %i", result);
+   result = SDL_AudioMixerSetVoiceGain(mixer, fvoice, 8.0f, 0.0f);
+   SDLTest_AssertCheck(result == 0, "Verify SDL_AudioMixerSetVoiceGain(); expected: 0, got: %i", result);
+   SDL_AudioMixerPutVoice(mixer, svoice, sdata, sizeof (sdata));
+   SDL_AudioMixerGet(mixer, output, 50 * 2 * sizeof (Sint16));
+   SDLTest_AssertCheck(output[0] == 0 && SDL_abs(output[1] - 8192) <= 1, "Verify panning; expected: 0, 8192 +/- 1, got: %i, %i", output[0], output[1]);
+   SDL_AudioMixerPutVoice(mixer, fvoice, fdata, sizeof (fdata));
+   SDL_AudioMixerGet(mixer, output, 50 * 2 * sizeof (Sint16));
+   SDLTest_AssertCheck(output[0] == 32767 && output[1] == 32767, "Verify clipping; expected: 32767, got: %i, %i", output[0], output[1]);
+
+   /* Removed voices are gone, and bad arguments are caught */
+   result = SDL_AudioMixerRemoveVoice(mixer, fvoice);
+   SDLTest_AssertCheck(result == 0, "Verify SDL_AudioMixerRemoveVoice(); expected: 0, got: %i", result);
+   result = SDL_AudioMixerPutVoice(mixer, fvoice, fdata, sizeof (fdata));
+   SDLTest_AssertCheck(result == -1, "Verify SDL_AudioMixerPutVoice() on a removed voice; expected: -1, got: %i", result);
+   result = SDL_AudioMixerSetVoiceGain(mixer, svoice, 1.0f, 2.0f);
+   SDLTest_AssertCheck(result == -1, "Verify SDL_AudioMixerSetVoiceGain() with a bad pan; expected: -1, got: %i", result);
+   result = SDL_AudioMixerGet(mixer, output, 3);
+   SDLTest_AssertCheck(result == -1, "Verify SDL_AudioMixerGet() with a partial frame; expected: -1, got: %i", result);
+
+   SDL_FreeAudioMixer(mixer);
+   SDLTest_AssertPass("Call to SDL_FreeAudioMixer()");
+
+   return TEST_COMPLETED;
+}
+
+
+/* Append a little-endian value to a buffer being built */
+static Uint8 *
+_audioPutLE(Uint8 *dst, Uint32 value, int bytes)
+{
+   int i;
+   for (i = 0; i < bytes; i++) {
+     *dst++ = (Uint8) (value >> (8 * i));
+   }
+   return dst;
+}
+
+/* Build a WAVE file with random audio, a LIST chunk before the data, and
+   half a block of junk at the end that should be ignored. */
+static Uint8 *
+_audioMakeWAV(Uint16 encoding, Uint16 channels, Uint16 bits, Uint16 blockalign,
+              Uint16 samplesperblock, Uint32 blocks, Uint32 *filelen)
+{
+   const Sint16 coeffs[7][2] = {
+     { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 }, { 240, 0 }, { 460, -208 }, { 392, -232 }
+   };
+   const Uint32 fmtlen = (encoding == 0x0002) ? 50 : (encoding == 0x0011) ? 20 : 16;
+   const Uint32 datalen = blocks * blockalign + blockalign / 2;
+   Uint8 *file, *dst, *data;
+   Uint32 i, c;
+
+   *filelen = 12 + (8 + fmtlen) + (8 + 4) + (8 + datalen);
+   file = (Uint8 *) SDL_malloc(*filelen);
+   if (file == NULL) {
+     return NULL;
+   }
+   dst = _audioPutLE(file, 0x46464952, 4);  /* "RIFF" */
+   dst = _audioPutLE(dst, *filelen - 8, 4);
+   dst = _audioPutLE(dst, 0x45564157, 4);  /* "WAVE" */
+   dst = _audioPutLE(dst, 0x20746D66, 4);  /* "fmt " */
+   dst = _audioPutLE(dst, fmtlen, 4);
+   dst = _audioPutLE(dst, encoding, 2);
+   dst = _audioPutLE(dst, channels, 2);
+   dst = _audioPutLE(dst, 22050, 4);
+   dst = _audioPutLE(dst, 22050 * blockalign / samplesperblock, 4);
+   dst = _audioPutLE(dst, blockalign, 2);
+   dst = _audioPutLE(dst, bits, 2);
+   if (encoding == 0x0002) {
+     dst = _audioPutLE(dst, 32, 2);
+     dst = _audioPutLE(dst, samplesperblock, 2);
+     dst = _audioPutLE(dst, 7, 2);
+     for (i = 0; i < 7; i++) {
+       dst = _audioPutLE(dst, (Uint16) coeffs[i][0], 2);
+       dst = _audioPutLE(dst, (Uint16) coeffs[i][1], 2);
+     }
+   } else if (encoding == 0x0011) {
+     dst = _audioPutLE(dst, 2, 2);
+     dst = _audioPutLE(dst, samplesperblock, 2);
+   }
+   dst = _audioPutLE(dst, 0x5453494c, 4);  /* "LIST" */
+   dst = _audioPutLE(dst, 4, 4);
+   dst = _audioPutLE(dst, 0x4F464E49, 4);  /* "INFO" */
+   dst = _audioPutLE(dst, 0x61746164, 4);  /* "data" */
+   dst = _audioPutLE(dst, datalen, 4);
+
+   data = dst;
+   for (i = 0; i < datalen; i++) {
+     data[i] = (Uint8) SDLTest_RandomUint8();
+   }
+   /* MS ADPCM blocks start with a predictor per channel, which must be valid */
+   if (encoding == 0x0002) {
+     for (i = 0; i < blocks; i++) {
+       for (c = 0; c < channels; c++) {
+         data[i * blockalign + c] %= 7;
+       }
+     }
+   }
+   return file;
+}
+
+/**
+ * \brief Stream PCM and ADPCM WAVE files and compare them with SDL_LoadWAV_RW()
+ *
+ * \sa https://wiki.libsdl.org/SDL_OpenWAVStream_RW
+ * \sa https://wiki.libsdl.org/SDL_WAVStreamRead
+ * \sa https://wiki.libsdl.org/SDL_WAVStreamSeek
+ */
+int audio_streamWAV()
+{
+   const struct {
+     const char *name;
+     Uint16 encoding, channels, bits, blockalign, samplesperblock;
+   } files[] = {
+     { "16-bit PCM", 0x0001, 2, 16, 4, 1 },
+     { "MS ADPCM", 0x0002, 1, 4, 256, 500 },
+     { "IMA ADPCM", 0x0011, 2, 4, 512, 505 }
+   };
+   SDL_AudioSpec loadedspec, spec;
+   SDL_WAVStream *wav;
+   SDL_AudioMixer *mixer;
+   Uint8 *file, *loaded, *streamed;
+   Uint32 filelen, loadedlen, length, offset;
+   int i, voice, result, framesize;
+
+   for (i = 0; i < SDL_arraysize(files); i++) {
+     file = _audioMakeWAV(files[i].encoding, files[i].channels, files[i].bits,
+                          files[i].blockalign, files[i].samplesperblock,
+                          files[i].encoding == 0x0001 ? 20000 : 40, &filelen);
+     SDLTest_AssertCheck(file != NULL, "Build %s WAVE file", files[i].name);
+     if (file == NULL) {
+       return TEST_ABORTED;
+     }
+
+     SDLTest_AssertCheck(SDL_LoadWAV_RW(SDL_RWFromConstMem(file, filelen), 1, &loadedspec, &loaded, &loadedlen) != NULL,
+                         "Load %s WAVE file with SDL_LoadWAV_RW()", files[i].name);
+     wav = SDL_OpenWAVStream_RW(SDL_RWFromConstMem(file, filelen), 1, &spec);
+     SDLTest_AssertPass("Call to SDL_OpenWAVStream_RW()");
+     SDLTest_AssertCheck(wav != NULL, "Verify stream is not NULL");
+     if (wav == NULL) {
+       SDL_FreeWAV(loaded);
+       SDL_free(file);
+       return TEST_ABORTED;
+     }
+     SDLTest_AssertCheck(spec.format == loadedspec.format && spec.channels == loadedspec.channels && spec.freq == loadedspec.freq,
+                         "Verify spec; expected: 0x%x %d %d, got: 0x%x %d %d",
+                         loadedspec.format, loadedspec.channels, loadedspec.freq, spec.format, spec.channels, spec.freq);
+     framesize = (SDL_AUDIO_BITSIZE(spec.format) / 8) * spec.channels;
+     length = SDL_WAVStreamLength(wav);
+     SDLTest_AssertCheck(length * framesize == loadedlen, "Verify length; expected: %u, got: %u", loadedlen / framesize, length);
+
+     /* Read the whole file in pieces that don't line up with blocks */
+     streamed = (Uint8 *) SDL_malloc(loadedlen);
+     offset = 0;
+     while ((result = SDL_WAVStreamRead(wav, streamed + offset, SDL_min(1001, loadedlen - offset))) > 0) {
+       offset += result;
+     }
+     SDLTest_AssertCheck(result == 0, "Verify the last SDL_WAVStreamRead(); expected: 0, got: %d", result);
+     SDLTest_AssertCheck(offset == loadedlen, "Verify bytes read; expected: %u, got: %u", loadedlen, offset);
+     SDLTest_AssertCheck(SDL_memcmp(streamed, loaded, loadedlen) == 0, "Verify streamed audio matches the loaded audio");
+
+     /* Jump back into the middle of a block */
+     offset = length / 3 + 7;
+     result = SDL_WAVStreamSeek(wav, offset);
+     SDLTest_AssertCheck(result == 0, "Verify SDL_WAVStreamSeek(); expected: 0, got: %d", result);
+     SDLTest_AssertCheck(SDL_WAVStreamTell(wav) == offset, "Verify SDL_WAVStreamTell(); expected: %u, got: %u", offset, SDL_WAVStreamTell(wav));
+     result = SDL_WAVStreamRead(wav, streamed, 3000 * framesize);
+     SDLTest_AssertCheck(result == 3000 * framesize, "Verify SDL_WAVStreamRead() after seeking; expected: %d, got: %d", 3000 * framesize, result);
+     SDLTest_AssertCheck(SDL_memcmp(streamed, loaded + offset * framesize, 3000 * framesize) == 0, "Verify audio after seeking");
+     result = SDL_WAVStreamSeek(wav, length + 1);
+     SDLTest_AssertCheck(result == -1, "Verify SDL_WAVStreamSeek() past the end; expected: -1, got: %d", result);
+
+     /* Decode the rest straight into a mixer voice */
+     mixer = SDL_NewAudioMixer(spec.format, spec.channels, spec.freq);
+     voice = SDL_AudioMixerAddVoice(mixer, spec.format, spec.channels, spec.freq);
+     SDLTest_AssertCheck(voice > 0, "Verify SDL_AudioMixerAddVoice(); expected: >0, got: %d", voice);
+     result = SDL_WAVStreamPutMixerVoice(wav, mixer, voice, loadedlen);
+     offset = (length - offset - 3000) * framesize;
+     SDLTest_AssertCheck(result == (int) offset, "Verify SDL_WAVStreamPutMixerVoice(); expected: %u, got: %d", offset, result);
+     result = SDL_AudioMixerVoiceAvailable(mixer, voice);
+     SDLTest_AssertCheck(result == (int) offset, "Verify SDL_AudioMixerVoiceAvailable(); expected: %u, got: %d", offset, result);
+     SDL_FreeAudioMixer(mixer);
+
+     SDL_CloseWAVStream(wav);
+     SDLTest_AssertPass("Call to SDL_CloseWAVStream()");
+     SDL_free(streamed);
+     SDL_FreeWAV(loaded);
+     SDL_free(file);
+   }
+
+   /* A file with a broken header is refused */
+   file = _audioMakeWAV(0x0011, 2, 4, 512, 500, 1, &filelen);
+   if (file != NULL) {
+     wav = SDL_OpenWAVStream_RW(SDL_RWFromConstMem(file, filelen), 1, &spec);
+     SDLTest_AssertCheck(wav == NULL, "Verify SDL_OpenWAVStream_RW() with a bad IMA ADPCM block size fails");
+     SDL_free(file);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/* Run a conversion's filter chain over the whole buffer in one go, the way
+   SDL_ConvertAudio() did before it worked in blocks. */
+static void
+_audioConvertUnblocked(SDL_AudioCVT *cvt)
+{
+   cvt->len_cvt = cvt->len;
+   cvt->filter_index = 0;
+   if (cvt->filters[0] != NULL) {
+     cvt->filters[0](cvt, cvt->src_format);
+   }
+}
+
+/**
+ * \brief Compare SDL_ConvertAudio(), which converts in blocks, with running the filters over the whole buffer
+ *
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertAudioBlocked()
+{
+   const struct {
+     SDL_AudioFormat src_format;
+     Uint8 src_channels;
+     int src_rate;
+     SDL_AudioFormat dst_format;
+     Uint8 dst_channels;
+     int dst_rate;
+   } conversions[] = {
+     { AUDIO_S16LSB, 2, 44100, AUDIO_S16MSB, 6, 44100 },  /* grows: blocks go backwards */
+     { AUDIO_U8, 1, 22050, AUDIO_F32SYS, 6, 22050 },
+     { AUDIO_F32SYS, 6, 48000, AUDIO_S16SYS, 1, 48000 },  /* shrinks */
+     { AUDIO_S32MSB, 4, 48000, AUDIO_F32LSB, 2, 48000 },
+     { AUDIO_F32MSB, 2, 44100, AUDIO_S8, 2, 44100 },
+     { AUDIO_U16LSB, 8, 44100, AUDIO_S16LSB, 2, 44100 },
+     { AUDIO_S16LSB, 2, 44100, AUDIO_U8, 1, 22050 },     /* blocks around a resampler */
+     { AUDIO_U16MSB, 1, 22050, AUDIO_S32SYS, 2, 48000 },
+     { AUDIO_S16SYS, 2, 44100, AUDIO_S16SYS, 2, 48000 }   /* int16 resampler */
+   };
+   /* None of these are a whole number of 8K blocks */
+   const int frames[] = { 1000, 4099, 20011 };
+   SDL_AudioCVT cvt, ref;
+   Uint8 *buf, *refbuf;
+   int framesize, len, i, j, k, result;
+
+   for (i = 0; i < SDL_arraysize(conversions); i++) {
+     result = SDL_BuildAudioCVT(&cvt, conversions[i].src_format, conversions[i].src_channels, conversions[i].src_rate,
+                                conversions[i].dst_format, conversions[i].dst_channels, conversions[i].dst_rate);
+     SDLTest_AssertPass("Call to SDL_BuildAudioCVT(0x%.4x, %i, %i ==> 0x%.4x, %i, %i)",
+                        conversions[i].src_format, conversions[i].src_channels, conversions[i].src_rate,
+                        conversions[i].dst_format, conversions[i].dst_channels, conversions[i].dst_rate);
+     SDLTest_AssertCheck(result == 1, "Verify result value; expected: 1, got: %i", result);
+     if (result != 1) {
+       SDLTest_LogError("%s", SDL_GetError());
+       continue;
+     }
+
+     framesize = (SDL_AUDIO_BITSIZE(conversions[i].src_format) / 8) * conversions[i].src_channels;
+     for (j = 0; j < SDL_arraysize(frames); j++) {
+       len = frames[j] * framesize;
+       buf = (Uint8 *)SDL_malloc(len * cvt.len_mult);
+       refbuf = (Uint8 *)SDL_malloc(len * cvt.len_mult);
+       SDLTest_AssertCheck(buf != NULL && refbuf != NULL, "Check conversion buffers are not NULL");
+       if (buf == NULL || refbuf == NULL) {
+         SDL_free(buf);
+         SDL_free(refbuf);
+         return TEST_ABORTED;
+       }
+
+       /* Keep float samples in range, the float to int conversions don't clamp */
+       if (SDL_AUDIO_ISFLOAT(conversions[i].src_format)) {
+         for (k = 0; k < len / 4; k++) {
+           float sample = (float)SDLTest_RandomSint16() / 32768.0f;
+           sample = SDL_AUDIO_ISBIGENDIAN(conversions[i].src_format) ? SDL_SwapFloatBE(sample) : SDL_SwapFloatLE(sample);
+           SDL_memcpy(buf + k * 4, &sample, 4);
+         }
+       } else {
+         for (k = 0; k < len; k++) {
+           buf[k] = SDLTest_RandomUint8();
+         }
+       }
+       SDL_memcpy(refbuf, buf, len);
+
+       ref = cvt;
+       ref.buf = refbuf;
+       ref.len = len;
+       _audioConvertUnblocked(&ref);
+
+       cvt.buf = buf;
+       cvt.len = len;
+       result = SDL_ConvertAudio(&cvt);
+       SDLTest_AssertPass("Call to SDL_ConvertAudio() with %i frames", frames[j]);
+       SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0; got: %i", result);
+       SDLTest_AssertCheck(cvt.len_cvt == ref.len_cvt, "Verify converted length; expected: %i; got: %i", ref.len_cvt, cvt.len_cvt);
+       if (cvt.len_cvt == ref.len_cvt) {
+         SDLTest_AssertCheck(SDL_memcmp(cvt.buf, ref.buf, cvt.len_cvt) == 0, "Verify converted data matches the unblocked conversion");
+       }
+
+       SDL_free(buf);
+       SDL_free(refbuf);
+       cvt.buf = NULL;
+     }
+   }
+
+   return TEST_COMPLETED;
+}
+
+/* The scalar mixer's arithmetic, one sample at a time: scale toward zero,
+   then add and saturate. Floats are added as doubles and clamped to the
+   float range. */
+static void
+_audioMixReference(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, int samples, int volume)
+{
+   const SDL_bool bigendian = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_TRUE : SDL_FALSE;
+   int i;
+
+   for (i = 0; i < samples; i++) {
+     if (SDL_AUDIO_ISFLOAT(format)) {
+       float s, d;
+       double sum;
+       SDL_memcpy(&s, src + i * 4, 4);
+       SDL_memcpy(&d, dst + i * 4, 4);
+       s = bigendian ? SDL_SwapFloatBE(s) : SDL_SwapFloatLE(s);
+       d = bigendian ? SDL_SwapFloatBE(d) : SDL_SwapFloatLE(d);
+       s = (s * (float)volume) * (1.0f / ((float)SDL_MIX_MAXVOLUME));
+       sum = SDL_max(SDL_min((double)s + (double)d, 3.402823466e+38F), -3.402823466e+38F);
+       d = bigendian ? SDL_SwapFloatBE((float)sum) : SDL_SwapFloatLE((float)sum);
+       SDL_memcpy(dst + i * 4, &d, 4);
+     } else if (SDL_AUDIO_BITSIZE(format) == 32) {
+       Uint32 s, d;
+       Sint64 sum;
+       SDL_memcpy(&s, src + i * 4, 4);
+       SDL_memcpy(&d, dst + i * 4, 4);
+       s = bigendian ? SDL_SwapBE32(s) : SDL_SwapLE32(s);
+       d = bigendian ? SDL_SwapBE32(d) : SDL_SwapLE32(d);
+       sum = (((Sint64)(Sint32)s) * volume) / SDL_MIX_MAXVOLUME + (Sint32)d;
+       d = (Uint32)(Sint32)SDL_max(SDL_min(sum, (Sint64)0x7fffffff), -(Sint64)0x80000000);
+       d = bigendian ? SDL_SwapBE32(d) : SDL_SwapLE32(d);
+       SDL_memcpy(dst + i * 4, &d, 4);
+     } else {
+       Uint16 s, d;
+       int sum;
+       SDL_memcpy(&s, src + i * 2, 2);
+       SDL_memcpy(&d, dst + i * 2, 2);
+       s = bigendian ? SDL_SwapBE16(s) : SDL_SwapLE16(s);
+       d = bigendian ? SDL_SwapBE16(d) : SDL_SwapLE16(d);
+       sum = (((Sint16)s) * volume) / SDL_MIX_MAXVOLUME + (Sint16)d;
+       d = (Uint16)(Sint16)SDL_max(SDL_min(sum, 32767), -32768);
+       d = bigendian ? SDL_SwapBE16(d) : SDL_SwapLE16(d);
+       SDL_memcpy(dst + i * 2, &d, 2);
+     }
+   }
+}
+
+/* Random samples, with a good share of them at or near full scale so the
+   sums saturate. */
+static void
+_audioFillMixSamples(Uint8 *buf, SDL_AudioFormat format, int samples)
+{
+   const SDL_bool bigendian = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_TRUE : SDL_FALSE;
+   const SDL_bool loud = (SDLTest_RandomIntegerInRange(0, 3) == 0) ? SDL_TRUE : SDL_FALSE;
+   int i;
+
+   for (i = 0; i < samples; i++) {
+     const SDL_bool full = (loud || SDLTest_RandomIntegerInRange(0, 3) == 0) ? SDL_TRUE : SDL_FALSE;
+     if (SDL_AUDIO_ISFLOAT(format)) {
+       float f = full ? (SDLTest_RandomSint8() < 0 ? -3.4e38f : 3.4e38f) : SDLTest_RandomUnitFloat() * 4.0f - 2.0f;
+       f = bigendian ? SDL_SwapFloatBE(f) : SDL_SwapFloatLE(f);
+       SDL_memcpy(buf + i * 4, &f, 4);
+     } else if (SDL_AUDIO_BITSIZE(format) == 32) {
+       Uint32 s = full ? (SDLTest_RandomSint8() < 0 ? 0x80000000 : 0x7fffffff) - SDLTest_RandomIntegerInRange(0, 3) : SDLTest_RandomUint32();
+       s = bigendian ? SDL_SwapBE32(s) : SDL_SwapLE32(s);
+       SDL_memcpy(buf + i * 4, &s, 4);
+     } else {
+       Uint16 s = full ? (SDLTest_RandomSint8() < 0 ? 0x8000 : 0x7fff) - SDLTest_RandomIntegerInRange(0, 3) : SDLTest_RandomUint16();
+       s = bigendian ? SDL_SwapBE16(s) : SDL_SwapLE16(s);
+       SDL_memcpy(buf + i * 2, &s, 2);
+     }
+   }
+}
+
+/**
+ * \brief Compare SDL_MixAudioFormat() with the scalar mixer's arithmetic
+ *
+ * On x86 and ARM this runs the SIMD mixers. Set SDL_MIX_CPU_FEATURES to
+ * 8 (SSE2), 64 (AVX2), 128 (NEON) or 0 (scalar) to pick which one.
+ *
+ * \sa https://wiki.libsdl.org/SDL_MixAudioFormat
+ */
+int audio_mixAudioFormat()
+{
+   const SDL_AudioFormat formats[] = {
+     AUDIO_S16LSB, AUDIO_S16MSB, AUDIO_S32LSB, AUDIO_S32MSB, AUDIO_F32LSB, AUDIO_F32MSB
+   };
+   const int volumes[] = { 1, 5, 64, 100, 127, SDL_MIX_MAXVOLUME };
+   /* None of these are a whole number of 16 or 32 byte vectors */
+   const int lengths[] = { 1, 3, 7, 9, 15, 17, 31, 33, 100, 257 };
+   Uint8 src[257 * 4], dst[257 * 4], expected[257 * 4];
+   const char *override = SDL_getenv("SDL_MIX_CPU_FEATURES");
+   int f, v, l, mismatches;
+
+   if (override != NULL) {
+     SDLTest_Log("Mixing with SDL_MIX_CPU_FEATURES=%s", override);
+   } else {
+     SDLTest_Log("Mixing with %s", SDL_HasAVX2() ? "AVX2" : SDL_HasSSE2() ? "SSE2" : SDL_HasNEON() ? "NEON" : "scalar code");
+   }
+
+   for (f = 0; f < SDL_arraysize(formats); f++) {
+     const int samplesize = SDL_AUDIO_BITSIZE(formats[f]) / 8;
+     mismatches = 0;
+     for (v = 0; v < SDL_arraysize(volumes); v++) {
+       for (l = 0; l < SDL_arraysize(lengths); l++) {
+         const int len = lengths[l] * samplesize;
+         _audioFillMixSamples(src, formats[f], lengths[l]);
+         _audioFillMixSamples(dst, formats[f], lengths[l]);
+         SDL_memcpy(expected, dst, len);
+         _audioMixReference(expected, src, formats[f], lengths[l], volumes[v]);
+         SDL_MixAudioFormat(dst, src, formats[f], len, volumes[v]);
+         if (SDL_memcmp(dst, expected, len) != 0) {
+           SDLTest_LogError("Format 0x%.4x, volume %i, %i samples mixed differently", formats[f], volumes[v], lengths[l]);
+           mismatches++;
+         }
+       }
+     }
+     SDLTest_AssertCheck(mismatches == 0, "Verify SDL_MixAudioFormat(0x%.4x) matches the scalar mixer; %i of %i mixes differ",
+                         formats[f], mismatches, (int)(SDL_arraysize(volumes) * SDL_arraysize(lengths)));
+   }
+
+   return TEST_COMPLETED;
+}
+
+/* The scalar type converters' arithmetic for one sample. Integers scale
+   into [-1, 1]; floats scale back and truncate toward zero. */
+static float
+_audioIntToFloatReference(const Uint8 *src, SDL_AudioFormat format)
+{
+   switch (format) {
+     case AUDIO_S8: return ((float)*(const Sint8 *)src) * 0.0078740157480315f;
+     case AUDIO_U8: return (((float)*src) * 0.0078740157480315f) - 1.0f;
+     case AUDIO_S16SYS: return ((float)*(const Sint16 *)src) * 3.05185094759972e-05f;
+     case AUDIO_U16SYS: return (((float)*(const Uint16 *)src) * 3.05185094759972e-05f) - 1.0f;
+     default: return (float)(((double)*(const Sint32 *)src) * 4.6566128752458e-10f);
+   }
+}
+
+static void
+_audioFloatToIntReference(Uint8 *dst, float sample, SDL_AudioFormat format)
+{
+   switch (format) {
+     case AUDIO_S8: *(Sint8 *)dst = (Sint8)(sample * 127.0f); break;
+     case AUDIO_U8: *dst = (Uint8)((sample + 1.0f) * 127.0f); break;
+     case AUDIO_S16SYS: *(Sint16 *)dst = (Sint16)(sample * 32767.0f); break;
+     case AUDIO_U16SYS: *(Uint16 *)dst = (Uint16)((sample + 1.0f) * 32767.0f); break;
+     default: *(Sint32 *)dst = (Sint32)(((double)sample) * 2147483647.0); break;
+   }
+}
+
+/**
+ * \brief Compare the integer to float and float to integer converters with the scalar arithmetic
+ *
+ * On x86 and ARM this runs the SSE2, AVX2 or NEON converters, whichever the
+ * CPU has.
+ *
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertAudioTypes()
+{
+   const SDL_AudioFormat formats[] = { AUDIO_S8, AUDIO_U8, AUDIO_S16SYS, AUDIO_U16SYS, AUDIO_S32SYS };
+   /* None of these are a whole number of 16 or 32 byte vectors */
+   const int lengths[] = { 1, 3, 7, 9, 15, 17, 31, 33, 100, 257 };
+   SDL_AudioCVT cvt;
+   Uint8 *buf, *expected;
+   float sample;
+   int f, l, offset, i, samplesize, mismatches, result;
+
+   buf = (Uint8 *)SDL_malloc((257 + 3) * 4 * 4);
+   expected = (Uint8 *)SDL_malloc(257 * 4);
+   SDLTest_AssertCheck(buf != NULL && expected != NULL, "Check conversion buffers are not NULL");
+   if (buf == NULL || expected == NULL) {
+     SDL_free(buf);
+     SDL_free(expected);
+     return TEST_ABORTED;
+   }
+
+   for (f = 0; f < SDL_arraysize(formats); f++) {
+     samplesize = SDL_AUDIO_BITSIZE(formats[f]) / 8;
+
+     /* Integer to float, every bit pattern allowed */
+     result = SDL_BuildAudioCVT(&cvt, formats[f], 1, 48000, AUDIO_F32SYS, 1, 48000);
+     SDLTest_AssertCheck(result == 1, "Verify SDL_BuildAudioCVT(0x%.4x ==> AUDIO_F32SYS) result; expected: 1, got: %i", formats[f], result);
+     mismatches = 0;
+     for (l = 0; l < SDL_arraysize(lengths); l++) {
+       /* Start a few samples in, so the vectors aren't always aligned */
+       for (offset = 0; offset < 4; offset++) {
+         cvt.buf = buf + offset * 4;
+         cvt.len = lengths[l] * samplesize;
+         for (i = 0; i < cvt.len; i++) {
+           cvt.buf[i] = SDLTest_RandomUint8();
+         }
+         for (i = 0; i < lengths[l]; i++) {
+           sample = _audioIntToFloatReference(cvt.buf + i * samplesize, formats[f]);
+           SDL_memcpy(expected + i * 4, &sample, 4);
+         }
+         SDL_ConvertAudio(&cvt);
+         if (cvt.len_cvt != lengths[l] * 4 || SDL_memcmp(cvt.buf, expected, cvt.len_cvt) != 0) {
+           SDLTest_LogError("Format 0x%.4x, %i samples at offset %i converted to float differently", formats[f], lengths[l], offset);
+           mismatches++;
+         }
+       }
+     }
+     SDLTest_AssertCheck(mismatches == 0, "Verify 0x%.4x to float matches the scalar converter; %i of %i conversions differ",
+                         formats[f], mismatches, (int)SDL_arraysize(lengths) * 4);
+
+     /* Float to integer, samples in [-1, 1] since these don't clamp */
+     result = SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 1, 48000, formats[f], 1, 48000);
+     SDLTest_AssertCheck(result == 1, "Verify SDL_BuildAudioCVT(AUDIO_F32SYS ==> 0x%.4x) result; expected: 1, got: %i", formats[f], result);
+     mismatches = 0;
+     for (l = 0; l < SDL_arraysize(lengths); l++) {
+       for (offset = 0; offset < 4; offset++) {
+         cvt.buf = buf + offset * 4;
+         cvt.len = lengths[l] * 4;
+         for (i = 0; i < lengths[l]; i++) {
+           switch (SDLTest_RandomIntegerInRange(0, 15)) {
+             case 0: sample = -1.0f; break;
+             case 1: sample = 1.0f; break;
+             default: sample = SDLTest_RandomUnitFloat() * 2.0f - 1.0f; break;
+           }
+           SDL_memcpy(cvt.buf + i * 4, &sample, 4);
+           _audioFloatToIntReference(expected + i * samplesize, sample, formats[f]);
+         }
+         SDL_ConvertAudio(&cvt);
+         if (cvt.len_cvt != lengths[l] * samplesize || SDL_memcmp(cvt.buf, expected, cvt.len_cvt) != 0) {
+           SDLTest_LogError("Float to format 0x%.4x, %i samples at offset %i converted differently", formats[f], lengths[l], offset);
+           mismatches++;
+         }
+       }
+     }
+     SDLTest_AssertCheck(mismatches == 0, "Verify float to 0x%.4x matches the scalar converter; %i of %i conversions differ",
+                         formats[f], mismatches, (int)SDL_arraysize(lengths) * 4);
+   }
+
+   SDL_free(buf);
+   SDL_free(expected);
+
+   return TEST_COMPLETED;
+}
 
 /* ================= Test Case References ================== */
 
@@ -1022,11 +1998,40 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_queueAudio, "audio_queueAudio", "Queue and clear audio with and without the lock-free queue.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_reserveQueuedAudio, "audio_reserveQueuedAudio", "Write to and peek at the audio queue without copying.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_audioMixer, "audio_audioMixer", "Mix several voices with gain and pan.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_audioRing, "audio_audioRing", "Queue audio into the ring buffer of a ring buffered device.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest20 =
+        { (SDLTest_TestCaseFp)audio_audioDeviceStats, "audio_audioDeviceStats", "Check the playback statistics of a device with a slow callback.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest21 =
+        { (SDLTest_TestCaseFp)audio_streamWAV, "audio_streamWAV", "Stream PCM and ADPCM WAVE files and compare them with SDL_LoadWAV_RW.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest22 =
+        { (SDLTest_TestCaseFp)audio_convertAudioBlocked, "audio_convertAudioBlocked", "Compare blocked conversions with converting the whole buffer at once.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest23 =
+        { (SDLTest_TestCaseFp)audio_mixAudioFormat, "audio_mixAudioFormat", "Compare the S16, S32 and F32 mixers with the scalar mixing arithmetic.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest24 =
+        { (SDLTest_TestCaseFp)audio_convertAudioTypes, "audio_convertAudioTypes", "Compare the integer and float converters with the scalar conversion arithmetic.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, &audioTest22,
+    &audioTest23, &audioTest24, NULL
 };
 
 /* Audio test suite (global) */
@@ -174,6 +174,259 @@ events_addDelEventWatchWithUserdata(void *arg)
    return TEST_COMPLETED;
 }
 
+/* Event filter that only lets events with an even code through */
+int _events_evenCodeEventFilter(void *userdata, SDL_Event *event)
+{
+   _eventFilterCalled++;
+   return (event->user.code % 2) == 0;
+}
+
+/**
+ * @brief Pushes a batch of events and checks that the accepted ones arrive in order
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvents
+ */
+int
+events_pushEvents(void *arg)
+{
+   SDL_Event events[16];
+   SDL_Event *many;
+   SDL_Event event;
+   SDL_EventQueueStats stats;
+   int result;
+   int i;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* Create user events */
+   for (i = 0; i < SDL_arraysize(events); i++) {
+      SDL_zero(events[i]);
+      events[i].type = SDL_USEREVENT;
+      events[i].user.code = i;
+   }
+
+   /* Push the whole batch without a filter */
+   result = SDL_PushEvents(events, SDL_arraysize(events));
+   SDLTest_AssertPass("Call to SDL_PushEvents()");
+   SDLTest_AssertCheck(result == SDL_arraysize(events), "Check result from SDL_PushEvents, expected: %d, got: %d", (int)SDL_arraysize(events), result);
+   for (i = 0; i < SDL_arraysize(events); i++) {
+      result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+      SDLTest_AssertCheck(result == 1 && event.user.code == i, "Check event %d, expected code: %d, got: %d", i, i, (result == 1) ? event.user.code : -1);
+   }
+
+   /* Push the batch through a filter that drops the odd ones */
+   SDL_ResetEventQueueStats();
+   _eventFilterCalled = 0;
+   SDL_SetEventFilter(_events_evenCodeEventFilter, NULL);
+   SDLTest_AssertPass("Call to SDL_SetEventFilter()");
+   result = SDL_PushEvents(events, SDL_arraysize(events));
+   SDLTest_AssertPass("Call to SDL_PushEvents()");
+   SDLTest_AssertCheck(result == SDL_arraysize(events) / 2, "Check result from SDL_PushEvents, expected: %d, got: %d", (int)SDL_arraysize(events) / 2, result);
+   SDLTest_AssertCheck(_eventFilterCalled == SDL_arraysize(events), "Check that event filter was called %d times, got: %d", (int)SDL_arraysize(events), _eventFilterCalled);
+   SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertCheck(stats.dropped == SDL_arraysize(events) / 2, "Check dropped, expected: %d, got: %u", (int)SDL_arraysize(events) / 2, (unsigned int) stats.dropped);
+   for (i = 0; i < SDL_arraysize(events); i += 2) {
+      result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+      SDLTest_AssertCheck(result == 1 && event.user.code == i, "Check event %d, expected code: %d, got: %d", i, i, (result == 1) ? event.user.code : -1);
+   }
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+   SDLTest_AssertCheck(result == 0, "Check that the queue is empty, expected: 0, got: %d", result);
+
+   /* Remove the filter */
+   SDL_SetEventFilter(NULL, NULL);
+   SDLTest_AssertPass("Call to SDL_SetEventFilter()");
+
+   /* Fill the queue to a few events short of its limit of 65535 */
+   many = (SDL_Event *)SDL_calloc(65530, sizeof(*many));
+   SDLTest_AssertCheck(many != NULL, "Check allocation of a large batch of events");
+   if (many == NULL) {
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < 65530; i++) {
+      many[i].type = SDL_USEREVENT;
+      many[i].user.code = i;
+   }
+   result = SDL_PushEvents(many, 65530);
+   SDL_free(many);
+   SDLTest_AssertPass("Call to SDL_PushEvents()");
+   SDLTest_AssertCheck(result == 65530, "Check result from SDL_PushEvents, expected: 65530, got: %d", result);
+
+   /* A batch that overflows the queue reports the events that got in */
+   result = SDL_PushEvents(events, SDL_arraysize(events));
+   SDLTest_AssertPass("Call to SDL_PushEvents()");
+   SDLTest_AssertCheck(result == 5, "Check result from SDL_PushEvents on a nearly full queue, expected: 5, got: %d", result);
+   result = SDL_PushEvents(events, SDL_arraysize(events));
+   SDLTest_AssertPass("Call to SDL_PushEvents()");
+   SDLTest_AssertCheck(result == -1, "Check result from SDL_PushEvents on a full queue, expected: -1, got: %d", result);
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_USEREVENT, SDL_USEREVENT);
+   SDLTest_AssertCheck(result == 65535, "Check the queued event count, expected: 65535, got: %d", result);
+
+   /* The events that didn't fit were handed back, not dropped */
+   SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertCheck(stats.dropped == SDL_arraysize(events) / 2, "Check dropped, expected: %d, got: %u", (int)SDL_arraysize(events) / 2, (unsigned int) stats.dropped);
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Checks that consecutive mouse motion is merged when SDL_HINT_EVENT_COALESCING is set
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HINT_EVENT_COALESCING
+ */
+int
+events_coalesceMouseMotion(void *arg)
+{
+   SDL_Event events[5];
+   SDL_Event event;
+   int result;
+   int i;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* Three motion events, a key press and another motion event */
+   for (i = 0; i < SDL_arraysize(events); i++) {
+      SDL_zero(events[i]);
+      events[i].type = SDL_MOUSEMOTION;
+      events[i].motion.x = 10 + i;
+      events[i].motion.y = 20 + i;
+      events[i].motion.xrel = 1;
+      events[i].motion.yrel = 2;
+   }
+   events[3].type = SDL_KEYDOWN;
+
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "1");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCING, \"1\")");
+   for (i = 0; i < SDL_arraysize(events); i++) {
+      SDL_PushEvent(&events[i]);
+   }
+
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 3, "Check number of queued events, expected: 3, got: %d", result);
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 1 && event.type == SDL_MOUSEMOTION, "Check first event is SDL_MOUSEMOTION");
+   SDLTest_AssertCheck(event.motion.x == 12 && event.motion.y == 22, "Check position, expected: 12,22, got: %d,%d", event.motion.x, event.motion.y);
+   SDLTest_AssertCheck(event.motion.xrel == 3 && event.motion.yrel == 6, "Check relative motion, expected: 3,6, got: %d,%d", event.motion.xrel, event.motion.yrel);
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 1 && event.type == SDL_KEYDOWN, "Check second event is SDL_KEYDOWN");
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 1 && event.type == SDL_MOUSEMOTION, "Check third event is SDL_MOUSEMOTION");
+   SDLTest_AssertCheck(event.motion.xrel == 1 && event.motion.yrel == 2, "Check relative motion, expected: 1,2, got: %d,%d", event.motion.xrel, event.motion.yrel);
+
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "0");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCING, \"0\")");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Checks the event queue statistics as events are pushed and polled
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetEventQueueStats
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetEventPushCount
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_ResetEventQueueStats
+ */
+int
+events_queueStats(void *arg)
+{
+   SDL_EventQueueStats stats;
+   SDL_Event event;
+   Uint32 removed;
+   Uint32 count;
+   int result;
+   int i;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+   SDL_ResetEventQueueStats();
+   SDLTest_AssertPass("Call to SDL_ResetEventQueueStats()");
+
+   /* Three user events and two key presses */
+   for (i = 0; i < 5; i++) {
+      SDL_zero(event);
+      event.type = (i < 3) ? SDL_USEREVENT : SDL_KEYDOWN;
+      SDL_PushEvent(&event);
+   }
+
+   result = SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertPass("Call to SDL_GetEventQueueStats()");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_GetEventQueueStats, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(stats.depth == 5, "Check depth, expected: 5, got: %d", stats.depth);
+   SDLTest_AssertCheck(stats.peak_depth == 5, "Check peak depth, expected: 5, got: %d", stats.peak_depth);
+   SDLTest_AssertCheck(stats.pushed == 5, "Check pushed, expected: 5, got: %u", (unsigned int) stats.pushed);
+   SDLTest_AssertCheck(stats.dropped == 0, "Check dropped, expected: 0, got: %u", (unsigned int) stats.dropped);
+
+   count = SDL_GetEventPushCount(SDL_KEYDOWN);
+   SDLTest_AssertCheck(count == 2, "Check SDL_KEYDOWN push count, expected: 2, got: %u", (unsigned int) count);
+   count = SDL_GetEventPushCount(SDL_USEREVENT);
+   SDLTest_AssertCheck(count == 3, "Check SDL_USEREVENT push count, expected: 3, got: %u", (unsigned int) count);
+   count = SDL_GetEventPushCount(SDL_KEYUP);
+   SDLTest_AssertCheck(count == 0, "Check SDL_KEYUP push count, expected: 0, got: %u", (unsigned int) count);
+
+   /* Every event removed from the queue lands in the latency histogram */
+   while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) > 0) {
+      continue;
+   }
+   result = SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_GetEventQueueStats, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(stats.depth == 0, "Check depth, expected: 0, got: %d", stats.depth);
+   SDLTest_AssertCheck(stats.peak_depth == 5, "Check peak depth, expected: 5, got: %d", stats.peak_depth);
+   removed = 0;
+   for (i = 0; i < SDL_EVENT_LATENCY_BUCKETS; i++) {
+      removed += stats.latency[i];
+   }
+   SDLTest_AssertCheck(removed == 5, "Check latency histogram total, expected: 5, got: %u", (unsigned int) removed);
+
+   SDL_ResetEventQueueStats();
+   result = SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertCheck(stats.pushed == 0 && stats.peak_depth == 0, "Check statistics were reset");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Pushes events one at a time past the queue limit and checks that it holds
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ */
+int
+events_queueLimit(void *arg)
+{
+   SDL_Event event;
+   int result;
+   int pushed = 0;
+   int i;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* Events staged ahead of the queue count against its limit of 65535 */
+   for (i = 0; i < 65535 + 2048; i++) {
+      SDL_zero(event);
+      event.type = SDL_USEREVENT;
+      event.user.code = i;
+      if (SDL_PushEvent(&event) == 1) {
+         pushed++;
+      }
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent() %d times", i);
+   SDLTest_AssertCheck(pushed == 65535, "Check number of events pushed, expected: 65535, got: %d", pushed);
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_USEREVENT, SDL_USEREVENT);
+   SDLTest_AssertCheck(result == 65535, "Check the queued event count, expected: 65535, got: %d", result);
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -187,9 +440,21 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_pushEvents, "events_pushEvents", "Pushes a batch of events with and without a filter", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest5 =
+        { (SDLTest_TestCaseFp)events_coalesceMouseMotion, "events_coalesceMouseMotion", "Merges consecutive mouse motion with SDL_HINT_EVENT_COALESCING", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest6 =
+        { (SDLTest_TestCaseFp)events_queueStats, "events_queueStats", "Checks the event queue statistics", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest7 =
+        { (SDLTest_TestCaseFp)events_queueLimit, "events_queueLimit", "Pushes events one at a time past the queue limit", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, &eventsTest7, NULL
 };
 
 /* Events test suite (global) */
@@ -588,6 +588,510 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/* Scalar versions of the blended blits that SDL_blit_A.c has SIMD versions of */
+static Uint32
+_blendPixelAlpha8888(Uint32 s, Uint32 d)
+{
+    Uint32 alpha = s >> 24;
+    Uint32 s1, d1, dalpha;
+    if (alpha == 0) {
+        return d;
+    }
+    if (alpha == SDL_ALPHA_OPAQUE) {
+        return s;
+    }
+    dalpha = d >> 24;
+    s1 = s & 0xff00ff;
+    d1 = d & 0xff00ff;
+    d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+    s &= 0xff00;
+    d &= 0xff00;
+    d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+    dalpha = alpha + (dalpha * (alpha ^ 0xFF) >> 8);
+    return d1 | d | (dalpha << 24);
+}
+
+static Uint32
+_blendSurfaceAlpha888(Uint32 s, Uint32 d, Uint32 alpha)
+{
+    Uint32 s1, d1;
+    if (alpha == 128) {
+        return ((((s & 0x00fefefe) + (d & 0x00fefefe)) >> 1) + (s & d & 0x00010101)) | 0xff000000;
+    }
+    s1 = s & 0xff00ff;
+    d1 = d & 0xff00ff;
+    d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+    s &= 0xff00;
+    d &= 0xff00;
+    d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+    return d1 | d | 0xff000000;
+}
+
+static Uint16
+_blendSurfaceAlpha16(Uint32 s, Uint32 d, Uint32 alpha, Uint32 mask128, Uint32 mask)
+{
+    if (alpha == 128) {
+        return (Uint16)((((s & mask128) + (d & mask128)) >> 1) + (s & d & (~mask128 & 0xffff)));
+    }
+    alpha >>= 3;
+    s = (s | s << 16) & mask;
+    d = (d | d << 16) & mask;
+    d += (s - d) * alpha >> 5;
+    d &= mask;
+    return (Uint16)(d | d >> 16);
+}
+
+/**
+ * @brief Tests that the pixel and surface alpha blits match the scalar blitters, including odd widths.
+ */
+int
+surface_testBlitAlphaExact(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888,
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB555
+    };
+    const int widths[] = { 1, 3, 7, 8, 17, 33, 64 };
+    const Uint8 alphas[] = { 1, 100, 128, 254 };
+    int f, w, a, x, y;
+    int mismatches;
+
+    if (SDL_HasMMX() && !SDL_HasSSE41()) {
+        /* The MMX blitters round differently and would be used here */
+        SDLTest_Log("Skipping, the MMX blitters don't match the scalar ones");
+        return TEST_SKIPPED;
+    }
+
+    for (f = 0; f < SDL_arraysize(formats); ++f) {
+        const Uint32 format = formats[f];
+        const SDL_bool pixelalpha = SDL_ISPIXELFORMAT_ALPHA(format);
+        for (w = 0; w < SDL_arraysize(widths); ++w) {
+            for (a = 0; a < (pixelalpha ? 1 : SDL_arraysize(alphas)); ++a) {
+                SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, format);
+                SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, format);
+                SDL_Surface *orig = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, format);
+                const Uint8 alpha = alphas[a];
+                int ret;
+
+                SDLTest_AssertCheck(src != NULL && dst != NULL && orig != NULL, "Verify surfaces are not NULL");
+                if (src == NULL || dst == NULL || orig == NULL) {
+                    SDL_FreeSurface(src);
+                    SDL_FreeSurface(dst);
+                    SDL_FreeSurface(orig);
+                    return TEST_ABORTED;
+                }
+
+                for (y = 0; y < src->h * src->pitch; y += 4) {
+                    Uint32 s = SDLTest_RandomUint32();
+                    Uint32 d = SDLTest_RandomUint32();
+                    if (pixelalpha) {
+                        /* make sure transparent and opaque pixels get tested */
+                        switch (s % 4) {
+                        case 0: s &= 0x00ffffff; break;
+                        case 1: s |= 0xff000000; break;
+                        default: break;
+                        }
+                    }
+                    SDL_memcpy((Uint8 *) src->pixels + y, &s, 4);
+                    SDL_memcpy((Uint8 *) dst->pixels + y, &d, 4);
+                }
+                SDL_memcpy(orig->pixels, dst->pixels, dst->h * dst->pitch);
+
+                SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+                if (!pixelalpha) {
+                    SDL_SetSurfaceAlphaMod(src, alpha);
+                }
+                ret = SDL_BlitSurface(src, NULL, dst, NULL);
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+                mismatches = 0;
+                for (y = 0; y < src->h; ++y) {
+                    for (x = 0; x < src->w; ++x) {
+                        const int bpp = src->format->BytesPerPixel;
+                        const Uint8 *sp = (const Uint8 *) src->pixels + y * src->pitch + x * bpp;
+                        const Uint8 *op = (const Uint8 *) orig->pixels + y * orig->pitch + x * bpp;
+                        const Uint8 *dp = (const Uint8 *) dst->pixels + y * dst->pitch + x * bpp;
+                        if (bpp == 4) {
+                            const Uint32 s = *(const Uint32 *) sp;
+                            const Uint32 d = *(const Uint32 *) op;
+                            const Uint32 expected = pixelalpha ? _blendPixelAlpha8888(s, d) : _blendSurfaceAlpha888(s, d, alpha);
+                            if (*(const Uint32 *) dp != expected) {
+                                ++mismatches;
+                            }
+                        } else {
+                            const Uint32 s = *(const Uint16 *) sp;
+                            const Uint32 d = *(const Uint16 *) op;
+                            const Uint16 expected = (format == SDL_PIXELFORMAT_RGB565) ?
+                                _blendSurfaceAlpha16(s, d, alpha, 0xf7de, 0x07e0f81f) :
+                                _blendSurfaceAlpha16(s, d, alpha, 0xfbde, 0x03e07c1f);
+                            if (*(const Uint16 *) dp != expected) {
+                                ++mismatches;
+                            }
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Verify %s blit of width %d (alpha %d), expected: 0 mismatches, got: %i",
+                                    SDL_GetPixelFormatName(format), widths[w], pixelalpha ? -1 : alpha, mismatches);
+
+                SDL_FreeSurface(src);
+                SDL_FreeSurface(dst);
+                SDL_FreeSurface(orig);
+            }
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/* One channel of the fixed point bilinear filter SDL_SoftStretchLinear() uses */
+static Uint8
+_stretchLinearChannel(const SDL_Surface *src, int dstx, int dsty, int dstw, int dsth, int channel)
+{
+    int pos[2], size[2], dstpos[2], dstsize[2], index[2], frac[2];
+    int i, x1, y1, v0, v1;
+    const Uint8 *p;
+
+    size[0] = src->w; size[1] = src->h;
+    dstpos[0] = dstx; dstpos[1] = dsty;
+    dstsize[0] = dstw; dstsize[1] = dsth;
+    for (i = 0; i < 2; ++i) {
+        const int inc = (size[i] << 16) / dstsize[i];
+        pos[i] = inc / 2 - 0x8000 + dstpos[i] * inc;
+        index[i] = pos[i] <= 0 ? 0 : pos[i] >> 16;
+        frac[i] = pos[i] <= 0 ? 0 : (pos[i] >> 9) & 127;
+        if (index[i] >= size[i] - 1) {
+            index[i] = size[i] - 1;
+            frac[i] = 0;
+        }
+    }
+    x1 = SDL_min(index[0] + 1, src->w - 1);
+    y1 = SDL_min(index[1] + 1, src->h - 1);
+    p = (const Uint8 *) src->pixels + channel;
+    v0 = p[index[1] * src->pitch + index[0] * 4] * (128 - frac[1]) + p[y1 * src->pitch + index[0] * 4] * frac[1];
+    v1 = p[index[1] * src->pitch + x1 * 4] * (128 - frac[1]) + p[y1 * src->pitch + x1 * 4] * frac[1];
+    return (Uint8) ((v0 * (128 - frac[0]) + v1 * frac[0] + 8192) >> 14);
+}
+
+/**
+ * @brief Tests SDL_SoftStretchLinear() against a reference filter
+ */
+int
+surface_testSoftStretchLinear(void *arg)
+{
+    const int sizes[][4] = {
+        { 37, 5, 37, 5 }, { 2, 1, 4, 1 }, { 13, 7, 41, 23 }, { 64, 48, 17, 9 },
+        { 1, 1, 5, 3 }, { 3, 1, 1, 6 }, { 100, 3, 299, 4 }
+    };
+    int i, x, y, c, ret, mismatches;
+    SDL_Surface *src, *dst;
+
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        src = SDL_CreateRGBSurfaceWithFormat(0, sizes[i][0], sizes[i][1], 0, SDL_PIXELFORMAT_ARGB8888);
+        dst = SDL_CreateRGBSurfaceWithFormat(0, sizes[i][2], sizes[i][3], 0, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+        if (src == NULL || dst == NULL) {
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+            return TEST_ABORTED;
+        }
+        for (y = 0; y < src->h; ++y) {
+            for (x = 0; x < src->pitch; ++x) {
+                ((Uint8 *) src->pixels)[y * src->pitch + x] = (Uint8) SDLTest_RandomUint8();
+            }
+        }
+        if (i == 1) {
+            /* A black and white pair gives a known ramp */
+            ((Uint32 *) src->pixels)[0] = 0x00000000;
+            ((Uint32 *) src->pixels)[1] = 0xffffffff;
+        }
+
+        ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+
+        mismatches = 0;
+        for (y = 0; y < dst->h; ++y) {
+            for (x = 0; x < dst->w; ++x) {
+                for (c = 0; c < 4; ++c) {
+                    const Uint8 actual = ((const Uint8 *) dst->pixels)[y * dst->pitch + x * 4 + c];
+                    if (actual != _stretchLinearChannel(src, x, y, dst->w, dst->h, c)) {
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify %dx%d -> %dx%d, expected: 0 mismatches, got: %i",
+                            sizes[i][0], sizes[i][1], sizes[i][2], sizes[i][3], mismatches);
+        if (i == 0) {
+            SDLTest_AssertCheck(SDL_memcmp(src->pixels, dst->pixels, src->h * src->pitch) == 0,
+                                "Verify an unscaled stretch copies the pixels");
+        } else if (i == 1) {
+            const Uint32 *p = (const Uint32 *) dst->pixels;
+            SDLTest_AssertCheck(p[0] == 0x00000000 && p[1] == 0x40404040 && p[2] == 0xbfbfbfbf && p[3] == 0xffffffff,
+                                "Verify ramp, expected: 00000000 40404040 bfbfbfbf ffffffff, got: %08x %08x %08x %08x",
+                                p[0], p[1], p[2], p[3]);
+        }
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+    }
+
+    /* Formats it can't filter */
+    src = SDL_CreateRGBSurfaceWithFormat(0, 4, 4, 0, SDL_PIXELFORMAT_RGB565);
+    dst = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 0, SDL_PIXELFORMAT_RGB565);
+    ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == -1, "Verify RGB565 is rejected, expected: -1, got: %i", ret);
+    SDL_FreeSurface(dst);
+    dst = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 0, SDL_PIXELFORMAT_ARGB8888);
+    ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == -1, "Verify mismatched formats are rejected, expected: -1, got: %i", ret);
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+
+    return TEST_COMPLETED;
+}
+
+/* One pixel of the generated scalar blitters in SDL_blit_auto.c, for 8888
+   formats: modulate the color and alpha, then copy, blend, add or mod into
+   the destination. */
+static Uint32
+_autoBlitPixel(const SDL_PixelFormat *sfmt, Uint32 s, const SDL_PixelFormat *dfmt, Uint32 d,
+               SDL_BlendMode mode, Uint8 modR, Uint8 modG, Uint8 modB, Uint8 modA)
+{
+    Uint32 srcR = (Uint8) (s >> sfmt->Rshift), srcG = (Uint8) (s >> sfmt->Gshift), srcB = (Uint8) (s >> sfmt->Bshift);
+    Uint32 srcA = sfmt->Amask ? (Uint8) (s >> sfmt->Ashift) : 0xFF;
+    Uint32 dstR = (Uint8) (d >> dfmt->Rshift), dstG = (Uint8) (d >> dfmt->Gshift), dstB = (Uint8) (d >> dfmt->Bshift);
+    Uint32 dstA = dfmt->Amask ? (Uint8) (d >> dfmt->Ashift) : 0xFF;
+
+    srcR = (srcR * modR) / 255;
+    srcG = (srcG * modG) / 255;
+    srcB = (srcB * modB) / 255;
+    srcA = (srcA * modA) / 255;
+    if ((mode == SDL_BLENDMODE_BLEND || mode == SDL_BLENDMODE_ADD) && srcA < 255) {
+        srcR = (srcR * srcA) / 255;
+        srcG = (srcG * srcA) / 255;
+        srcB = (srcB * srcA) / 255;
+    }
+    switch (mode) {
+    case SDL_BLENDMODE_BLEND:
+        dstR = srcR + ((255 - srcA) * dstR) / 255;
+        dstG = srcG + ((255 - srcA) * dstG) / 255;
+        dstB = srcB + ((255 - srcA) * dstB) / 255;
+        dstA = srcA + ((255 - srcA) * dstA) / 255;
+        break;
+    case SDL_BLENDMODE_ADD:
+        dstR = SDL_min(srcR + dstR, 255);
+        dstG = SDL_min(srcG + dstG, 255);
+        dstB = SDL_min(srcB + dstB, 255);
+        break;
+    case SDL_BLENDMODE_MOD:
+        dstR = (srcR * dstR) / 255;
+        dstG = (srcG * dstG) / 255;
+        dstB = (srcB * dstB) / 255;
+        break;
+    default:
+        dstR = srcR;
+        dstG = srcG;
+        dstB = srcB;
+        dstA = srcA;
+        break;
+    }
+    return (dstR << dfmt->Rshift) | (dstG << dfmt->Gshift) | (dstB << dfmt->Bshift) |
+           (dfmt->Amask ? (dstA << dfmt->Ashift) : 0);
+}
+
+/**
+ * @brief Tests that the generated blitters match their scalar versions when modulating and blending, scaled or not.
+ *
+ * On x86 and ARM this runs the SSE2, AVX2 or NEON variants of the generated
+ * blitters; set SDL_BLIT_CPU_FEATURES to 8 (SSE2), 64 (AVX2), 128 (NEON)
+ * or 0 (scalar) to pick which.
+ */
+int
+surface_testBlitAutoExact(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888
+    };
+    const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD
+    };
+    /* None of these are a whole number of 4 or 8 pixel vectors */
+    const int widths[] = { 1, 3, 7, 9, 17, 35 };
+    int s, d, m, w, scaled, x, y;
+    int mismatches;
+
+    for (s = 0; s < SDL_arraysize(formats); ++s) {
+        for (d = 0; d < SDL_arraysize(formats); ++d) {
+            for (m = 0; m < SDL_arraysize(modes); ++m) {
+                mismatches = 0;
+                for (w = 0; w < SDL_arraysize(widths); ++w) {
+                    for (scaled = 0; scaled < 2; ++scaled) {
+                        const int dst_w = scaled ? widths[w] * 3 / 2 + 1 : widths[w];
+                        const int dst_h = scaled ? 5 : 3;
+                        SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, formats[s]);
+                        SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, dst_w, dst_h, 0, formats[d]);
+                        SDL_Surface *orig = SDL_CreateRGBSurfaceWithFormat(0, dst_w, dst_h, 0, formats[d]);
+                        /* Keep one color channel below 255, so the generated blitters are used */
+                        const Uint8 modR = SDLTest_RandomIntegerInRange(0, 254);
+                        const Uint8 modG = SDLTest_RandomUint8(), modB = SDLTest_RandomUint8(), modA = SDLTest_RandomUint8();
+                        int ret;
+
+                        SDLTest_AssertCheck(src != NULL && dst != NULL && orig != NULL, "Verify surfaces are not NULL");
+                        if (src == NULL || dst == NULL || orig == NULL) {
+                            SDL_FreeSurface(src);
+                            SDL_FreeSurface(dst);
+                            SDL_FreeSurface(orig);
+                            return TEST_ABORTED;
+                        }
+
+                        for (y = 0; y < src->h * src->pitch; y += 4) {
+                            Uint32 p = SDLTest_RandomUint32();
+                            /* make sure transparent and opaque pixels get tested */
+                            switch (p % 4) {
+                            case 0: p &= ~src->format->Amask; break;
+                            case 1: p |= src->format->Amask; break;
+                            default: break;
+                            }
+                            SDL_memcpy((Uint8 *) src->pixels + y, &p, 4);
+                        }
+                        for (y = 0; y < dst->h * dst->pitch; y += 4) {
+                            Uint32 p = SDLTest_RandomUint32();
+                            SDL_memcpy((Uint8 *) dst->pixels + y, &p, 4);
+                        }
+                        SDL_memcpy(orig->pixels, dst->pixels, dst->h * dst->pitch);
+
+                        SDL_SetSurfaceBlendMode(src, modes[m]);
+                        SDL_SetSurfaceColorMod(src, modR, modG, modB);
+                        SDL_SetSurfaceAlphaMod(src, modA);
+                        if (scaled) {
+                            ret = SDL_BlitScaled(src, NULL, dst, NULL);
+                        } else {
+                            ret = SDL_BlitSurface(src, NULL, dst, NULL);
+                        }
+                        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+                        {
+                            /* nearest neighbour stepping of the generated _Scale blitters */
+                            const int incx = (src->w << 16) / dst->w;
+                            const int incy = (src->h << 16) / dst->h;
+                            int srcx, srcy = 0, posx, posy = 0;
+                            for (y = 0; y < dst->h; ++y) {
+                                while (posy >= 0x10000) {
+                                    ++srcy;
+                                    posy -= 0x10000;
+                                }
+                                srcx = -1;
+                                posx = 0x10000;
+                                for (x = 0; x < dst->w; ++x) {
+                                    Uint32 sp, op, dp;
+                                    while (posx >= 0x10000) {
+                                        ++srcx;
+                                        posx -= 0x10000;
+                                    }
+                                    sp = *(const Uint32 *) ((const Uint8 *) src->pixels + srcy * src->pitch + srcx * 4);
+                                    op = *(const Uint32 *) ((const Uint8 *) orig->pixels + y * orig->pitch + x * 4);
+                                    dp = *(const Uint32 *) ((const Uint8 *) dst->pixels + y * dst->pitch + x * 4);
+                                    if (dp != _autoBlitPixel(src->format, sp, dst->format, op, modes[m], modR, modG, modB, modA)) {
+                                        ++mismatches;
+                                    }
+                                    posx += incx;
+                                }
+                                posy += incy;
+                            }
+                        }
+
+                        SDL_FreeSurface(src);
+                        SDL_FreeSurface(dst);
+                        SDL_FreeSurface(orig);
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Verify %s -> %s blits with blend mode %d, expected: 0 mismatches, got: %i",
+                                    SDL_GetPixelFormatName(formats[s]), SDL_GetPixelFormatName(formats[d]), modes[m], mismatches);
+            }
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that the SIMD format conversion blits match the C ones, including odd widths.
+ *
+ * The reference blit is made with SDL_BLIT_N_FEATURES set to 0, which keeps
+ * SDL_blit_N.c to its C blitters.
+ */
+int
+surface_testBlitConvertExact(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24
+    };
+    /* None of these are a whole number of 4, 8 or 16 pixel vectors */
+    const int widths[] = { 1, 3, 7, 9, 15, 17, 33, 67 };
+    const char *override = SDL_getenv("SDL_BLIT_N_FEATURES");
+    char *saved = override ? SDL_strdup(override) : NULL;
+    int s, d, w, y;
+    int mismatches;
+
+    for (s = 0; s < SDL_arraysize(formats); ++s) {
+        for (d = 0; d < SDL_arraysize(formats); ++d) {
+            if (s == d) {
+                continue;
+            }
+            mismatches = 0;
+            for (w = 0; w < SDL_arraysize(widths); ++w) {
+                SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, formats[s]);
+                SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, formats[d]);
+                SDL_Surface *expected = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, formats[d]);
+                int ret;
+
+                SDLTest_AssertCheck(src != NULL && dst != NULL && expected != NULL, "Verify surfaces are not NULL");
+                if (src == NULL || dst == NULL || expected == NULL) {
+                    SDL_FreeSurface(src);
+                    SDL_FreeSurface(dst);
+                    SDL_FreeSurface(expected);
+                    SDL_free(saved);
+                    return TEST_ABORTED;
+                }
+
+                for (y = 0; y < src->h * src->pitch; ++y) {
+                    ((Uint8 *) src->pixels)[y] = SDLTest_RandomUint8();
+                }
+                SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+                SDL_setenv("SDL_BLIT_N_FEATURES", "0", 1);
+                ret = SDL_BlitSurface(src, NULL, expected, NULL);
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface with the C blitters, expected: 0, got: %i", ret);
+                SDL_setenv("SDL_BLIT_N_FEATURES", saved ? saved : "", 1);
+                ret = SDL_BlitSurface(src, NULL, dst, NULL);
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+                for (y = 0; y < dst->h; ++y) {
+                    if (SDL_memcmp((Uint8 *) dst->pixels + y * dst->pitch,
+                                   (Uint8 *) expected->pixels + y * expected->pitch,
+                                   dst->w * dst->format->BytesPerPixel) != 0) {
+                        ++mismatches;
+                    }
+                }
+
+                SDL_FreeSurface(src);
+                SDL_FreeSurface(dst);
+                SDL_FreeSurface(expected);
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Verify %s -> %s blits, expected: 0 mismatched rows, got: %i",
+                                SDL_GetPixelFormatName(formats[s]), SDL_GetPixelFormatName(formats[d]), mismatches);
+        }
+    }
+
+    SDL_free(saved);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -630,11 +1134,24 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testBlitAlphaExact, "surface_testBlitAlphaExact", "Tests that the alpha blitters match the scalar ones.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testSoftStretchLinear, "surface_testSoftStretchLinear", "Tests linear filtered stretching against a reference.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testBlitAutoExact, "surface_testBlitAutoExact", "Tests that the generated blitters match the scalar ones.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest16 =
+        { (SDLTest_TestCaseFp)surface_testBlitConvertExact, "surface_testBlitConvertExact", "Tests that the SIMD conversion blitters match the C ones.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15,
+    &surfaceTest16, NULL
 };
 
 /* Surface test suite (global) */
@@ -172,6 +172,122 @@ timer_addRemoveTimer(void *arg)
   return TEST_COMPLETED;
 }
 
+/* Counting callback, param points to a per-timer counter */
+Uint32 _timerCountingCallback(Uint32 interval, void *param)
+{
+   SDL_AtomicIncRef((SDL_atomic_t *)param);
+   return 0;
+}
+
+/**
+ * @brief Add many timers with different delays and remove some of them before they trigger
+ */
+int
+timer_addRemoveManyTimers(void *arg)
+{
+  static SDL_atomic_t counts[1000];
+  SDL_TimerID ids[SDL_arraysize(counts)];
+  int i, removed = 0, calledRemoved = 0, calledKept = 0, calledTwice = 0;
+
+  SDL_zero(counts);
+
+  /* Delays between 10 and 200 ms, added out of order */
+  for (i = 0; i < SDL_arraysize(ids); ++i) {
+    ids[i] = SDL_AddTimer(10 + (i * 37) % 190, _timerCountingCallback, &counts[i]);
+    if (ids[i] == 0) {
+      break;
+    }
+  }
+  SDLTest_AssertPass("Call to SDL_AddTimer() %d times", (int)SDL_arraysize(ids));
+  SDLTest_AssertCheck(i == SDL_arraysize(ids), "Check all timers were added, expected: %d, got: %d", (int)SDL_arraysize(ids), i);
+
+  /* Remove every other timer that hasn't triggered yet */
+  for (i = 0; i < SDL_arraysize(ids); i += 2) {
+    if (SDL_RemoveTimer(ids[i])) {
+      ids[i] = 0;
+      ++removed;
+    }
+  }
+  SDLTest_AssertPass("Call to SDL_RemoveTimer() %d times", (int)SDL_arraysize(ids) / 2);
+  SDLTest_AssertCheck(removed > 0, "Check some timers were removed, got: %d", removed);
+
+  /* Wait to let the remaining timers trigger */
+  SDL_Delay(500);
+  SDLTest_AssertPass("Call to SDL_Delay(500)");
+
+  for (i = 0; i < SDL_arraysize(ids); ++i) {
+    const int count = SDL_AtomicGet(&counts[i]);
+    if (count > 1) {
+      ++calledTwice;
+    } else if (ids[i] == 0) {
+      calledRemoved += count;
+    } else {
+      calledKept += count;
+    }
+  }
+  SDLTest_AssertCheck(calledRemoved == 0, "Check removed timers WERE NOT called, expected: 0, got: %d", calledRemoved);
+  SDLTest_AssertCheck(calledKept == (int)SDL_arraysize(ids) - removed, "Check remaining timers WERE called, expected: %d, got: %d", (int)SDL_arraysize(ids) - removed, calledKept);
+  SDLTest_AssertCheck(calledTwice == 0, "Check no timer was called twice, expected: 0, got: %d", calledTwice);
+
+  return TEST_COMPLETED;
+}
+
+/* Nanosecond test callback, counts calls and stops after the count in param */
+Uint64 _timerNSTestCallback(Uint64 interval, void *param)
+{
+   _timerCallbackCalled++;
+   return (_timerCallbackCalled < *(int *)param) ? interval : 0;
+}
+
+/**
+ * @brief Call to SDL_AddTimerNS and SDL_GetTimerStats
+ */
+int
+timer_addTimerNS(void *arg)
+{
+  SDL_TimerID id;
+  SDL_TimerStats stats;
+  SDL_bool result;
+  int ret;
+  int calls = 10;
+
+  /* Reset state */
+  _timerCallbackCalled = 0;
+
+  /* Invalid parameters */
+  id = SDL_AddTimerNS(1000000, NULL, NULL);
+  SDLTest_AssertPass("Call to SDL_AddTimerNS(1000000, NULL, NULL)");
+  SDLTest_AssertCheck(id == 0, "Check result value, expected: 0, got: %d", id);
+  ret = SDL_GetTimerStats(0, &stats);
+  SDLTest_AssertPass("Call to SDL_GetTimerStats(0, ...)");
+  SDLTest_AssertCheck(ret == -1, "Check result value, expected: -1, got: %d", ret);
+
+  /* A 1 ms timer that stops itself after a few calls */
+  id = SDL_AddTimerNS(1000000, _timerNSTestCallback, &calls);
+  SDLTest_AssertPass("Call to SDL_AddTimerNS(1000000, ...)");
+  SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+
+  /* Wait to let the timer trigger */
+  SDL_Delay(200);
+  SDLTest_AssertPass("Call to SDL_Delay(200)");
+  SDLTest_AssertCheck(_timerCallbackCalled == calls, "Check callback was called, expected: %i, got: %i", calls, _timerCallbackCalled);
+
+  ret = SDL_GetTimerStats(id, &stats);
+  SDLTest_AssertPass("Call to SDL_GetTimerStats()");
+  SDLTest_AssertCheck(ret == 0, "Check result value, expected: 0, got: %d", ret);
+  SDLTest_AssertCheck(stats.fired == (Uint32)calls, "Check fired count, expected: %i, got: %u", calls, stats.fired);
+  SDLTest_AssertCheck(stats.min_lateness <= stats.avg_lateness && stats.avg_lateness <= stats.max_lateness,
+                      "Check lateness is ordered, got: %"SDL_PRIu64" <= %"SDL_PRIu64" <= %"SDL_PRIu64,
+                      stats.min_lateness, stats.avg_lateness, stats.max_lateness);
+
+  /* The timer has finished, so removing it fails */
+  result = SDL_RemoveTimer(id);
+  SDLTest_AssertPass("Call to SDL_RemoveTimer()");
+  SDLTest_AssertCheck(result == SDL_FALSE, "Check result value, expected: %i, got: %i", SDL_FALSE, result);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -187,9 +303,15 @@ static const SDLTest_TestCaseReference timerTest3 =
 static const SDLTest_TestCaseReference timerTest4 =
         { (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference timerTest5 =
+        { (SDLTest_TestCaseFp)timer_addRemoveManyTimers, "timer_addRemoveManyTimers", "Add many timers and remove some of them", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference timerTest6 =
+        { (SDLTest_TestCaseFp)timer_addTimerNS, "timer_addTimerNS", "Call to SDL_AddTimerNS and SDL_GetTimerStats", TEST_ENABLED };
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] =  {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, NULL
 };
 
 /* Timer test suite (global) */
@@ -0,0 +1,273 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Event queue benchmarks:
+   - push events from several threads while the main thread drains the
+     queue, and report the throughput.
+   - fill the queue with mouse motion and look for, pull out and flush
+     other event types, the way a backed up game loop would.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define MAX_WRITERS     64
+#define DRAIN_BATCH     128
+
+typedef struct
+{
+    int index;
+    int events;
+    int waits;
+    char padding[SDL_CACHELINE_SIZE-3*sizeof(int)];
+} WriterData;
+
+static SDL_atomic_t writersReady;
+static SDL_atomic_t startWriting;
+
+static int SDLCALL
+Writer(void *_data)
+{
+    WriterData *data = (WriterData *)_data;
+    SDL_Event event;
+    int i;
+
+    SDL_zero(event);
+    event.type = SDL_USEREVENT;
+    event.user.data1 = data;
+
+    SDL_AtomicIncRef(&writersReady);
+    while (!SDL_AtomicGet(&startWriting)) {
+        SDL_Delay(0);
+    }
+
+    for (i = 0; i < data->events; ++i) {
+        event.user.code = i;
+        while (SDL_PushEvent(&event) < 0) {
+            /* The queue is full, give the reader a chance to catch up */
+            ++data->waits;
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+
+static SDL_bool
+RunContentionTest(int num_writers, int events_per_writer)
+{
+    static SDL_Event events[DRAIN_BATCH];
+    WriterData writerData[MAX_WRITERS];
+    SDL_Thread *threads[MAX_WRITERS];
+    int expected[MAX_WRITERS];
+    const int total = num_writers * events_per_writer;
+    int received = 0;
+    int waits = 0;
+    int i, n;
+    Uint64 start, end;
+    double seconds;
+    SDL_bool ordered = SDL_TRUE;
+
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    SDL_AtomicSet(&writersReady, 0);
+    SDL_AtomicSet(&startWriting, 0);
+
+    SDL_zero(writerData);
+    SDL_zero(expected);
+    for (i = 0; i < num_writers; ++i) {
+        char name[64];
+        SDL_snprintf(name, sizeof (name), "EventWriter%d", i);
+        writerData[i].index = i;
+        writerData[i].events = events_per_writer;
+        threads[i] = SDL_CreateThread(Writer, name, &writerData[i]);
+    }
+    while (SDL_AtomicGet(&writersReady) < num_writers) {
+        SDL_Delay(0);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&startWriting, 1);
+
+    while (received < total) {
+        n = SDL_PeepEvents(events, DRAIN_BATCH, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+        if (n < 0) {
+            SDL_Log("SDL_PeepEvents() failed: %s\n", SDL_GetError());
+            break;
+        }
+        for (i = 0; i < n; ++i) {
+            const WriterData *writer = (const WriterData *)events[i].user.data1;
+            /* Events from a single thread must come out in the order they went in */
+            if (events[i].user.code != expected[writer->index]) {
+                ordered = SDL_FALSE;
+            }
+            expected[writer->index] = events[i].user.code + 1;
+        }
+        received += n;
+    }
+
+    end = SDL_GetPerformanceCounter();
+
+    for (i = 0; i < num_writers; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+        waits += writerData[i].waits;
+    }
+
+    seconds = (double)(end - start) / SDL_GetPerformanceFrequency();
+    SDL_Log("%2d writers: %d events in %.3f sec, %.0f events/sec, %d waits%s\n",
+            num_writers, received, seconds, received / seconds, waits,
+            ordered ? "" : " (OUT OF ORDER!)");
+
+    return (received == total && ordered);
+}
+
+static double
+ElapsedMicroseconds(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void
+FillDeepQueue(int depth)
+{
+    SDL_Event event;
+    int i;
+
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    /* Mostly mouse motion, with a key press every hundred events */
+    for (i = 0; i < depth; ++i) {
+        SDL_zero(event);
+        if ((i % 100) == 99) {
+            event.type = (i % 200) == 99 ? SDL_KEYDOWN : SDL_KEYUP;
+            event.key.keysym.sym = SDLK_SPACE;
+        } else {
+            event.type = SDL_MOUSEMOTION;
+            event.motion.x = i;
+            event.motion.xrel = 1;
+        }
+        SDL_PeepEvents(&event, 1, SDL_ADDEVENT, 0, 0);
+    }
+}
+
+static SDL_bool
+RunDeepQueueTest(int depth)
+{
+    static SDL_Event events[DRAIN_BATCH];
+    const int iterations = 1000;
+    SDL_bool success = SDL_TRUE;
+    Uint64 start;
+    double elapsed;
+    int i, n, keys;
+
+    FillDeepQueue(depth);
+    n = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    if (n != depth) {
+        SDL_Log("Queue has %d events, expected %d: %s\n", n, depth, SDL_GetError());
+        return SDL_FALSE;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        if (SDL_HasEvent(SDL_QUIT)) {
+            success = SDL_FALSE;
+        }
+    }
+    elapsed = ElapsedMicroseconds(start);
+    SDL_Log("%6d events: SDL_HasEvent(SDL_QUIT)             %9.2f usec/call\n", depth, elapsed / iterations);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        SDL_PeepEvents(events, DRAIN_BATCH, SDL_PEEKEVENT, SDL_KEYDOWN, SDL_KEYUP);
+    }
+    elapsed = ElapsedMicroseconds(start);
+    SDL_Log("%6d events: SDL_PeepEvents(PEEK, KEYDOWN..KEYUP) %9.2f usec/call\n", depth, elapsed / iterations);
+
+    start = SDL_GetPerformanceCounter();
+    keys = 0;
+    while ((n = SDL_PeepEvents(events, DRAIN_BATCH, SDL_GETEVENT, SDL_KEYDOWN, SDL_KEYUP)) > 0) {
+        keys += n;
+    }
+    elapsed = ElapsedMicroseconds(start);
+    SDL_Log("%6d events: SDL_PeepEvents(GET, KEYDOWN..KEYUP)  %9.2f usec total, %d keys\n", depth, elapsed, keys);
+    if (keys != depth / 100) {
+        success = SDL_FALSE;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    SDL_FlushEvent(SDL_MOUSEMOTION);
+    elapsed = ElapsedMicroseconds(start);
+    SDL_Log("%6d events: SDL_FlushEvent(SDL_MOUSEMOTION)      %9.2f usec total\n", depth, elapsed);
+
+    n = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    if (n != 0) {
+        SDL_Log("Queue has %d events left over after flushing\n", n);
+        success = SDL_FALSE;
+    }
+    return success;
+}
+
+int
+main(int argc, char *argv[])
+{
+    static const int default_writers[] = { 1, 2, 4, 8 };
+    static const int deep_queues[] = { 1000, 10000, 60000 };
+    int num_writers = 0;
+    int events_per_writer = 250000;
+    SDL_bool success = SDL_TRUE;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i+1]) {
+            num_writers = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--events") == 0 && argv[i+1]) {
+            events_per_writer = SDL_atoi(argv[++i]);
+        } else {
+            SDL_Log("Usage: %s [--threads N] [--events N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (num_writers > MAX_WRITERS || events_per_writer <= 0) {
+        SDL_Log("Invalid arguments\n");
+        return 1;
+    }
+
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Pushing %d events per writer, draining on the main thread\n", events_per_writer);
+    if (num_writers > 0) {
+        success = RunContentionTest(num_writers, events_per_writer);
+    } else {
+        for (i = 0; i < SDL_arraysize(default_writers); ++i) {
+            if (!RunContentionTest(default_writers[i], events_per_writer)) {
+                success = SDL_FALSE;
+            }
+        }
+    }
+
+    SDL_Log("Querying deep queues\n");
+    for (i = 0; i < SDL_arraysize(deep_queues); ++i) {
+        if (!RunDeepQueueTest(deep_queues[i])) {
+            success = SDL_FALSE;
+        }
+    }
+
+    SDL_Quit();
+    return success ? 0 : 1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
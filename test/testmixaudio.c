@@ -0,0 +1,140 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* SDL_MixAudioFormat() benchmark: mix a buffer of noise into another one
+   for each sample format, at full and at half volume, and report the
+   throughput. The S16, S32 and F32 formats use SIMD code where the CPU
+   supports it, the others are scalar and are here for comparison.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define BUFFER_SIZE (64 * 1024)
+
+static const struct
+{
+    SDL_AudioFormat format;
+    const char *name;
+} formats[] = {
+    { AUDIO_U8, "U8" },
+    { AUDIO_S8, "S8" },
+    { AUDIO_U16LSB, "U16LSB" },
+    { AUDIO_S16LSB, "S16LSB" },
+    { AUDIO_S16MSB, "S16MSB" },
+    { AUDIO_S32LSB, "S32LSB" },
+    { AUDIO_S32MSB, "S32MSB" },
+    { AUDIO_F32LSB, "F32LSB" },
+    { AUDIO_F32MSB, "F32MSB" },
+};
+
+static void
+FillBuffer(Uint8 *buf, SDL_AudioFormat format)
+{
+    int i;
+
+    if (SDL_AUDIO_ISFLOAT(format)) {
+        for (i = 0; i < BUFFER_SIZE; i += sizeof(float)) {
+            float sample = (float)(rand() - (RAND_MAX / 2)) / (float)RAND_MAX;
+            Uint32 bits;
+            SDL_memcpy(&bits, &sample, sizeof(bits));
+            if (SDL_AUDIO_ISBIGENDIAN(format)) {
+                bits = SDL_SwapBE32(bits);
+            } else {
+                bits = SDL_SwapLE32(bits);
+            }
+            SDL_memcpy(&buf[i], &bits, sizeof(bits));
+        }
+    } else {
+        for (i = 0; i < BUFFER_SIZE; ++i) {
+            buf[i] = (Uint8)rand();
+        }
+    }
+}
+
+static double
+MixThroughput(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, int volume, int iterations)
+{
+    Uint64 start, elapsed;
+    int i;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        SDL_MixAudioFormat(dst, src, format, BUFFER_SIZE, volume);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+
+    /* megabytes of source audio mixed per second */
+    return ((double)BUFFER_SIZE * iterations / (1024.0 * 1024.0)) /
+           ((double)elapsed / SDL_GetPerformanceFrequency());
+}
+
+int
+main(int argc, char *argv[])
+{
+    Uint8 *src, *dst;
+    int iterations = 2000;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argv[1]) {
+        iterations = atoi(argv[1]);
+    }
+    if (iterations <= 0) {
+        SDL_Log("Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    src = (Uint8 *)SDL_malloc(BUFFER_SIZE);
+    dst = (Uint8 *)SDL_malloc(BUFFER_SIZE);
+    if (!src || !dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_free(src);
+        SDL_free(dst);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("CPU: SSE2 %s, AVX2 %s, NEON %s\n",
+            SDL_HasSSE2() ? "yes" : "no", SDL_HasAVX2() ? "yes" : "no", SDL_HasNEON() ? "yes" : "no");
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        double full, half;
+
+        srand(1);
+        FillBuffer(src, formats[i].format);
+        FillBuffer(dst, formats[i].format);
+        full = MixThroughput(dst, src, formats[i].format, SDL_MIX_MAXVOLUME, iterations);
+        FillBuffer(dst, formats[i].format);
+        half = MixThroughput(dst, src, formats[i].format, SDL_MIX_MAXVOLUME / 2, iterations);
+
+        SDL_Log("%-8s full volume %8.1f MB/s, half volume %8.1f MB/s\n", formats[i].name, full, half);
+    }
+
+    SDL_free(src);
+    SDL_free(dst);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,298 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* SDL_SoftStretch() benchmark: time nearest neighbour stretches of 8, 16,
+   24 and 32-bit surfaces against the stepping row copy SDL used to do
+   (the same loop its generated x86 code unrolled), and check that both
+   produce the same pixels. Then stretch on several threads at once and
+   check every thread's result against a single threaded one.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define NUM_THREADS 4
+
+typedef struct
+{
+    Uint32 format;
+    int src_w, src_h;
+    int dst_w, dst_h;
+} StretchCase;
+
+static const StretchCase cases[] = {
+    { SDL_PIXELFORMAT_RGB332, 640, 480, 1920, 1080 },
+    { SDL_PIXELFORMAT_RGB565, 640, 480, 1920, 1080 },
+    { SDL_PIXELFORMAT_RGB24, 640, 480, 1920, 1080 },
+    { SDL_PIXELFORMAT_ARGB8888, 640, 480, 1920, 1080 },
+    { SDL_PIXELFORMAT_ARGB8888, 1920, 1080, 640, 360 },
+    { SDL_PIXELFORMAT_ARGB8888, 320, 240, 333, 251 },
+    { SDL_PIXELFORMAT_RGB565, 1920, 1080, 1280, 720 },
+};
+
+/* The previous implementation: step through the source one pixel at a
+   time in 16.16 fixed point, for every row of the destination. */
+#define DEFINE_STEP_ROW(name, type)                             \
+static void name(const Uint8 *src, int src_w, Uint8 *dst, int dst_w) \
+{                                                               \
+    const type *srcp = (const type *) src;                      \
+    type *dstp = (type *) dst;                                  \
+    const int inc = (src_w << 16) / dst_w;                      \
+    int pos = 0x10000;                                          \
+    type pixel = 0;                                             \
+    int i;                                                      \
+                                                                \
+    for (i = dst_w; i > 0; --i) {                               \
+        while (pos >= 0x10000) {                                \
+            pixel = *srcp++;                                    \
+            pos -= 0x10000;                                     \
+        }                                                       \
+        *dstp++ = pixel;                                        \
+        pos += inc;                                             \
+    }                                                           \
+}
+DEFINE_STEP_ROW(StepRow1, Uint8)
+DEFINE_STEP_ROW(StepRow2, Uint16)
+DEFINE_STEP_ROW(StepRow4, Uint32)
+
+static void
+StepRow3(const Uint8 *src, int src_w, Uint8 *dst, int dst_w)
+{
+    const int inc = (src_w << 16) / dst_w;
+    int pos = 0x10000;
+    Uint8 pixel[3] = { 0, 0, 0 };
+    int i;
+
+    for (i = dst_w; i > 0; --i) {
+        while (pos >= 0x10000) {
+            pixel[0] = *src++;
+            pixel[1] = *src++;
+            pixel[2] = *src++;
+            pos -= 0x10000;
+        }
+        *dst++ = pixel[0];
+        *dst++ = pixel[1];
+        *dst++ = pixel[2];
+        pos += inc;
+    }
+}
+
+static void
+StepStretch(SDL_Surface *src, SDL_Surface *dst)
+{
+    const int bpp = src->format->BytesPerPixel;
+    const int inc = (src->h << 16) / dst->h;
+    int pos = 0x10000;
+    int src_row = 0;
+    int dst_row;
+    const Uint8 *srcp = NULL;
+    Uint8 *dstp;
+
+    for (dst_row = 0; dst_row < dst->h; ++dst_row) {
+        while (pos >= 0x10000) {
+            srcp = (const Uint8 *) src->pixels + src_row * src->pitch;
+            ++src_row;
+            pos -= 0x10000;
+        }
+        dstp = (Uint8 *) dst->pixels + dst_row * dst->pitch;
+        switch (bpp) {
+        case 1:
+            StepRow1(srcp, src->w, dstp, dst->w);
+            break;
+        case 2:
+            StepRow2(srcp, src->w, dstp, dst->w);
+            break;
+        case 3:
+            StepRow3(srcp, src->w, dstp, dst->w);
+            break;
+        case 4:
+            StepRow4(srcp, src->w, dstp, dst->w);
+            break;
+        }
+        pos += inc;
+    }
+}
+
+static void
+FillNoise(SDL_Surface *surface, Uint32 seed)
+{
+    int x, y;
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *) surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->w * surface->format->BytesPerPixel; ++x) {
+            seed = seed * 1103515245 + 12345;
+            row[x] = (Uint8) (seed >> 16);
+        }
+    }
+}
+
+static SDL_bool
+SameContents(SDL_Surface *a, SDL_Surface *b)
+{
+    const int row_bytes = a->w * a->format->BytesPerPixel;
+    int y;
+    for (y = 0; y < a->h; ++y) {
+        if (SDL_memcmp((Uint8 *) a->pixels + y * a->pitch,
+                       (Uint8 *) b->pixels + y * b->pitch, row_bytes) != 0) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Stretch over and over for about half a second; returns megapixels
+   written per second. */
+static double
+TimeStretch(SDL_Surface *src, SDL_Surface *dst, SDL_bool stepped)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 start, elapsed = 0;
+    double pixels = 0.0;
+
+    while (elapsed < frequency / 2) {
+        start = SDL_GetPerformanceCounter();
+        if (stepped) {
+            StepStretch(src, dst);
+        } else {
+            SDL_SoftStretch(src, NULL, dst, NULL);
+        }
+        elapsed += SDL_GetPerformanceCounter() - start;
+        pixels += (double) dst->w * dst->h;
+    }
+    return (pixels / 1000000.0) / ((double) elapsed / (double) frequency);
+}
+
+typedef struct
+{
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    SDL_Surface *expected;
+    SDL_bool ok;
+} ThreadData;
+
+static int SDLCALL
+StretchThread(void *data)
+{
+    ThreadData *thread = (ThreadData *) data;
+    int i;
+
+    thread->ok = SDL_TRUE;
+    for (i = 0; i < 50 && thread->ok; ++i) {
+        SDL_FillRect(thread->dst, NULL, 0);
+        if (SDL_SoftStretch(thread->src, NULL, thread->dst, NULL) < 0 ||
+            !SameContents(thread->dst, thread->expected)) {
+            thread->ok = SDL_FALSE;
+        }
+    }
+    return 0;
+}
+
+static SDL_bool
+TestThreads(void)
+{
+    ThreadData threads[NUM_THREADS];
+    SDL_Thread *handles[NUM_THREADS];
+    SDL_bool ok = SDL_TRUE;
+    int i;
+
+    SDL_zero(threads);
+    for (i = 0; i < NUM_THREADS; ++i) {
+        const StretchCase *test = &cases[i % SDL_arraysize(cases)];
+        /* Give every thread a different width, so no two stretches agree */
+        const int dst_w = test->dst_w / 2 + i * 7;
+        const int dst_h = test->dst_h / 2 + i * 5;
+
+        threads[i].src = SDL_CreateRGBSurfaceWithFormat(0, test->src_w, test->src_h, 0, test->format);
+        threads[i].dst = SDL_CreateRGBSurfaceWithFormat(0, dst_w, dst_h, 0, test->format);
+        threads[i].expected = SDL_CreateRGBSurfaceWithFormat(0, dst_w, dst_h, 0, test->format);
+        if (!threads[i].src || !threads[i].dst || !threads[i].expected) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+            return SDL_FALSE;
+        }
+        FillNoise(threads[i].src, i + 1);
+        StepStretch(threads[i].src, threads[i].expected);
+    }
+
+    for (i = 0; i < NUM_THREADS; ++i) {
+        handles[i] = SDL_CreateThread(StretchThread, "Stretch", &threads[i]);
+    }
+    for (i = 0; i < NUM_THREADS; ++i) {
+        SDL_WaitThread(handles[i], NULL);
+        if (!threads[i].ok) {
+            ok = SDL_FALSE;
+        }
+        SDL_FreeSurface(threads[i].src);
+        SDL_FreeSurface(threads[i].dst);
+        SDL_FreeSurface(threads[i].expected);
+    }
+    return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+    int status = 0;
+    int i;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        const StretchCase *test = &cases[i];
+        SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, test->src_w, test->src_h, 0, test->format);
+        SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, test->dst_w, test->dst_h, 0, test->format);
+        SDL_Surface *stepped = SDL_CreateRGBSurfaceWithFormat(0, test->dst_w, test->dst_h, 0, test->format);
+        double stepped_rate, stretch_rate;
+
+        if (!src || !dst || !stepped) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+            SDL_Quit();
+            return 1;
+        }
+        FillNoise(src, i + 1);
+
+        StepStretch(src, stepped);
+        if (SDL_SoftStretch(src, NULL, dst, NULL) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_SoftStretch failed: %s\n", SDL_GetError());
+            status = 1;
+        } else if (!SameContents(dst, stepped)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_SoftStretch doesn't match the stepped stretch\n");
+            status = 1;
+        }
+
+        stepped_rate = TimeStretch(src, stepped, SDL_TRUE);
+        stretch_rate = TimeStretch(src, dst, SDL_FALSE);
+        SDL_Log("%-16s %4dx%-4d -> %4dx%-4d: stepped %8.1f Mpixels/s, SDL_SoftStretch %8.1f Mpixels/s (%.2fx)\n",
+                SDL_GetPixelFormatName(test->format) + 16,
+                test->src_w, test->src_h, test->dst_w, test->dst_h,
+                stepped_rate, stretch_rate, stretch_rate / stepped_rate);
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        SDL_FreeSurface(stepped);
+    }
+
+    if (TestThreads()) {
+        SDL_Log("%d threads stretching at once all got the right pixels\n", NUM_THREADS);
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Stretching on several threads went wrong\n");
+        status = 1;
+    }
+
+    SDL_Quit();
+    return status;
+}
@@ -30,6 +30,13 @@ ticktock(Uint32 interval, void *param)
     return (interval);
 }
 
+static Uint64 SDLCALL
+ticktockNS(Uint64 interval, void *param)
+{
+    ++ticks;
+    return (interval);
+}
+
 static Uint32 SDLCALL
 callback(Uint32 interval, void *param)
 {
@@ -100,6 +107,22 @@ main(int argc, char *argv[])
     SDL_RemoveTimer(t2);
     SDL_RemoveTimer(t3);
 
+    /* Test a high resolution timer */
+    SDL_Log("Running a 2 kHz timer for 2 seconds\n");
+    ticks = 0;
+    t1 = SDL_AddTimerNS(500000, ticktockNS, NULL);
+    if (!t1) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,"Could not create high resolution timer: %s\n", SDL_GetError());
+    } else {
+        SDL_TimerStats stats;
+
+        SDL_Delay(2 * 1000);
+        SDL_GetTimerStats(t1, &stats);
+        SDL_RemoveTimer(t1);
+        SDL_Log("%d ticks, %u missed, lateness: min %.1f usec, avg %.1f usec, max %.1f usec\n",
+                ticks, stats.missed, stats.min_lateness / 1000.0, stats.avg_lateness / 1000.0, stats.max_lateness / 1000.0);
+    }
+
     start = SDL_GetPerformanceCounter();
     for (i = 0; i < 1000000; ++i) {
         ticktock(0, NULL);
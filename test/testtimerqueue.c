@@ -0,0 +1,214 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Timer queue benchmark:
+   - add a large number of long running timers and remove them again,
+     the way network timeouts come and go.
+   - add a large number of short one-shot timers and wait for all of
+     them to fire.
+   - run a fast timer next to one with a slow callback, with and without
+     the timer thread pool, and report how late the fast timer is.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static SDL_atomic_t fired;
+
+static Uint32 SDLCALL
+Timeout(Uint32 interval, void *param)
+{
+    return interval;
+}
+
+static Uint32 SDLCALL
+OneShot(Uint32 interval, void *param)
+{
+    SDL_AtomicIncRef(&fired);
+    return 0;
+}
+
+static Uint32 SDLCALL
+SlowCallback(Uint32 interval, void *param)
+{
+    /* Pretend to do some file I/O */
+    SDL_Delay(20);
+    return interval;
+}
+
+static Uint64 SDLCALL
+FastCallback(Uint64 interval, void *param)
+{
+    return interval;
+}
+
+static double
+ElapsedMilliseconds(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static SDL_bool
+RunAddRemoveTest(SDL_TimerID *ids, int count)
+{
+    SDL_bool success = SDL_TRUE;
+    Uint64 start;
+    int i;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; ++i) {
+        /* Spread the timeouts out between 10 and 20 seconds */
+        ids[i] = SDL_AddTimer(10000 + (i * 7919) % 10000, Timeout, NULL);
+        if (!ids[i]) {
+            SDL_Log("SDL_AddTimer() failed: %s\n", SDL_GetError());
+            return SDL_FALSE;
+        }
+    }
+    SDL_Log("Added %d timers in %.2f ms\n", count, ElapsedMilliseconds(start));
+
+    /* Let the timer thread queue them all up */
+    SDL_Delay(100);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; ++i) {
+        /* Remove them in a different order than they were added */
+        const int index = (int)(((Uint64)i * 7919) % count);
+        if (!SDL_RemoveTimer(ids[index])) {
+            success = SDL_FALSE;
+        }
+    }
+    SDL_Log("Removed %d timers in %.2f ms%s\n", count, ElapsedMilliseconds(start),
+            success ? "" : " (SOME WERE MISSING!)");
+
+    /* The timer structures should be reused once the timer thread has dropped them */
+    SDL_Delay(100);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; ++i) {
+        ids[i] = SDL_AddTimer(10000 + (i * 7919) % 10000, Timeout, NULL);
+    }
+    for (i = 0; i < count; ++i) {
+        SDL_RemoveTimer(ids[i]);
+    }
+    SDL_Log("Added and removed %d timers again in %.2f ms\n", count, ElapsedMilliseconds(start));
+
+    return success;
+}
+
+static SDL_bool
+RunOneShotTest(int count)
+{
+    Uint64 start;
+    Uint32 timeout;
+    int i;
+
+    SDL_AtomicSet(&fired, 0);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; ++i) {
+        /* Spread the timers out over the next half second */
+        if (!SDL_AddTimer(1 + (i * 7919) % 500, OneShot, NULL)) {
+            SDL_Log("SDL_AddTimer() failed: %s\n", SDL_GetError());
+            return SDL_FALSE;
+        }
+    }
+    SDL_Log("Added %d one-shot timers in %.2f ms\n", count, ElapsedMilliseconds(start));
+
+    timeout = SDL_GetTicks() + 60 * 1000;
+    while (SDL_AtomicGet(&fired) < count && !SDL_TICKS_PASSED(SDL_GetTicks(), timeout)) {
+        SDL_Delay(1);
+    }
+    SDL_Log("%d of %d one-shot timers fired in %.2f ms\n", SDL_AtomicGet(&fired), count, ElapsedMilliseconds(start));
+
+    return (SDL_AtomicGet(&fired) == count);
+}
+
+static SDL_bool
+RunSlowCallbackTest(SDL_bool thread_pool)
+{
+    SDL_TimerID slow, fast;
+    SDL_TimerStats stats;
+
+    SDL_SetHint(SDL_HINT_TIMER_THREAD_POOL, thread_pool ? "1" : "0");
+    if (SDL_InitSubSystem(SDL_INIT_TIMER) < 0) {
+        SDL_Log("Couldn't initialize timers: %s\n", SDL_GetError());
+        return SDL_FALSE;
+    }
+
+    slow = SDL_AddTimer(10, SlowCallback, NULL);
+    fast = SDL_AddTimerNS(1000000, FastCallback, NULL);
+    SDL_Delay(1000);
+    SDL_GetTimerStats(fast, &stats);
+    SDL_RemoveTimer(fast);
+    SDL_RemoveTimer(slow);
+
+    SDL_Log("%s: 1 ms timer next to a slow callback fired %u times, %u missed, lateness avg %.1f usec, max %.1f usec\n",
+            thread_pool ? "Thread pool" : "Timer thread", stats.fired, stats.missed,
+            stats.avg_lateness / 1000.0, stats.max_lateness / 1000.0);
+
+    SDL_QuitSubSystem(SDL_INIT_TIMER);
+    return (stats.fired > 0);
+}
+
+int
+main(int argc, char *argv[])
+{
+    SDL_TimerID *ids;
+    int count = 100000;
+    SDL_bool success = SDL_TRUE;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argv[1]) {
+        count = atoi(argv[1]);
+    }
+    if (count <= 0) {
+        SDL_Log("Usage: %s [timer count]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    ids = (SDL_TimerID *)SDL_malloc(count * sizeof(*ids));
+    if (!ids) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_Quit();
+        return 1;
+    }
+
+    if (!RunAddRemoveTest(ids, count)) {
+        success = SDL_FALSE;
+    }
+    if (!RunOneShotTest(count)) {
+        success = SDL_FALSE;
+    }
+
+    SDL_free(ids);
+
+    /* Restart the timer subsystem with and without the thread pool */
+    SDL_QuitSubSystem(SDL_INIT_TIMER);
+    if (!RunSlowCallbackTest(SDL_FALSE)) {
+        success = SDL_FALSE;
+    }
+    if (!RunSlowCallbackTest(SDL_TRUE)) {
+        success = SDL_FALSE;
+    }
+
+    SDL_Quit();
+    return success ? 0 : 1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */